@@ -0,0 +1,201 @@
+#include "admission_control.h"
+
+AdmissionController admission_controller;
+
+AdmissionController::AdmissionController()
+    : global_limit(256), global_in_flight(0), global_rejected(0) {
+    classes["default"] = std::make_unique<RouteClass>();
+}
+
+AdmissionController::RouteClass& AdmissionController::get_class(const std::string& name) {
+    auto it = classes.find(name);
+    if (it == classes.end()) {
+        it = classes.find("default");
+    }
+    return *it->second;
+}
+
+void AdmissionController::set_class(const std::string& name, const RouteLimit& limit, bool priority) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& cls = classes[name];
+    if (!cls) cls = std::make_unique<RouteClass>();
+    cls->limit = limit;
+    cls->priority = priority;
+}
+
+void AdmissionController::add_rule(const std::string& path_prefix, const std::string& class_name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    rules.emplace_back(path_prefix, class_name);
+}
+
+void AdmissionController::set_global_limit(size_t limit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    global_limit = limit;
+}
+
+std::string AdmissionController::classify(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& [prefix, name] : rules) {
+        if (path.compare(0, prefix.size(), prefix) == 0) {
+            return name;
+        }
+    }
+    return "default";
+}
+
+AdmissionDecision AdmissionController::acquire(const std::string& class_name) {
+    std::unique_lock<std::mutex> lock(mtx);
+    RouteClass& cls = get_class(class_name);
+
+    if (cls.priority) {
+        cls.in_flight++;
+        cls.admitted++;
+        return AdmissionDecision::BYPASSED;
+    }
+
+    if (global_in_flight >= global_limit) {
+        cls.rejected++;
+        global_rejected++;
+        return AdmissionDecision::OVERLOADED;
+    }
+
+    if (cls.in_flight < cls.limit.max_concurrent && cls.waiting == 0) {
+        cls.in_flight++;
+        cls.admitted++;
+        global_in_flight++;
+        return AdmissionDecision::ADMITTED;
+    }
+
+    if (cls.waiting >= cls.limit.max_queue) {
+        cls.rejected++;
+        global_rejected++;
+        return AdmissionDecision::QUEUE_FULL;
+    }
+
+    cls.waiting++;
+    cls.queued++;
+    bool admitted = cls.cv.wait_for(lock, std::chrono::milliseconds(cls.limit.queue_timeout_ms),
+        [&cls]() { return cls.in_flight < cls.limit.max_concurrent; });
+    cls.waiting--;
+
+    if (!admitted) {
+        cls.timed_out++;
+        global_rejected++;
+        return AdmissionDecision::TIMED_OUT;
+    }
+
+    cls.in_flight++;
+    cls.admitted++;
+    global_in_flight++;
+    return AdmissionDecision::ADMITTED;
+}
+
+void AdmissionController::release(const std::string& class_name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    RouteClass& cls = get_class(class_name);
+    if (cls.in_flight > 0) cls.in_flight--;
+    if (!cls.priority && global_in_flight > 0) global_in_flight--;
+    cls.cv.notify_one();
+}
+
+int AdmissionController::retry_after(const std::string& class_name) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = classes.find(class_name);
+    if (it == classes.end()) it = classes.find("default");
+    return it->second->limit.retry_after_sec;
+}
+
+void AdmissionController::set_background_limit(const std::string& name, size_t limit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    background[name].limit = limit;
+}
+
+bool AdmissionController::try_begin_background(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& slot = background[name];
+    if (slot.running >= slot.limit) {
+        slot.rejected++;
+        return false;
+    }
+    slot.running++;
+    slot.started++;
+    return true;
+}
+
+void AdmissionController::end_background(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto& slot = background[name];
+    if (slot.running > 0) slot.running--;
+}
+
+std::vector<AdmissionClassStats> AdmissionController::class_stats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<AdmissionClassStats> result;
+    for (const auto& [name, cls] : classes) {
+        AdmissionClassStats s;
+        s.name = name;
+        s.limit = cls->limit;
+        s.priority = cls->priority;
+        s.in_flight = cls->in_flight;
+        s.waiting = cls->waiting;
+        s.admitted = cls->admitted;
+        s.queued = cls->queued;
+        s.rejected = cls->rejected;
+        s.timed_out = cls->timed_out;
+        result.push_back(s);
+    }
+    return result;
+}
+
+std::vector<BackgroundSlotStats> AdmissionController::background_stats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<BackgroundSlotStats> result;
+    for (const auto& [name, slot] : background) {
+        result.push_back({name, slot.limit, slot.running, slot.started, slot.rejected});
+    }
+    return result;
+}
+
+size_t AdmissionController::in_flight() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return global_in_flight;
+}
+
+uint64_t AdmissionController::rejected_total() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return global_rejected;
+}
+
+void configure_default_admission(AdmissionController& controller) {
+    RouteLimit unlimited;
+    controller.set_class("priority", unlimited, true);
+
+    RouteLimit heavy;
+    heavy.max_concurrent = 1;
+    heavy.max_queue = 2;
+    heavy.queue_timeout_ms = 5000;
+    heavy.retry_after_sec = 5;
+    controller.set_class("heavy", heavy);
+
+    RouteLimit scheduler;
+    scheduler.max_concurrent = 4;
+    scheduler.max_queue = 32;
+    controller.set_class("scheduler", scheduler);
+
+    RouteLimit standard;
+    controller.set_class("default", standard);
+
+    controller.add_rule("/api/health", "priority");
+    controller.add_rule("/api/stats", "priority");
+    controller.add_rule("/api/admission", "priority");
+    controller.add_rule("/metrics", "priority");
+    controller.add_rule("/api/threads/stress-test", "heavy");
+    controller.add_rule("/api/os/simulate", "heavy");
+    controller.add_rule("/api/os/processes/sweep", "heavy");
+    controller.add_rule("/api/os/processes/import", "heavy");
+    controller.add_rule("/api/os/processes/export", "heavy");
+    controller.add_rule("/api/os/processes", "scheduler");
+
+    controller.set_global_limit(256);
+    controller.set_background_limit("stress-test", 1);
+}
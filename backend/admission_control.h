@@ -0,0 +1,113 @@
+#ifndef ADMISSION_CONTROL_H
+#define ADMISSION_CONTROL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Per-class concurrency limit. Requests above max_concurrent wait in a
+// bounded queue for at most queue_timeout_ms; a full queue is shed at once.
+struct RouteLimit {
+    size_t max_concurrent = 64;
+    size_t max_queue = 256;
+    int queue_timeout_ms = 2000;
+    int retry_after_sec = 1;
+};
+
+enum class AdmissionDecision {
+    ADMITTED,
+    BYPASSED,       // priority class, never limited
+    QUEUE_FULL,     // shed immediately -> 429
+    TIMED_OUT,      // waited too long in queue -> 503
+    OVERLOADED      // global in-flight ceiling reached -> 503
+};
+
+struct AdmissionClassStats {
+    std::string name;
+    RouteLimit limit;
+    bool priority = false;
+    size_t in_flight = 0;
+    size_t waiting = 0;
+    uint64_t admitted = 0;
+    uint64_t queued = 0;
+    uint64_t rejected = 0;
+    uint64_t timed_out = 0;
+};
+
+struct BackgroundSlotStats {
+    std::string name;
+    size_t limit = 0;
+    size_t running = 0;
+    uint64_t started = 0;
+    uint64_t rejected = 0;
+};
+
+class AdmissionController {
+private:
+    struct RouteClass {
+        RouteLimit limit;
+        bool priority = false;
+        size_t in_flight = 0;
+        size_t waiting = 0;
+        uint64_t admitted = 0;
+        uint64_t queued = 0;
+        uint64_t rejected = 0;
+        uint64_t timed_out = 0;
+        std::condition_variable cv;
+    };
+
+    struct BackgroundSlot {
+        size_t limit = 1;
+        size_t running = 0;
+        uint64_t started = 0;
+        uint64_t rejected = 0;
+    };
+
+    // Ordered (prefix, class) rules; first match wins
+    std::vector<std::pair<std::string, std::string>> rules;
+    std::map<std::string, std::unique_ptr<RouteClass>> classes;
+    std::map<std::string, BackgroundSlot> background;
+    size_t global_limit;
+    size_t global_in_flight;
+    uint64_t global_rejected;
+    mutable std::mutex mtx;
+
+    RouteClass& get_class(const std::string& name);
+
+public:
+    AdmissionController();
+
+    void set_class(const std::string& name, const RouteLimit& limit, bool priority = false);
+    void add_rule(const std::string& path_prefix, const std::string& class_name);
+    void set_global_limit(size_t limit);
+    std::string classify(const std::string& path) const;
+
+    AdmissionDecision acquire(const std::string& class_name);
+    void release(const std::string& class_name);
+    int retry_after(const std::string& class_name) const;
+
+    // Work that outlives its request (detached stress tests) holds a slot
+    // until it finishes instead of a request-scoped ticket.
+    void set_background_limit(const std::string& name, size_t limit);
+    bool try_begin_background(const std::string& name);
+    void end_background(const std::string& name);
+
+    std::vector<AdmissionClassStats> class_stats() const;
+    std::vector<BackgroundSlotStats> background_stats() const;
+    size_t in_flight() const;
+    uint64_t rejected_total() const;
+};
+
+// Default policy: health/stats are never shed, heavy simulations run one at a
+// time, everything else shares a general limit.
+void configure_default_admission(AdmissionController& controller);
+
+extern AdmissionController admission_controller;
+
+#endif
@@ -0,0 +1,133 @@
+#include "alloc_profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <new>
+
+// Constant-initialized, so the hooks never trigger thread_local set-up
+static thread_local AllocCounts thread_counts;
+// Set while a site is being recorded so the registry's own nodes don't count
+static thread_local bool counting_paused = false;
+
+#ifdef CLOUD_ALLOC_PROFILING
+
+// ===== ALLOCATION HOOKS =====
+
+// operator new[] and the nothrow forms forward here; aligned allocations
+// keep the library's own aligned_alloc/free pair and are not counted
+void* operator new(std::size_t size) {
+    if (!counting_paused) {
+        thread_counts.allocs++;
+        thread_counts.bytes += size;
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    if (p && !counting_paused) thread_counts.frees++;
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+bool alloc_profiling_compiled() {
+    return true;
+}
+
+#else
+
+bool alloc_profiling_compiled() {
+    return false;
+}
+
+#endif
+
+// ===== SITES =====
+
+// Function-local so operations running during static initialization can record
+static std::mutex& sites_mutex() {
+    static std::mutex mtx;
+    return mtx;
+}
+
+// Transparent lookup: recording into an existing site allocates nothing
+static std::map<std::string, AllocSiteStats, std::less<>>& sites() {
+    static std::map<std::string, AllocSiteStats, std::less<>> by_name;
+    return by_name;
+}
+
+AllocCounts thread_alloc_counts() {
+    return thread_counts;
+}
+
+void record_allocations(std::string_view site, const AllocCounts& start) {
+    record_allocations(site, start, thread_counts);
+}
+
+void record_allocations(std::string_view site, const AllocCounts& start, const AllocCounts& end) {
+    uint64_t allocs = end.allocs - start.allocs;
+    uint64_t bytes = end.bytes - start.bytes;
+    uint64_t frees = end.frees - start.frees;
+
+    counting_paused = true;
+    {
+        std::lock_guard<std::mutex> lock(sites_mutex());
+        auto it = sites().find(site);
+        if (it == sites().end()) {
+            it = sites().emplace(std::string(site), AllocSiteStats()).first;
+            it->second.site = it->first;
+        }
+        AllocSiteStats& s = it->second;
+        s.operations++;
+        s.allocs += allocs;
+        s.bytes += bytes;
+        s.frees += frees;
+        s.max_allocs = std::max(s.max_allocs, allocs);
+        s.max_bytes = std::max(s.max_bytes, bytes);
+    }
+    counting_paused = false;
+}
+
+std::vector<AllocSiteStats> alloc_profiles() {
+    std::vector<AllocSiteStats> result;
+    {
+        std::lock_guard<std::mutex> lock(sites_mutex());
+        result.reserve(sites().size());
+        for (const auto& [name, stats] : sites()) result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const AllocSiteStats& a, const AllocSiteStats& b) {
+        // a.allocs / a.operations > b.allocs / b.operations without dividing
+        return a.allocs * b.operations > b.allocs * a.operations;
+    });
+    return result;
+}
+
+void reset_alloc_profiles() {
+    std::lock_guard<std::mutex> lock(sites_mutex());
+    sites().clear();
+}
+
+void print_alloc_report(std::ostream& out) {
+    out << "\nHEAP ALLOCATIONS";
+    if (!alloc_profiling_compiled()) {
+        out << " (not compiled in; configure with -DCLOUD_ALLOC_PROFILING=ON)\n";
+        return;
+    }
+    out << " (per operation):\n";
+    out << "  " << std::left << std::setw(36) << "site" << std::right
+        << std::setw(10) << "ops" << std::setw(10) << "allocs" << std::setw(12) << "bytes"
+        << std::setw(10) << "max" << "\n";
+    for (const auto& s : alloc_profiles()) {
+        double ops = s.operations > 0 ? static_cast<double>(s.operations) : 1.0;
+        out << "  " << std::left << std::setw(36) << s.site << std::right
+            << std::setw(10) << s.operations << std::fixed << std::setprecision(1)
+            << std::setw(10) << s.allocs / ops << std::setw(12) << s.bytes / ops
+            << std::setw(10) << s.max_allocs << "\n";
+    }
+    out << std::defaultfloat;
+}
@@ -0,0 +1,68 @@
+#ifndef ALLOC_PROFILER_H
+#define ALLOC_PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Heap allocation profiling, compiled in with -DCLOUD_ALLOC_PROFILING=ON.
+// The build replaces the global operator new/delete with versions that bump
+// per-thread counters, and scopes attribute the calling thread's allocations
+// to a site ("reader", "GET /api/files"). Allocations a site causes on other
+// threads (the log writer, std::thread start-up) are not attributed to it.
+// Without the option AllocScope is empty and nothing is counted.
+
+struct AllocCounts {
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;     // requested sizes
+    uint64_t frees = 0;
+};
+
+struct AllocSiteStats {
+    std::string site;
+    uint64_t operations = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+    uint64_t frees = 0;
+    uint64_t max_allocs = 0;   // worst single operation
+    uint64_t max_bytes = 0;
+};
+
+// True when the counting operator new is linked in
+bool alloc_profiling_compiled();
+
+// Everything the calling thread has allocated so far
+AllocCounts thread_alloc_counts();
+// Adds the calling thread's allocations since `start` to a site as one operation
+void record_allocations(std::string_view site, const AllocCounts& start);
+// Same, for a window that ended at `end`; lets callers take the snapshot
+// before allocating to build the site name
+void record_allocations(std::string_view site, const AllocCounts& start, const AllocCounts& end);
+
+#ifdef CLOUD_ALLOC_PROFILING
+class AllocScope {
+private:
+    const char* site;
+    AllocCounts start;
+
+public:
+    explicit AllocScope(const char* site_name) : site(site_name), start(thread_alloc_counts()) {}
+    ~AllocScope() { record_allocations(site, start); }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+#else
+class AllocScope {
+public:
+    explicit AllocScope(const char*) {}
+};
+#endif
+
+// Sites with the most allocations per operation first
+std::vector<AllocSiteStats> alloc_profiles();
+void reset_alloc_profiles();
+void print_alloc_report(std::ostream& out);
+
+#endif
@@ -0,0 +1,2566 @@
+#include "api_routes.h"
+#include "cloud.h"
+#include "unified_os.h"
+#include "event_server.h"
+#include "admission_control.h"
+#include "job_manager.h"
+#include "metrics.h"
+#include "request_tracing.h"
+#include "log_store.h"
+#include "binary_log.h"
+#include "event_trace.h"
+#include "alloc_profiler.h"
+#include "workload.h"
+#include "schedule_sweep.h"
+#include "process_trace.h"
+#include "gantt_view.h"
+#include <httplib.h>
+#include <json/json.h>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <map>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <tuple>
+#include <limits>
+
+using namespace httplib;
+namespace fs = std::filesystem;
+
+// Global variables for HTTP API
+ProfiledMutex api_mutex("api_mutex");
+ProfiledMutex process_mutex("process_mutex"); // Add mutex for process scheduler thread safety
+std::string last_scheduling_algorithm = "";
+int last_scheduling_quantum = 2;
+std::map<int, pthread_t> managed_threads;
+int thread_id_counter = 1;
+
+// Upper bound for client-supplied stress test sizes (matches the CLI menu)
+const int MAX_STRESS_TEST_THREADS = 1000;
+const size_t MAX_WORKLOAD_OBJECT_BYTES = 16 * 1024 * 1024;
+
+// Admission ticket held by the request running on this thread. Acquired in
+// the pre-routing handler and released in the post-routing handler, which
+// httplib runs for every response on the same thread.
+thread_local std::string admitted_class;
+thread_local bool admission_held = false;
+
+// Start of the request running on this thread, set in the metrics pre-routing hook
+thread_local FastClock::time_point request_started;
+thread_local bool request_timed = false;
+
+// Allocation counts at the start of the request running on this thread
+thread_local AllocCounts request_allocs_start;
+thread_local bool request_allocs_counted = false;
+
+// CORS middleware
+void setup_cors(Response &res) {
+    res.set_header("Access-Control-Allow-Origin", "*");
+    res.set_header("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
+    res.set_header("Access-Control-Allow-Headers", "Content-Type, Authorization");
+}
+
+// Serializes a JSON response body; the time is traced as the serialize phase
+void send_json(Response &res, const Json::Value &response) {
+    auto started = FastClock::now();
+    Json::StreamWriterBuilder builder;
+    res.set_content(Json::writeString(builder, response), "application/json");
+    trace_phase(TracePhase::SERIALIZE, started);
+}
+
+// ===== ASYNC JOBS =====
+
+// A job id path segment; false when it does not fit in 64 bits
+static bool parse_job_id(const std::string& text, uint64_t& id) {
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), id);
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+Json::Value job_to_json(const JobInfo& job, bool include_result) {
+    Json::Value j;
+    j["id"] = static_cast<Json::UInt64>(job.id);
+    j["type"] = job.type;
+    j["status"] = job_status_name(job.status);
+    j["progress"] = job.progress;
+    j["message"] = job.message;
+    j["params"] = job.params;
+    j["submittedAt"] = static_cast<Json::Int64>(job.submitted_ms);
+    j["startedAt"] = static_cast<Json::Int64>(job.started_ms);
+    j["finishedAt"] = static_cast<Json::Int64>(job.finished_ms);
+    if (!job.error.empty()) {
+        j["error"] = job.error;
+    }
+    if (include_result) {
+        j["result"] = job.result;
+    }
+    return j;
+}
+
+Json::Value stress_result_to_json(const StressTestResult& result) {
+    Json::Value j;
+    j["requestedThreads"] = result.requested_threads;
+    j["launchedThreads"] = result.launched_threads;
+    j["readers"] = result.readers;
+    j["writers"] = result.writers;
+    j["deleters"] = result.deleters;
+    j["cancelled"] = result.cancelled;
+    j["durationMs"] = result.duration_ms;
+    j["throughputOpsPerSec"] = result.throughput_ops_per_sec;
+    j["seed"] = static_cast<Json::UInt64>(result.seed);
+    j["arrival"] = result.arrival;
+    j["warmupOperations"] = result.warmup_operations;
+    char digest[17];
+    snprintf(digest, sizeof(digest), "%016llx", static_cast<unsigned long long>(result.plan_digest));
+    j["planDigest"] = digest;
+    if (result.arrival == "poisson" || result.arrival == "fixed") {
+        j["avgStartLagMs"] = result.avg_start_lag_ms;
+        j["maxStartLagMs"] = result.max_start_lag_ms;
+    }
+    
+    Json::Value latency;
+    for (const auto& [operation, summary] : result.latency) {
+        Json::Value op;
+        op["count"] = summary.count;
+        op["avgWaitUs"] = summary.avg_wait_us;
+        op["avgTotalUs"] = summary.avg_total_us;
+        op["p50Us"] = summary.p50_us;
+        op["p95Us"] = summary.p95_us;
+        op["p99Us"] = summary.p99_us;
+        op["maxUs"] = summary.max_us;
+        latency[operation] = op;
+    }
+    j["latency"] = latency;
+    return j;
+}
+
+// Reads the optional workload fields of a stress-test request; everything
+// not given keeps the WorkloadConfig default. Returns an error message or "".
+std::string parse_workload_config(const Json::Value& request_data, WorkloadConfig& config) {
+    config.operations = request_data.get("count", 10).asInt();
+    if (config.operations < 1 || config.operations > MAX_STRESS_TEST_THREADS) {
+        return "count must be between 1 and " + std::to_string(MAX_STRESS_TEST_THREADS);
+    }
+    config.concurrency = config.operations;
+    if (request_data.isMember("seed")) config.seed = request_data["seed"].asUInt64();
+    config.warmup_operations = request_data.get("warmup", 0).asInt();
+    if (config.warmup_operations < 0 || config.warmup_operations > MAX_STRESS_TEST_THREADS) {
+        return "warmup must be between 0 and " + std::to_string(MAX_STRESS_TEST_THREADS);
+    }
+    if (request_data.isMember("mix")) {
+        const Json::Value& mix = request_data["mix"];
+        config.read_weight = mix.get("read", 0.0).asDouble();
+        config.write_weight = mix.get("write", 0.0).asDouble();
+        config.delete_weight = mix.get("delete", 0.0).asDouble();
+    }
+    if (request_data.isMember("arrival") &&
+        !parse_arrival_process(request_data["arrival"].asString(), config.arrival)) {
+        return "arrival must be one of burst, closed, poisson, fixed";
+    }
+    config.concurrency = request_data.get("concurrency", config.concurrency).asInt();
+    if (config.concurrency > MAX_STRESS_TEST_THREADS) {
+        return "concurrency must be at most " + std::to_string(MAX_STRESS_TEST_THREADS);
+    }
+    config.rate_per_sec = request_data.get("rate", config.rate_per_sec).asDouble();
+    config.zipf_s = request_data.get("zipf", config.zipf_s).asDouble();
+    if (request_data.isMember("size")) {
+        const Json::Value& size = request_data["size"];
+        if (size.isMember("distribution") &&
+            !parse_size_distribution(size["distribution"].asString(), config.size_distribution)) {
+            return "size.distribution must be one of file, fixed, uniform, lognormal";
+        }
+        config.size_bytes = size.get("bytes", static_cast<Json::UInt64>(config.size_bytes)).asUInt64();
+        config.size_min = size.get("min", static_cast<Json::UInt64>(config.size_min)).asUInt64();
+        config.size_max = size.get("max", static_cast<Json::UInt64>(config.size_max)).asUInt64();
+        config.size_sigma = size.get("sigma", config.size_sigma).asDouble();
+        if (config.size_bytes > MAX_WORKLOAD_OBJECT_BYTES || config.size_max > MAX_WORKLOAD_OBJECT_BYTES) {
+            return "size must be at most " + std::to_string(MAX_WORKLOAD_OBJECT_BYTES) + " bytes";
+        }
+    }
+    return validate_workload(config);
+}
+
+Json::Value workload_config_to_json(const WorkloadConfig& config) {
+    Json::Value j;
+    j["count"] = config.operations;
+    j["seed"] = static_cast<Json::UInt64>(config.seed);
+    j["warmup"] = config.warmup_operations;
+    j["mix"]["read"] = config.read_weight;
+    j["mix"]["write"] = config.write_weight;
+    j["mix"]["delete"] = config.delete_weight;
+    j["arrival"] = arrival_process_name(config.arrival);
+    if (config.arrival == ArrivalProcess::CLOSED_LOOP) j["concurrency"] = config.concurrency;
+    if (config.arrival == ArrivalProcess::POISSON || config.arrival == ArrivalProcess::FIXED_RATE) {
+        j["rate"] = config.rate_per_sec;
+    }
+    j["zipf"] = config.zipf_s;
+    j["size"]["distribution"] = size_distribution_name(config.size_distribution);
+    if (config.size_distribution != SizeDistribution::SOURCE_FILE) {
+        j["size"]["bytes"] = static_cast<Json::UInt64>(config.size_bytes);
+        j["size"]["min"] = static_cast<Json::UInt64>(config.size_min);
+        j["size"]["max"] = static_cast<Json::UInt64>(config.size_max);
+        j["size"]["sigma"] = config.size_sigma;
+    }
+    return j;
+}
+
+// Runs the OS demos one module at a time, checking for cancellation between
+// modules. The interactive IPC menu reads stdin, so jobs use the automatic demo.
+Json::Value run_simulation_job(const std::vector<std::string>& modules, JobContext& ctx) {
+    Json::Value completed(Json::arrayValue);
+    for (size_t i = 0; i < modules.size(); i++) {
+        if (ctx.is_cancelled()) break;
+        const std::string& name = modules[i];
+        ctx.set_progress(static_cast<double>(i) / modules.size(), "Running " + name + " demo");
+        
+        auto started = std::chrono::steady_clock::now();
+        if (name == "processes") {
+            auto lock = traced_lock(process_mutex);
+            run_process_scheduler_demo();
+        } else if (name == "filesystem") {
+            run_file_system_demo();
+        } else if (name == "ipc") {
+            run_automatic_ipc_demo();
+        } else if (name == "deadlock") {
+            run_deadlock_detection_demo();
+        }
+        
+        Json::Value entry;
+        entry["module"] = name;
+        entry["durationMs"] = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - started).count();
+        completed.append(entry);
+    }
+    
+    Json::Value result;
+    result["modules"] = completed;
+    return result;
+}
+
+// File operations endpoints
+void setup_file_routes(Server &server) {
+    // List files from downloads directory
+    server.Get("/api/files", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value files(Json::arrayValue);
+        
+        auto lock = traced_lock(api_mutex);
+        
+        // Scan downloads directory for real files
+        if (fs::exists("./downloads")) {
+            for (const auto& entry : fs::directory_iterator("./downloads")) {
+                if (entry.is_regular_file()) {
+                    Json::Value file;
+                    file["id"] = entry.path().filename().string();
+                    file["name"] = entry.path().filename().string();
+                    file["size"] = static_cast<int>(fs::file_size(entry.path()));
+                    auto ftime = fs::last_write_time(entry.path());
+                    file["modified"] = std::to_string(ftime.time_since_epoch().count());
+                    file["type"] = entry.path().extension().string();
+                    files.append(file);
+                }
+            }
+        }
+        
+        response["files"] = files;
+        response["total"] = static_cast<int>(files.size());
+        
+        send_json(res, response);
+    });
+    
+    // Upload file - uses real file operations
+    server.Post("/api/files/upload", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        try {
+            ensure_directories_exist();
+            
+            // Save uploaded content to test_files directory
+            std::string timestamp = std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+            std::string filename = "./test_files/upload_" + timestamp + ".txt";
+            
+            std::ofstream outfile(filename);
+            if (outfile) {
+                outfile << req.body;
+                outfile.close();
+                
+                // Update cloudData
+                auto data_lock = traced_lock(rw_mutex);
+                cloudData = req.body;
+                data_lock.unlock();
+                
+                log_event(0, "UPLOAD", "File saved to " + filename);
+                
+                response["success"] = true;
+                response["message"] = "File uploaded successfully";
+                response["filename"] = filename;
+                response["size"] = static_cast<int>(req.body.size());
+            } else {
+                response["success"] = false;
+                response["message"] = "Failed to save file";
+            }
+        } catch (const std::exception& e) {
+            response["success"] = false;
+            response["message"] = e.what();
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Delete file - real file deletion
+    server.Delete(R"(/api/files/(.+))", [](const Request &req, Response &res) {
+        setup_cors(res);
+        
+        // Extract file_id from path manually
+        std::string path = req.path;
+        std::string prefix = "/api/files/";
+        std::string file_id = path.substr(prefix.length());
+        
+        Json::Value response;
+        std::string filepath = "./downloads/" + file_id;
+        
+        try {
+            if (fs::exists(filepath)) {
+                fs::remove(filepath);
+                log_event(0, "DELETE", "File deleted: " + file_id);
+                response["success"] = true;
+                response["message"] = "File deleted successfully";
+                response["fileId"] = file_id;
+            } else {
+                response["success"] = false;
+                response["message"] = "File not found";
+            }
+        } catch (const std::exception& e) {
+            response["success"] = false;
+            response["message"] = e.what();
+        }
+        
+        send_json(res, response);
+    });
+}
+
+// Cloud statistics endpoints - real statistics
+void setup_stats_routes(Server &server) {
+    server.Get("/api/stats", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        auto lock = traced_lock(api_mutex);
+        
+        // Count actual files
+        int file_count = 0;
+        size_t total_size = 0;
+        if (fs::exists("./downloads")) {
+            for (const auto& entry : fs::directory_iterator("./downloads")) {
+                if (entry.is_regular_file()) {
+                    file_count++;
+                    total_size += fs::file_size(entry.path());
+                }
+            }
+        }
+        
+        auto stats_lock = traced_lock(stats_mutex);
+        response["totalFiles"] = file_count;
+        response["totalSize"] = std::to_string(total_size / 1024) + " KB";
+        response["cloudDataSize"] = static_cast<int>(cloudData.size());
+        response["activeReaders"] = active_readers;
+        response["activeWriters"] = active_writers;
+        response["activeDeleters"] = active_deleters;
+        response["completedReads"] = completed_reads;
+        response["completedWrites"] = completed_writes;
+        response["completedDeletes"] = completed_deletes;
+        response["activeThreads"] = static_cast<int>(managed_threads.size());
+        stats_lock.unlock();
+        
+        send_json(res, response);
+    });
+}
+
+// Log viewer endpoints: newest N (default), entries after a cursor, or a time
+// range. Served from the log store's ring and offset index, never a full scan.
+void setup_log_routes(Server &server) {
+    server.Get("/api/logs", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value logs(Json::arrayValue);
+        
+        size_t limit = 100;
+        if (req.has_param("limit")) {
+            limit = static_cast<size_t>(std::clamp(std::atoi(req.get_param_value("limit").c_str()), 1, 1000));
+        }
+        
+        LogQueryResult result;
+        bool newest_first = false;
+        if (req.has_param("since")) {
+            result = log_store.since(std::stoull(req.get_param_value("since")), limit);
+        } else if (req.has_param("from") || req.has_param("to")) {
+            // Epoch milliseconds
+            int64_t from_us = req.has_param("from") ? std::stoll(req.get_param_value("from")) * 1000 : 0;
+            int64_t to_us = req.has_param("to") ? std::stoll(req.get_param_value("to")) * 1000
+                                                : std::numeric_limits<int64_t>::max();
+            result = log_store.range(from_us, to_us, limit);
+        } else {
+            result = log_store.tail(limit);
+            newest_first = true;
+        }
+        
+        for (const auto& entry : result.entries) {
+            Json::Value log;
+            log["seq"] = static_cast<Json::UInt64>(entry.seq);
+            log["message"] = entry.line;
+            log["timestamp"] = format_wall_clock(entry.timestamp_us);
+            log["timestampMs"] = static_cast<Json::Int64>(entry.timestamp_us / 1000);
+            log["threadType"] = entry.thread_type;
+            log["threadId"] = entry.thread_id;
+            log["action"] = entry.action;
+            log["status"] = entry.status;
+            logs.append(log);
+        }
+        if (newest_first) {
+            Json::Value reversed(Json::arrayValue);
+            for (int i = static_cast<int>(logs.size()) - 1; i >= 0; i--) {
+                reversed.append(logs[i]);
+            }
+            logs = reversed;
+        }
+        
+        // Poll with ?since=<cursor> to receive only newer entries
+        uint64_t cursor = result.entries.empty() ? result.last_seq
+                        : newest_first ? result.last_seq : result.entries.back().seq;
+        response["logs"] = logs;
+        response["total"] = static_cast<int>(logs.size());
+        response["cursor"] = static_cast<Json::UInt64>(cursor);
+        response["firstSeq"] = static_cast<Json::UInt64>(result.first_seq);
+        response["lastSeq"] = static_cast<Json::UInt64>(result.last_seq);
+        response["order"] = newest_first ? "newest_first" : "oldest_first";
+        
+        send_json(res, response);
+    });
+}
+
+// Filter for the binary log routes: from/to (epoch ms), op, status, thread, grep
+static bool parse_binlog_filter(const Request &req, BinaryLogFilter &filter, std::string &error) {
+    if (req.has_param("from")) filter.from_us = std::atoll(req.get_param_value("from").c_str()) * 1000;
+    if (req.has_param("to")) filter.to_us = std::atoll(req.get_param_value("to").c_str()) * 1000;
+    if (req.has_param("op") && !parse_log_op_mask(req.get_param_value("op"), filter.op_mask)) {
+        error = "Unknown op: " + req.get_param_value("op");
+        return false;
+    }
+    if (req.has_param("status") && !parse_log_status_mask(req.get_param_value("status"), filter.status_mask)) {
+        error = "Unknown status: " + req.get_param_value("status");
+        return false;
+    }
+    if (req.has_param("thread")) filter.thread_id = std::atoll(req.get_param_value("thread").c_str());
+    if (req.has_param("grep")) filter.contains = req.get_param_value("grep");
+    return true;
+}
+
+static Json::Value binlog_record_to_json(const DecodedLogRecord &decoded) {
+    const BinaryLogRecord &r = decoded.record;
+    Json::Value record;
+    record["timestamp"] = format_wall_clock(r.timestamp_us);
+    record["timestampUs"] = static_cast<Json::Int64>(r.timestamp_us);
+    record["threadId"] = r.thread_id;
+    record["op"] = log_op_name(static_cast<LogOp>(r.op));
+    record["status"] = log_status_name(static_cast<LogStatus>(r.status));
+    record["message"] = decoded.message ? *decoded.message : "";
+    if (r.total_us > 0) {
+        record["waitUs"] = r.wait_us;
+        record["operationUs"] = r.operation_us;
+        record["totalUs"] = r.total_us;
+    }
+    return record;
+}
+
+// Structured event log: segment listing, filtered record query and
+// per-operation aggregates. The writer is flushed first so results include
+// everything logged before the request.
+void setup_binlog_routes(Server &server) {
+    server.Get("/api/binlog/segments", [](const Request &req, Response &res) {
+        setup_cors(res);
+        binary_log.flush();
+        Json::Value response;
+        Json::Value segments(Json::arrayValue);
+        for (const auto& segment : list_binary_log_segments(binary_log.dir())) {
+            Json::Value item;
+            item["id"] = static_cast<Json::UInt64>(segment.id);
+            item["path"] = segment.path;
+            item["created"] = format_wall_clock(segment.created_us);
+            item["createdMs"] = static_cast<Json::Int64>(segment.created_us / 1000);
+            item["bytes"] = static_cast<Json::UInt64>(segment.bytes);
+            item["compressed"] = segment.compressed;
+            segments.append(item);
+        }
+        response["segments"] = segments;
+        response["recordsWritten"] = static_cast<Json::UInt64>(binary_log.written());
+        send_json(res, response);
+    });
+    
+    server.Get("/api/binlog/query", [](const Request &req, Response &res) {
+        setup_cors(res);
+        BinaryLogFilter filter;
+        std::string error;
+        if (!parse_binlog_filter(req, filter, error)) {
+            res.status = 400;
+            Json::Value response;
+            response["error"] = error;
+            send_json(res, response);
+            return;
+        }
+        size_t limit = 100;
+        if (req.has_param("limit")) {
+            limit = static_cast<size_t>(std::clamp(std::atoi(req.get_param_value("limit").c_str()), 1, 10000));
+        }
+        
+        binary_log.flush();
+        Json::Value records(Json::arrayValue);
+        uint64_t scanned = scan_binary_log(binary_log.dir(), filter, [&](const DecodedLogRecord &decoded) {
+            records.append(binlog_record_to_json(decoded));
+            return records.size() < limit;
+        });
+        
+        Json::Value response;
+        response["records"] = records;
+        response["total"] = static_cast<int>(records.size());
+        response["scanned"] = static_cast<Json::UInt64>(scanned);
+        send_json(res, response);
+    });
+    
+    server.Get("/api/binlog/aggregate", [](const Request &req, Response &res) {
+        setup_cors(res);
+        BinaryLogFilter filter;
+        std::string error;
+        if (!parse_binlog_filter(req, filter, error)) {
+            res.status = 400;
+            Json::Value response;
+            response["error"] = error;
+            send_json(res, response);
+            return;
+        }
+        
+        binary_log.flush();
+        BinaryLogAggregate aggregate = aggregate_binary_log(binary_log.dir(), filter);
+        Json::Value response;
+        Json::Value ops(Json::objectValue);
+        for (const auto& [name, summary] : aggregate.by_op) {
+            Json::Value op;
+            op["count"] = static_cast<Json::UInt64>(summary.count);
+            Json::Value statuses(Json::objectValue);
+            for (const auto& [status, count] : summary.by_status) {
+                statuses[status] = static_cast<Json::UInt64>(count);
+            }
+            op["byStatus"] = statuses;
+            if (summary.timed > 0) {
+                op["timed"] = static_cast<Json::UInt64>(summary.timed);
+                op["avgTotalUs"] = summary.total_us_sum / summary.timed;
+                op["avgWaitUs"] = summary.wait_us_sum / summary.timed;
+                op["maxTotalUs"] = summary.total_us_max;
+            }
+            ops[name] = op;
+        }
+        response["scanned"] = static_cast<Json::UInt64>(aggregate.scanned);
+        response["matched"] = static_cast<Json::UInt64>(aggregate.matched);
+        if (aggregate.matched > 0) {
+            response["first"] = format_wall_clock(aggregate.first_us);
+            response["last"] = format_wall_clock(aggregate.last_us);
+        }
+        response["ops"] = ops;
+        send_json(res, response);
+    });
+}
+
+// Thread management endpoints - spawn real pthread threads
+void setup_thread_routes(Server &server) {
+    server.Get("/api/threads", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value threads(Json::arrayValue);
+        
+        auto lock = traced_lock(api_mutex);
+        
+        auto stats_lock = traced_lock(stats_mutex);
+        for (const auto& [id, thread] : managed_threads) {
+            Json::Value thread_obj;
+            thread_obj["id"] = id;
+            thread_obj["status"] = "RUNNING";
+            threads.append(thread_obj);
+        }
+        stats_lock.unlock();
+        
+        response["threads"] = threads;
+        response["total"] = static_cast<int>(threads.size());
+        
+        send_json(res, response);
+    });
+    
+    // Spawn thread endpoint
+    server.Post("/api/threads/spawn", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Reader json_reader;
+        Json::Value request_data;
+        Json::Value response;
+        
+        if (json_reader.parse(req.body, request_data)) {
+            std::string thread_type = request_data["type"].asString();
+            
+            auto lock = traced_lock(api_mutex);
+            ensure_directories_exist();
+            
+            int* tid = new int(thread_id_counter++);
+            pthread_t thread;
+            
+            if (thread_type == "READER") {
+                pthread_create(&thread, nullptr, reader, tid);
+                managed_threads[*tid] = thread;
+                response["success"] = true;
+                response["message"] = "Reader thread spawned";
+                response["threadId"] = *tid;
+            } else if (thread_type == "WRITER") {
+                pthread_create(&thread, nullptr, writer, tid);
+                managed_threads[*tid] = thread;
+                response["success"] = true;
+                response["message"] = "Writer thread spawned";
+                response["threadId"] = *tid;
+            } else if (thread_type == "DELETER") {
+                pthread_create(&thread, nullptr, deleter, tid);
+                managed_threads[*tid] = thread;
+                response["success"] = true;
+                response["message"] = "Deleter thread spawned";
+                response["threadId"] = *tid;
+            } else {
+                delete tid;
+                response["success"] = false;
+                response["message"] = "Invalid thread type";
+            }
+        } else {
+            response["success"] = false;
+            response["message"] = "Invalid JSON";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Run stress test endpoint
+    server.Post("/api/threads/stress-test", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Reader json_reader;
+        Json::Value request_data;
+        Json::Value response;
+        
+        if (json_reader.parse(req.body, request_data)) {
+            WorkloadConfig config;
+            std::string error = parse_workload_config(request_data, config);
+            
+            if (!error.empty()) {
+                res.status = 400;
+                response["success"] = false;
+                response["message"] = error;
+            } else if (!admission_controller.try_begin_background("stress-test")) {
+                // Only one stress test may run at a time
+                res.status = 429;
+                res.set_header("Retry-After", "5");
+                response["success"] = false;
+                response["message"] = "A stress test is already running";
+            } else {
+                // The slot is released when the job function is destroyed:
+                // after the job runs, when the job queue rejects it, or, for
+                // a job cancelled while queued, once a worker dequeues it
+                std::shared_ptr<void> slot(nullptr, [](void*) {
+                    admission_controller.end_background("stress-test");
+                });
+                
+                uint64_t job_id = job_manager.submit("stress-test", workload_config_to_json(config),
+                    [config, slot](JobContext& ctx) {
+                        StressTestResult result = run_workload(config,
+                            [&ctx](int finished, int total) {
+                                ctx.set_progress(static_cast<double>(finished) / total,
+                                                 std::to_string(finished) + "/" + std::to_string(total) + " operations finished");
+                            },
+                            &ctx.cancel_flag());
+                        return stress_result_to_json(result);
+                    });
+                
+                if (job_id == 0) {
+                    res.status = 429;
+                    res.set_header("Retry-After", "5");
+                    response["success"] = false;
+                    response["message"] = "Job queue is full";
+                } else {
+                    res.status = 202;
+                    response["success"] = true;
+                    response["message"] = "Stress test started";
+                    response["threadCount"] = config.operations;
+                    response["jobId"] = static_cast<Json::UInt64>(job_id);
+                    response["statusUrl"] = "/api/jobs/" + std::to_string(job_id);
+                }
+            }
+        } else {
+            response["success"] = false;
+            response["message"] = "Invalid JSON";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Clear/terminate all threads endpoint
+    server.Delete("/api/threads", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        auto lock = traced_lock(api_mutex);
+        
+        int terminated_count = 0;
+        auto stats_lock = traced_lock(stats_mutex);
+        
+        // Detach all managed threads (they will complete naturally)
+        for (auto& [id, thread] : managed_threads) {
+            pthread_detach(thread);
+            terminated_count++;
+        }
+        managed_threads.clear();
+        
+        // Reset thread statistics
+        active_readers = 0;
+        active_writers = 0;
+        active_deleters = 0;
+        
+        stats_lock.unlock();
+        
+        response["success"] = true;
+        response["message"] = "All threads cleared";
+        response["terminatedCount"] = terminated_count;
+        
+        send_json(res, response);
+    });
+}
+
+// Reads the optional "mlfq" {quanta, boostInterval}, "cfs" {targetLatency,
+// minGranularity} and "realtime" {horizon} objects of a schedule request over
+// the current settings. Returns an error message or "".
+std::string parse_scheduler_config(const Json::Value& request_data, MlfqConfig& mlfq, CfsConfig& cfs,
+                                   RealtimeConfig& realtime) {
+    if (request_data.isMember("mlfq")) {
+        const Json::Value& m = request_data["mlfq"];
+        if (m.isMember("quanta")) {
+            if (!m["quanta"].isArray()) return "mlfq.quanta must be an array";
+            mlfq.quanta.clear();
+            for (const auto& q : m["quanta"]) mlfq.quanta.push_back(q.asInt());
+        }
+        mlfq.boost_interval = m.get("boostInterval", mlfq.boost_interval).asInt();
+        std::string error = validate_mlfq_config(mlfq);
+        if (!error.empty()) return error;
+    }
+    if (request_data.isMember("cfs")) {
+        const Json::Value& c = request_data["cfs"];
+        cfs.target_latency = c.get("targetLatency", cfs.target_latency).asInt();
+        cfs.min_granularity = c.get("minGranularity", cfs.min_granularity).asInt();
+        std::string error = validate_cfs_config(cfs);
+        if (!error.empty()) return error;
+    }
+    if (request_data.isMember("realtime")) {
+        realtime.horizon = request_data["realtime"].get("horizon", realtime.horizon).asInt();
+        std::string error = validate_realtime_config(realtime);
+        if (!error.empty()) return error;
+    }
+    return "";
+}
+
+// Per-CPU busy time, utilization, dispatches and steals of the last run
+static Json::Value core_stats_json(const ProcessScheduler& scheduler) {
+    Json::Value stats(Json::arrayValue);
+    for (const auto& core : scheduler.getCoreStats()) {
+        Json::Value c;
+        c["core"] = core.core;
+        c["busyTime"] = core.busy_time;
+        c["utilization"] = core.utilization;
+        c["dispatches"] = static_cast<Json::UInt64>(core.dispatches);
+        c["steals"] = static_cast<Json::UInt64>(core.steals);
+        stats.append(c);
+    }
+    return stats;
+}
+
+// Schedulability test and deadline misses of the last EDF or RM run
+static Json::Value realtime_stats_json(const ProcessScheduler& scheduler) {
+    const RealtimeStats& stats = scheduler.getRealtimeStats();
+    Json::Value r;
+    r["horizon"] = stats.horizon;
+    r["test"] = stats.test;
+    r["schedulable"] = stats.schedulable;
+    r["utilization"] = stats.utilization;
+    r["bound"] = stats.bound;
+    r["jobs"] = static_cast<Json::UInt64>(stats.jobs);
+    r["deadlineMisses"] = static_cast<Json::UInt64>(stats.missed);
+    Json::Value tasks(Json::arrayValue);
+    for (const auto& task : stats.tasks) {
+        Json::Value t;
+        t["pid"] = task.pid;
+        t["jobs"] = static_cast<Json::UInt64>(task.jobs);
+        t["deadlineMisses"] = static_cast<Json::UInt64>(task.missed);
+        t["worstResponseTime"] = task.worst_response;
+        t["averageResponseTime"] = task.average_response;
+        tasks.append(t);
+    }
+    r["tasks"] = tasks;
+    return r;
+}
+
+static bool is_realtime_algorithm(const std::string& algorithm) {
+    return algorithm == "EDF" || algorithm == "RM";
+}
+
+// Reads a process's optional "bursts" ([cpu, io, cpu, ...], odd length) and
+// "devices" (one per I/O burst, default 0). The first CPU burst replaces
+// `burst`. Returns an error message or "".
+static std::string parse_io_bursts(const Json::Value& p, int& burst, std::vector<IoBurst>& out) {
+    const Json::Value& bursts = p["bursts"];
+    const Json::Value& devices = p["devices"];
+    if (bursts.isNull()) return devices.isNull() ? "" : "devices need bursts";
+    if (!bursts.isArray() || bursts.size() % 2 == 0) {
+        return "bursts must alternate CPU and I/O times, starting and ending with CPU";
+    }
+    if (!devices.isNull() && (!devices.isArray() || devices.size() != bursts.size() / 2)) {
+        return "devices must give one device per I/O burst";
+    }
+    burst = bursts[0].asInt();
+    out.clear();
+    for (Json::ArrayIndex k = 1; k < bursts.size(); k += 2) {
+        int device = devices.isNull() ? 0 : devices[k / 2].asInt();
+        out.push_back({device, bursts[k].asInt(), bursts[k + 1].asInt()});
+    }
+    return burst > 0 ? validate_io_bursts(out) : "CPU and I/O bursts must be positive";
+}
+
+static void add_io_bursts_json(const Process& proc, Json::Value& p) {
+    if (proc.io_bursts.empty()) return;
+    Json::Value bursts(Json::arrayValue);
+    Json::Value devices(Json::arrayValue);
+    bursts.append(proc.burst_time);
+    for (const auto& burst : proc.io_bursts) {
+        bursts.append(burst.io_time);
+        bursts.append(burst.cpu_time);
+        devices.append(burst.device);
+    }
+    p["bursts"] = bursts;
+    p["devices"] = devices;
+}
+
+// CPU utilization, I/O overlap and per-device load of the last run with
+// I/O bursts
+static Json::Value io_stats_json(const ProcessScheduler& scheduler) {
+    const IoStats& stats = scheduler.getIoStats();
+    Json::Value io;
+    io["bursts"] = static_cast<Json::UInt64>(stats.bursts);
+    io["cpuBusyTime"] = stats.cpu_busy_time;
+    io["ioBusyTime"] = stats.io_busy_time;
+    io["overlapTime"] = stats.overlap_time;
+    io["cpuUtilization"] = stats.cpu_utilization;
+    io["ioUtilization"] = stats.io_utilization;
+    io["overlap"] = stats.overlap;
+    Json::Value devices(Json::arrayValue);
+    for (const auto& device : stats.devices) {
+        Json::Value d;
+        d["device"] = device.device;
+        d["requests"] = static_cast<Json::UInt64>(device.requests);
+        d["busyTime"] = device.busy_time;
+        d["utilization"] = device.utilization;
+        d["averageQueueTime"] = device.average_queue_time;
+        d["maxQueue"] = static_cast<Json::UInt64>(device.max_queue);
+        devices.append(d);
+    }
+    io["devices"] = devices;
+    return io;
+}
+
+// Why `algorithm` on `cores` CPUs cannot run processes with I/O bursts, or ""
+static std::string io_support_error(const std::string& algorithm, int cores) {
+    if (cores > 1) return "I/O bursts run on a single core";
+    if (!ProcessScheduler::supportsIo(algorithm)) return algorithm + " does not model I/O bursts";
+    return "";
+}
+
+// What-if sweeps get their own threads so they never queue behind jobs
+static WorkerPool& sweep_pool() {
+    static WorkerPool pool(std::max(2u, std::thread::hardware_concurrency()), 64);
+    return pool;
+}
+
+// Reads the "processes" array of a sweep request ({processName, arrivalTime,
+// burstTime, priority, period, deadline, bursts, devices, affinity}).
+// Returns an error message or "".
+static std::string parse_sweep_processes(const Json::Value& list, std::vector<Process>& out) {
+    if (!list.isArray()) return "processes must be an array";
+    out.reserve(list.size());
+    for (Json::ArrayIndex i = 0; i < list.size(); i++) {
+        const Json::Value& p = list[i];
+        int pid = static_cast<int>(i) + 1;
+        int arrival = p.get("arrivalTime", 0).asInt();
+        int burst = p.get("burstTime", 1).asInt();
+        int period = p.get("period", 0).asInt();
+        int deadline = p.get("deadline", 0).asInt();
+        if (arrival < 0 || burst < 0 || period < 0 || deadline < 0) {
+            return "process " + std::to_string(pid) + ": negative time";
+        }
+        out.emplace_back(pid, p.get("processName", "P" + std::to_string(pid)).asString(), arrival, burst,
+                         p.get("priority", 1).asInt());
+        out.back().period = period;
+        out.back().deadline = deadline;
+        std::string error = parse_io_bursts(p, out.back().burst_time, out.back().io_bursts);
+        if (!error.empty()) return "process " + std::to_string(pid) + ": " + error;
+        out.back().remaining_time = out.back().burst_time;
+        for (const auto& cpu : p["affinity"]) {
+            int core = cpu.asInt();
+            if (core < 0 || core >= MAX_SCHEDULER_CORES) return "affinity core out of range: " + std::to_string(core);
+            out.back().affinity |= 1ULL << core;
+        }
+    }
+    return "";
+}
+
+// Charts longer than this are sent downsampled to GANTT_INLINE_RESOLUTION
+// columns per core in the schedule responses; /api/os/processes/gantt pages
+// through the full chart
+static const size_t GANTT_INLINE_ENTRIES = 5000;
+static const int GANTT_INLINE_RESOLUTION = 1000;
+
+static Json::Value gantt_entry_json(const ProcessScheduler& scheduler, const GanttEntry& entry) {
+    Json::Value g;
+    g["processId"] = entry.process_id;
+    g["processName"] = scheduler.getGanttName(entry);
+    g["startTime"] = entry.start_time;
+    g["endTime"] = entry.end_time;
+    g["core"] = entry.core;
+    return g;
+}
+
+// Sets ganttChart, ganttEntries (the full chart's length) and ganttDownsampled
+static void add_gantt_json(const ProcessScheduler& scheduler, Json::Value& response) {
+    const auto& chart = scheduler.getGanttChart();
+    bool downsampled = chart.size() > GANTT_INLINE_ENTRIES;
+    Json::Value entries(Json::arrayValue);
+    if (downsampled) {
+        for (const auto& entry : downsample_gantt(chart, scheduler.getGanttMaxSlice(), 0,
+                                                  scheduler.getGanttMakespan(), GANTT_INLINE_RESOLUTION)) {
+            entries.append(gantt_entry_json(scheduler, entry));
+        }
+    } else {
+        for (const auto& entry : chart) {
+            entries.append(gantt_entry_json(scheduler, entry));
+        }
+    }
+    response["ganttChart"] = entries;
+    response["ganttEntries"] = static_cast<Json::UInt64>(chart.size());
+    response["ganttDownsampled"] = downsampled;
+}
+
+// Process traces are imported from and exported to this directory only
+static const char* TRACE_DIRECTORY = "./traces";
+
+// Path of a trace file in TRACE_DIRECTORY; empty for a name that could leave it
+static std::string trace_file_path(const std::string& name) {
+    if (name.empty() || name.size() > 128 || name[0] == '.') return "";
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '_' && c != '-') return "";
+    }
+    return std::string(TRACE_DIRECTORY) + "/" + name;
+}
+
+// OS Module endpoints
+void setup_os_routes(Server &server) {
+    // Per-event console output is for the CLI demo; in the server it would
+    // only slow every schedule request down behind std::cout
+    process_scheduler.setVerbose(false);
+    
+    // Process Scheduler endpoints
+    server.Get("/api/os/processes", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        // Lock mutex for thread safety
+        auto lock = traced_lock(process_mutex);
+        
+        // Return current state without resetting
+        const auto& procs = process_scheduler.getProcesses();
+        Json::Value processes(Json::arrayValue);
+        
+        for (const auto& proc : procs) {
+            Json::Value p;
+            p["pid"] = proc.pid;
+            p["processName"] = proc.process_name;
+            p["arrivalTime"] = proc.arrival_time;
+            p["burstTime"] = proc.burst_time;
+            p["priority"] = proc.priority;
+            p["period"] = proc.period;
+            p["deadline"] = proc.deadline;
+            add_io_bursts_json(proc, p);
+            p["startTime"] = proc.start_time;
+            p["completionTime"] = proc.completion_time;
+            p["waitingTime"] = proc.waiting_time;
+            p["turnaroundTime"] = proc.turnaround_time;
+            processes.append(p);
+        }
+        
+        response["averageWaitingTime"] = process_scheduler.getAverageWaitingTime();
+        response["averageTurnaroundTime"] = process_scheduler.getAverageTurnaroundTime();
+        response["processCount"] = static_cast<int>(procs.size());
+        response["algorithm"] = process_scheduler.getCurrentAlgorithm();
+        response["cores"] = process_scheduler.getCores();
+        response["coreStats"] = core_stats_json(process_scheduler);
+        response["migrations"] = static_cast<Json::UInt64>(process_scheduler.getMigrationCount());
+        if (is_realtime_algorithm(process_scheduler.getCurrentAlgorithm())) {
+            response["realtime"] = realtime_stats_json(process_scheduler);
+        }
+        if (process_scheduler.hasIo()) {
+            response["io"] = io_stats_json(process_scheduler);
+        }
+        response["processes"] = processes;
+        add_gantt_json(process_scheduler, response);
+        
+        send_json(res, response);
+    });
+    
+    server.Post("/api/os/processes/schedule", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            std::string algorithm = request_body.get("algorithm", "FCFS").asString();
+            int quantum = request_body.get("quantum", 2).asInt();
+            int processCount = request_body.get("processCount", 5).asInt();
+            int cores = request_body.get("cores", 1).asInt();
+            // Random processes with I/O bursts on this many devices; 0 = none
+            int io_devices = request_body.get("ioDevices", 0).asInt();
+            std::string request_error;
+            if (processCount < 1 || processCount > 1000000) {
+                request_error = "processCount must be between 1 and 1000000";
+            } else if (algorithm == "RR" && quantum < 1) {
+                request_error = "RR quantum must be positive";
+            } else if (cores < 1 || cores > MAX_SCHEDULER_CORES) {
+                request_error = "cores must be between 1 and " + std::to_string(MAX_SCHEDULER_CORES);
+            } else if (cores > 1 && (algorithm == "MLFQ" || algorithm == "CFS" || is_realtime_algorithm(algorithm))) {
+                request_error = algorithm + " runs on a single core";
+            } else if (io_devices < 0 || io_devices > MAX_IO_DEVICES) {
+                request_error = "ioDevices must be between 0 and " + std::to_string(MAX_IO_DEVICES);
+            } else if (io_devices > 0) {
+                request_error = io_support_error(algorithm, cores);
+            }
+            if (!request_error.empty()) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = request_error;
+                send_json(res, response);
+                return;
+            }
+            
+            // CRITICAL FIX: Lock mutex to prevent race conditions
+            auto lock = traced_lock(process_mutex);
+            
+            MlfqConfig mlfq = process_scheduler.getMlfqConfig();
+            CfsConfig cfs = process_scheduler.getCfsConfig();
+            RealtimeConfig realtime = process_scheduler.getRealtimeConfig();
+            std::string config_error = parse_scheduler_config(request_body, mlfq, cfs, realtime);
+            if (!config_error.empty()) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = config_error;
+                send_json(res, response);
+                return;
+            }
+            process_scheduler.setMlfqConfig(mlfq);
+            process_scheduler.setCfsConfig(cfs);
+            process_scheduler.setRealtimeConfig(realtime);
+            process_scheduler.setCores(cores);
+            
+            process_scheduler.resetScheduler();
+            if (is_realtime_algorithm(algorithm)) {
+                process_scheduler.generateRandomTasks(processCount);
+            } else if (io_devices > 0) {
+                process_scheduler.generateRandomIoProcesses(processCount, io_devices);
+            } else {
+                process_scheduler.generateRandomProcesses(processCount);
+            }
+            process_scheduler.executeScheduler(algorithm, quantum);
+            // Save the scheduling algorithm and quantum for later re-execution
+            last_scheduling_algorithm = algorithm;
+            last_scheduling_quantum = quantum;
+            
+            
+            // Serialize detailed process data
+            Json::Value processes(Json::arrayValue);
+            const auto& procs = process_scheduler.getProcesses();
+            for (const auto& proc : procs) {
+                Json::Value p;
+                p["pid"] = proc.pid;
+                p["processName"] = proc.process_name;
+                p["arrivalTime"] = proc.arrival_time;
+                p["burstTime"] = proc.burst_time;
+                p["priority"] = proc.priority;
+                p["period"] = proc.period;
+                p["deadline"] = proc.deadline;
+                add_io_bursts_json(proc, p);
+                p["startTime"] = proc.start_time;
+                p["completionTime"] = proc.completion_time;
+                p["waitingTime"] = proc.waiting_time;
+                p["turnaroundTime"] = proc.turnaround_time;
+                processes.append(p);
+            }
+            
+            response["success"] = true;
+            response["algorithm"] = algorithm;
+            response["processCount"] = processCount;
+            response["averageWaitingTime"] = process_scheduler.getAverageWaitingTime();
+            response["averageTurnaroundTime"] = process_scheduler.getAverageTurnaroundTime();
+            response["dispatches"] = static_cast<Json::UInt64>(process_scheduler.getDispatchCount());
+            response["cores"] = cores;
+            response["coreStats"] = core_stats_json(process_scheduler);
+            response["migrations"] = static_cast<Json::UInt64>(process_scheduler.getMigrationCount());
+            if (algorithm == "MLFQ") {
+                Json::Value quanta(Json::arrayValue);
+                for (int q : mlfq.quanta) quanta.append(q);
+                response["mlfq"]["quanta"] = quanta;
+                response["mlfq"]["boostInterval"] = mlfq.boost_interval;
+            } else if (algorithm == "CFS") {
+                response["cfs"]["targetLatency"] = cfs.target_latency;
+                response["cfs"]["minGranularity"] = cfs.min_granularity;
+            } else if (is_realtime_algorithm(algorithm)) {
+                response["realtime"] = realtime_stats_json(process_scheduler);
+            }
+            if (io_devices > 0) {
+                response["io"] = io_stats_json(process_scheduler);
+            }
+            response["processes"] = processes;
+            add_gantt_json(process_scheduler, response);
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Runs one process set under many (algorithm, quantum, cores) configs in
+    // parallel. The set is "processes", else processCount random processes,
+    // else a snapshot of the current list; process_mutex is only held to
+    // take the snapshot.
+    server.Post("/api/os/processes/sweep", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        auto fail = [&](const std::string& error) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = error;
+            send_json(res, response);
+        };
+        if (!req.body.empty() && !reader.parse(req.body, request_body)) {
+            fail("Invalid request body");
+            return;
+        }
+        
+        std::vector<SweepConfig> configs;
+        if (request_body.isMember("configs")) {
+            const Json::Value& list = request_body["configs"];
+            if (!list.isArray() || list.empty() || list.size() > 64) {
+                fail("configs must be an array of 1 to 64 entries");
+                return;
+            }
+            for (const auto& c : list) {
+                SweepConfig config;
+                config.algorithm = c.get("algorithm", "FCFS").asString();
+                config.quantum = c.get("quantum", 2).asInt();
+                config.cores = c.get("cores", 1).asInt();
+                std::string error = validate_sweep_config(config);
+                if (!error.empty()) {
+                    fail(error);
+                    return;
+                }
+                configs.push_back(config);
+            }
+        } else {
+            configs = default_sweep_configs();
+        }
+        
+        std::vector<Process> processes;
+        MlfqConfig mlfq;
+        CfsConfig cfs;
+        RealtimeConfig realtime;
+        {
+            auto lock = traced_lock(process_mutex);
+            mlfq = process_scheduler.getMlfqConfig();
+            cfs = process_scheduler.getCfsConfig();
+            realtime = process_scheduler.getRealtimeConfig();
+            if (!request_body.isMember("processes") && !request_body.isMember("processCount")) {
+                processes = process_scheduler.getProcesses();
+            }
+        }
+        std::string error = parse_scheduler_config(request_body, mlfq, cfs, realtime);
+        if (error.empty() && request_body.isMember("processes")) {
+            error = parse_sweep_processes(request_body["processes"], processes);
+        } else if (error.empty() && request_body.isMember("processCount")) {
+            int count = request_body["processCount"].asInt();
+            if (count < 1 || count > 1000000) {
+                error = "processCount must be between 1 and 1000000";
+            } else {
+                ProcessScheduler generator;
+                generator.generateRandomProcesses(count);
+                processes = generator.getProcesses();
+            }
+        }
+        if (error.empty() && processes.empty()) error = "no processes to schedule";
+        if (error.empty() && processes.size() > 1000000) error = "at most 1000000 processes";
+        if (!error.empty()) {
+            fail(error);
+            return;
+        }
+        
+        auto started = std::chrono::steady_clock::now();
+        std::vector<SweepResult> results = run_schedule_sweep(processes, configs, mlfq, cfs, realtime, sweep_pool());
+        double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        
+        Json::Value table(Json::arrayValue);
+        for (const auto& r : results) {
+            Json::Value row;
+            row["algorithm"] = r.config.algorithm;
+            if (r.config.algorithm == "RR") row["quantum"] = r.config.quantum;
+            row["cores"] = r.config.cores;
+            if (!r.error.empty()) {
+                row["error"] = r.error;
+            } else {
+                row["averageWaitingTime"] = r.average_waiting_time;
+                row["averageTurnaroundTime"] = r.average_turnaround_time;
+                row["throughput"] = r.throughput;
+                row["makespan"] = r.makespan;
+                row["dispatches"] = static_cast<Json::UInt64>(r.dispatches);
+                if (is_realtime_algorithm(r.config.algorithm)) {
+                    row["deadlineMisses"] = static_cast<Json::UInt64>(r.deadline_misses);
+                }
+                if (r.io) {
+                    row["cpuUtilization"] = r.cpu_utilization;
+                    row["ioOverlap"] = r.io_overlap;
+                }
+            }
+            row["elapsedMs"] = r.elapsed_ms;
+            table.append(row);
+        }
+        
+        response["success"] = true;
+        response["processCount"] = static_cast<Json::UInt64>(processes.size());
+        response["threads"] = static_cast<Json::UInt64>(std::min(sweep_pool().thread_count() + 1, configs.size()));
+        response["elapsedMs"] = elapsed_ms;
+        response["results"] = table;
+        send_json(res, response);
+    });
+    
+    // Pages through the Gantt chart of the last run. from/to (default: the
+    // whole schedule) keep the entries overlapping [from, to); offset and
+    // limit (1-10000, default 1000) page through them. resolution=N instead
+    // returns the window downsampled to N columns per core (gantt_view.h).
+    server.Get("/api/os/processes/gantt", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        size_t offset = 0;
+        size_t limit = 1000;
+        int resolution = 0;
+        if (req.has_param("offset")) offset = static_cast<size_t>(std::max(0, std::atoi(req.get_param_value("offset").c_str())));
+        if (req.has_param("limit")) limit = static_cast<size_t>(std::clamp(std::atoi(req.get_param_value("limit").c_str()), 1, 10000));
+        if (req.has_param("resolution")) {
+            resolution = std::atoi(req.get_param_value("resolution").c_str());
+            if (resolution < 1 || resolution > 10000) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = "resolution must be between 1 and 10000";
+                send_json(res, response);
+                return;
+            }
+        }
+        
+        auto lock = traced_lock(process_mutex);
+        const auto& chart = process_scheduler.getGanttChart();
+        int max_slice = process_scheduler.getGanttMaxSlice();
+        int from = req.has_param("from") ? std::max(0, std::atoi(req.get_param_value("from").c_str())) : 0;
+        int to = req.has_param("to") ? std::atoi(req.get_param_value("to").c_str()) : process_scheduler.getGanttMakespan();
+        
+        Json::Value entries(Json::arrayValue);
+        size_t total = 0;
+        if (resolution > 0) {
+            std::vector<GanttEntry> view = downsample_gantt(chart, max_slice, from, to, resolution);
+            total = view.size();
+            for (size_t i = offset; i < view.size() && i < offset + limit; i++) {
+                entries.append(gantt_entry_json(process_scheduler, view[i]));
+            }
+            response["bucketWidth"] = to > from ? static_cast<double>(to - from) / std::min(resolution, to - from) : 0.0;
+        } else {
+            GanttWindow window = gantt_window(chart, max_slice, from, to);
+            total = window.size();
+            for (size_t k = offset; k < total && k < offset + limit; k++) {
+                entries.append(gantt_entry_json(process_scheduler, chart[window[k]]));
+            }
+        }
+        
+        response["success"] = true;
+        response["from"] = from;
+        response["to"] = to;
+        response["total"] = static_cast<Json::UInt64>(total);
+        response["offset"] = static_cast<Json::UInt64>(offset);
+        response["limit"] = static_cast<Json::UInt64>(limit);
+        if (offset + limit < total) response["nextOffset"] = static_cast<Json::UInt64>(offset + limit);
+        response["downsampled"] = resolution > 0;
+        response["entries"] = entries;
+        send_json(res, response);
+    });
+    
+    // Replaces the process list with a trace (see process_trace.h): the
+    // request body itself when sent as text/csv or application/octet-stream,
+    // else {"file": name} for a trace in ./traces, which is memory-mapped.
+    // The trace is parsed before process_mutex is taken; the last scheduling
+    // algorithm then re-runs on it, as after /add. When it cannot run the
+    // trace, the import still stands and "scheduleError" says why.
+    server.Post("/api/os/processes/import", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        auto fail = [&](const std::string& error) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = error;
+            send_json(res, response);
+        };
+        
+        auto started = std::chrono::steady_clock::now();
+        std::string content_type = req.get_header_value("Content-Type");
+        ProcessTable trace;
+        TraceFormat format = TraceFormat::CSV;
+        std::string error;
+        if (content_type.rfind("text/csv", 0) == 0 || content_type.rfind("application/octet-stream", 0) == 0) {
+            error = parse_process_trace(req.body.data(), req.body.size(), trace, &format);
+        } else {
+            Json::Reader reader;
+            Json::Value request_body;
+            if (!reader.parse(req.body, request_body) || !request_body["file"].isString()) {
+                fail("send a text/csv or application/octet-stream trace, or {\"file\": name}");
+                return;
+            }
+            std::string path = trace_file_path(request_body["file"].asString());
+            if (path.empty()) {
+                fail("invalid trace file name");
+                return;
+            }
+            error = load_process_trace(path, trace, &format);
+        }
+        if (!error.empty()) {
+            fail(error);
+            return;
+        }
+        double parse_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        size_t count = trace.size();
+        
+        auto lock = traced_lock(process_mutex);
+        process_scheduler.setProcesses(std::move(trace));
+        process_scheduler.resetProcessStates();
+        if (!last_scheduling_algorithm.empty()) {
+            process_scheduler.executeScheduler(last_scheduling_algorithm, last_scheduling_quantum);
+            response["algorithm"] = last_scheduling_algorithm;
+            // A refused re-run leaves no schedule to average
+            const std::string& rerun_error = process_scheduler.getRunError();
+            if (rerun_error.empty()) {
+                response["averageWaitingTime"] = process_scheduler.getAverageWaitingTime();
+                response["averageTurnaroundTime"] = process_scheduler.getAverageTurnaroundTime();
+            } else {
+                response["scheduleError"] = rerun_error;
+            }
+        }
+        
+        response["success"] = true;
+        response["format"] = trace_format_name(format);
+        response["processCount"] = static_cast<Json::UInt64>(count);
+        response["parseMs"] = parse_ms;
+        send_json(res, response);
+    });
+    
+    // Streams the process list with its schedule results as CSV, or as a
+    // binary trace with ?format=binary. With ?file=name the export goes to
+    // ./traces instead, ready for /import. The list is copied under
+    // process_mutex and written from the copy.
+    server.Get("/api/os/processes/export", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        auto fail = [&](int status, const std::string& error) {
+            res.status = status;
+            response["success"] = false;
+            response["error"] = error;
+            send_json(res, response);
+        };
+        
+        TraceFormat format = TraceFormat::CSV;
+        if (req.has_param("format") && !parse_trace_format(req.get_param_value("format"), format)) {
+            fail(400, "format must be csv or binary");
+            return;
+        }
+        std::string path;
+        if (req.has_param("file")) {
+            path = trace_file_path(req.get_param_value("file"));
+            if (path.empty()) {
+                fail(400, "invalid trace file name");
+                return;
+            }
+        }
+        
+        auto snapshot = std::make_shared<ProcessTable>();
+        {
+            auto lock = traced_lock(process_mutex);
+            *snapshot = process_scheduler.getProcessTable();
+        }
+        
+        if (!path.empty()) {
+            std::error_code ec;
+            fs::create_directories(TRACE_DIRECTORY, ec);
+            std::string error = save_process_trace(path, *snapshot, format);
+            if (!error.empty()) {
+                fail(500, error);
+                return;
+            }
+            response["success"] = true;
+            response["file"] = req.get_param_value("file");
+            response["format"] = trace_format_name(format);
+            response["processCount"] = static_cast<Json::UInt64>(snapshot->size());
+            send_json(res, response);
+            return;
+        }
+        
+        bool binary = format == TraceFormat::BINARY;
+        res.set_header("Content-Disposition", binary ? "attachment; filename=\"processes.ptrace\""
+                                                     : "attachment; filename=\"processes.csv\"");
+        res.set_chunked_content_provider(binary ? "application/octet-stream" : "text/csv",
+            [snapshot, format](size_t, DataSink &sink) {
+                write_process_trace(*snapshot, format, [&sink](const char* data, size_t size) {
+                    return sink.write(data, size);
+                });
+                sink.done();
+                return true;
+            });
+    });
+    
+    // Add manual process endpoint
+    server.Post("/api/os/processes/add", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            auto lock = traced_lock(process_mutex);
+            
+            std::string processName = request_body.get("processName", "Custom Process").asString();
+            int arrivalTime = request_body.get("arrivalTime", 0).asInt();
+            int burstTime = request_body.get("burstTime", 1).asInt();
+            int priority = request_body.get("priority", 1).asInt();
+            // EDF/RM: a job every period, each due deadline after its release
+            int period = request_body.get("period", 0).asInt();
+            int deadline = request_body.get("deadline", 0).asInt();
+            if (period < 0 || deadline < 0) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = "period and deadline must be non-negative";
+                send_json(res, response);
+                return;
+            }
+            // Optional CPU/I/O burst sequence; the last algorithm must be able to run it
+            std::vector<IoBurst> io_bursts;
+            std::string io_error = parse_io_bursts(request_body, burstTime, io_bursts);
+            if (io_error.empty() && !io_bursts.empty() && !last_scheduling_algorithm.empty()) {
+                io_error = io_support_error(last_scheduling_algorithm, process_scheduler.getCores());
+            }
+            if (!io_error.empty()) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = io_error;
+                send_json(res, response);
+                return;
+            }
+            
+            // Optional list of CPUs the process may run on in multi-core runs
+            uint64_t affinity = 0;
+            const Json::Value& cpus = request_body["affinity"];
+            if (!cpus.isNull() && !cpus.isArray()) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = "affinity must be an array of core numbers";
+                send_json(res, response);
+                return;
+            }
+            for (const auto& cpu : cpus) {
+                int core = cpu.asInt();
+                if (core < 0 || core >= MAX_SCHEDULER_CORES) {
+                    res.status = 400;
+                    response["success"] = false;
+                    response["error"] = "affinity core out of range: " + std::to_string(core);
+                    send_json(res, response);
+                    return;
+                }
+                affinity |= 1ULL << core;
+            }
+            
+            // Create and add the process
+            int pid = process_scheduler.getNextPid();
+            Process newProcess(pid, processName, arrivalTime, burstTime, priority);
+            newProcess.affinity = affinity;
+            newProcess.period = period;
+            newProcess.deadline = deadline;
+            newProcess.io_bursts = io_bursts;
+            process_scheduler.addProcess(newProcess);
+            
+            // Re-run the last scheduling algorithm if one was executed
+            if (!last_scheduling_algorithm.empty()) {
+                process_scheduler.resetProcessStates();
+                process_scheduler.executeScheduler(last_scheduling_algorithm, last_scheduling_quantum);
+            }
+            
+            response["success"] = true;
+            response["message"] = "Process added successfully";
+            response["process"]["pid"] = pid;
+            response["process"]["processName"] = processName;
+            response["process"]["arrivalTime"] = arrivalTime;
+            response["process"]["burstTime"] = burstTime;
+            response["process"]["priority"] = priority;
+            response["process"]["period"] = period;
+            response["process"]["deadline"] = deadline;
+            add_io_bursts_json(newProcess, response["process"]);
+            if (!cpus.isNull()) response["process"]["affinity"] = cpus;
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Edit process endpoint
+    server.Post(R"(/api/os/processes/edit/(\d+))", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        // Extract pid from path
+        std::string path = req.path;
+        std::string prefix = "/api/os/processes/edit/";
+        int pid = std::stoi(path.substr(prefix.length()));
+        
+        if (reader.parse(req.body, request_body)) {
+            auto lock = traced_lock(process_mutex);
+            
+            std::string processName = request_body.get("processName", "").asString();
+            int arrivalTime = request_body.get("arrivalTime", 0).asInt();
+            int burstTime = request_body.get("burstTime", 1).asInt();
+            int priority = request_body.get("priority", 1).asInt();
+            
+            bool success = process_scheduler.editProcessAPI(pid, processName, arrivalTime, burstTime, priority);
+            
+            // Re-run the last scheduling algorithm if one was executed
+            if (success && !last_scheduling_algorithm.empty()) {
+                process_scheduler.resetProcessStates();
+                process_scheduler.executeScheduler(last_scheduling_algorithm, last_scheduling_quantum);
+            }
+            
+            if (success) {
+                const Process* proc = process_scheduler.findProcess(pid);
+                response["success"] = true;
+                response["message"] = "Process updated successfully";
+                response["process"]["pid"] = proc->pid;
+                response["process"]["processName"] = proc->process_name;
+                response["process"]["arrivalTime"] = proc->arrival_time;
+                response["process"]["burstTime"] = proc->burst_time;
+                response["process"]["priority"] = proc->priority;
+            } else {
+                response["success"] = false;
+                response["error"] = "Process not found or invalid parameters";
+            }
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Delete process endpoint
+    server.Delete(R"(/api/os/processes/(\d+))", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        // Extract pid from path
+        std::string path = req.path;
+        std::string prefix = "/api/os/processes/";
+        int pid = std::stoi(path.substr(prefix.length()));
+        
+        auto lock = traced_lock(process_mutex);
+        
+        const Process* proc = process_scheduler.findProcess(pid);
+        if (proc) {
+            std::string processName = proc->process_name;
+            process_scheduler.deleteProcess(pid);
+            
+            // Re-run the last scheduling algorithm if one was executed
+            if (!last_scheduling_algorithm.empty()) {
+                process_scheduler.resetProcessStates();
+                process_scheduler.executeScheduler(last_scheduling_algorithm, last_scheduling_quantum);
+            }
+            
+            response["success"] = true;
+            response["message"] = "Process deleted successfully";
+            response["deletedProcess"]["pid"] = pid;
+            response["deletedProcess"]["processName"] = processName;
+        } else {
+            response["success"] = false;
+            response["error"] = "Process not found";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // File System endpoints
+    server.Get("/api/os/filesystem", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        response["totalBlocks"] = 1024;
+        response["blockSize"] = 4096;
+        response["utilization"] = file_system.getDiskUtilization();
+        response["status"] = "operational";
+        
+        send_json(res, response);
+    });
+    
+    server.Post("/api/os/filesystem/create", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            std::string path = request_body.get("path", "/test.txt").asString();
+            std::string data = request_body.get("data", "").asString();
+            
+            bool created = file_system.createFile(path, 0);
+            bool written = false;
+            if (created && !data.empty()) {
+                written = file_system.writeFile(path, data);
+            }
+            
+            response["success"] = created;
+            response["written"] = written;
+            response["utilization"] = file_system.getDiskUtilization();
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // IPC endpoints
+    server.Get("/api/os/ipc", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        response["messageQueues"] = ipc_manager.getMessageQueueCount();
+        response["sharedMemorySegments"] = ipc_manager.getSharedMemoryCount();
+        response["status"] = "operational";
+        
+        send_json(res, response);
+    });
+    
+    server.Post("/api/os/ipc/message", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            int queueId = request_body.get("queueId", 1).asInt();
+            int sender = request_body.get("sender", 100).asInt();
+            int receiver = request_body.get("receiver", 200).asInt();
+            std::string content = request_body.get("content", "Test message").asString();
+            
+            // Ensure queue exists
+            ipc_manager.createMessageQueue(queueId, 10);
+            bool sent = ipc_manager.sendMessage(queueId, sender, receiver, content);
+            
+            response["success"] = sent;
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // View IPC messages endpoint
+    server.Get("/api/os/ipc/messages", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        response["totalMessages"] = ipc_manager.getTotalMessages();
+        response["queues"] = ipc_manager.getMessageQueueCount();
+        response["sharedMemorySegments"] = ipc_manager.getSharedMemoryCount();
+        response["status"] = "operational";
+        
+        send_json(res, response);
+    });
+    
+    // Deadlock Detection endpoints
+    server.Get("/api/os/deadlock", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        bool hasDeadlock = deadlock_detector.detectDeadlock();
+        bool safeState = deadlock_detector.isSafeState();
+        
+        response["hasDeadlock"] = hasDeadlock;
+        response["safeState"] = safeState;
+        response["status"] = "operational";
+        
+        send_json(res, response);
+    });
+    
+    server.Post("/api/os/deadlock/simulate", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        deadlock_detector.simulateDeadlockScenario();
+        bool hasDeadlock = deadlock_detector.detectDeadlock();
+        
+        response["success"] = true;
+        response["deadlockCreated"] = hasDeadlock;
+        
+        send_json(res, response);
+    });
+    
+    server.Get("/api/os/deadlock/visualize", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        // Get wait-for graph
+        const auto& waitForGraph = deadlock_detector.getWaitForGraph();
+        const auto& processes = deadlock_detector.getProcesses();
+        const auto& resources = deadlock_detector.getResources();
+        
+        // Build wait-for graph JSON
+        Json::Value graphData(Json::arrayValue);
+        for (const auto& entry : waitForGraph) {
+            int processId = entry.first;
+            const auto& waitingFor = entry.second;
+            Json::Value edge;
+            edge["processId"] = processId;
+            
+            // Find process name
+            auto procIt = std::find_if(processes.begin(), processes.end(),
+                [processId](const DLProcess& p) { return p.process_id == processId; });
+            edge["processName"] = (procIt != processes.end()) ? procIt->process_name : "P" + std::to_string(processId);
+            
+            // Add waiting for list
+            Json::Value waitingList(Json::arrayValue);
+            for (int waitId : waitingFor) {
+                auto waitProcIt = std::find_if(processes.begin(), processes.end(),
+                    [waitId](const DLProcess& p) { return p.process_id == waitId; });
+                Json::Value waitInfo;
+                waitInfo["processId"] = waitId;
+                waitInfo["processName"] = (waitProcIt != processes.end()) ? waitProcIt->process_name : "P" + std::to_string(waitId);
+                waitingList.append(waitInfo);
+            }
+            edge["waitingFor"] = waitingList;
+            graphData.append(edge);
+        }
+        
+        // Build processes info
+        Json::Value processesData(Json::arrayValue);
+        for (const auto& proc : processes) {
+            Json::Value procInfo;
+            procInfo["id"] = proc.process_id;
+            procInfo["name"] = proc.process_name;
+            
+            // Allocated resources
+            Json::Value allocatedRes(Json::arrayValue);
+            for (const auto& alloc : proc.allocated) {
+                int resId = alloc.first;
+                int amount = alloc.second;
+                if (amount > 0) {
+                    auto resIt = std::find_if(resources.begin(), resources.end(),
+                        [resId](const Resource& r) { return r.resource_id == resId; });
+                    Json::Value resInfo;
+                    resInfo["id"] = resId;
+                    resInfo["name"] = (resIt != resources.end()) ? resIt->resource_name : "R" + std::to_string(resId);
+                    resInfo["amount"] = amount;
+                    allocatedRes.append(resInfo);
+                }
+            }
+            procInfo["allocated"] = allocatedRes;
+            
+            // Needed resources
+            Json::Value neededRes(Json::arrayValue);
+            for (const auto& need : proc.needed) {
+                int resId = need.first;
+                int amount = need.second;
+                if (amount > 0) {
+                    auto resIt = std::find_if(resources.begin(), resources.end(),
+                        [resId](const Resource& r) { return r.resource_id == resId; });
+                    Json::Value resInfo;
+                    resInfo["id"] = resId;
+                    resInfo["name"] = (resIt != resources.end()) ? resIt->resource_name : "R" + std::to_string(resId);
+                    resInfo["amount"] = amount;
+                    neededRes.append(resInfo);
+                }
+            }
+            procInfo["needed"] = neededRes;
+            processesData.append(procInfo);
+        }
+        
+        response["waitForGraph"] = graphData;
+        
+        // Build RAG (Resource Allocation Graph) data
+        auto ragEdges = deadlock_detector.getResourceAllocationGraph();
+        Json::Value ragEdgesData(Json::arrayValue);
+        for (const auto& edge : ragEdges) {
+            Json::Value edgeJson;
+            edgeJson["type"] = edge.type;
+            edgeJson["from"]["id"] = edge.from_id;
+            edgeJson["from"]["type"] = edge.from_type;
+            edgeJson["from"]["name"] = edge.from_name;
+            edgeJson["to"]["id"] = edge.to_id;
+            edgeJson["to"]["type"] = edge.to_type;
+            edgeJson["to"]["name"] = edge.to_name;
+            edgeJson["units"] = edge.units;
+            ragEdgesData.append(edgeJson);
+        }
+        
+        // Build resources info
+        Json::Value resourcesData(Json::arrayValue);
+        for (const auto& res : resources) {
+            Json::Value resInfo;
+            resInfo["id"] = res.resource_id;
+            resInfo["name"] = res.resource_name;
+            resInfo["total"] = res.total_units;
+            resInfo["available"] = res.available_units;
+            resourcesData.append(resInfo);
+        }
+        
+        response["ragEdges"] = ragEdgesData;
+        response["resources"] = resourcesData;
+        response["processes"] = processesData;
+        response["hasDeadlock"] = deadlock_detector.detectDeadlock();
+        
+        send_json(res, response);
+    });
+    
+    server.Post("/api/os/deadlock/recover", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        auto deadlockedBefore = deadlock_detector.findDeadlockedProcesses();
+        deadlock_detector.recoverFromDeadlock();
+        auto deadlockedAfter = deadlock_detector.findDeadlockedProcesses();
+        
+        response["success"] = true;
+        response["processesTerminated"] = static_cast<int>(deadlockedBefore.size() - deadlockedAfter.size());
+        response["stillDeadlocked"] = deadlock_detector.detectDeadlock();
+        
+        send_json(res, response);
+    });
+    
+    // Shared Memory endpoints
+    server.Post("/api/os/ipc/shared-memory", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            std::string name = request_body.get("name", "").asString();
+            int size = request_body.get("size", 1024).asInt();
+            std::string initialData = request_body.get("data", "").asString();
+            
+            if (name.empty()) {
+                response["success"] = false;
+                response["error"] = "Memory segment name is required";
+            } else {
+                void* segment = ipc_manager.createSharedMemory(name, size);
+                if (segment && !initialData.empty()) {
+                    ipc_manager.writeToSharedMemory(name, initialData);
+                }
+                response["success"] = (segment != nullptr);
+                response["name"] = name;
+                response["size"] = size;
+            }
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    server.Get("/api/os/ipc/shared-memory", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        
+        if (!req.has_param("name")) {
+            response["success"] = false;
+            response["error"] = "Memory segment name is required";
+        } else {
+            std::string name = req.get_param_value("name");
+            if (name.empty()) {
+                response["success"] = false;
+                response["error"] = "Memory segment name cannot be empty";
+            } else {
+                std::string data = ipc_manager.readFromSharedMemory(name);
+                
+                if (data.find("❌") != std::string::npos) {
+                    response["success"] = false;
+                    response["error"] = "Shared memory segment not found";
+                } else {
+                    response["success"] = true;
+                    response["name"] = name;
+                    response["data"] = data;
+                }
+            }
+        }
+        
+        send_json(res, response);
+    });
+    
+    server.Post("/api/os/ipc/shared-memory/write", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            std::string name = request_body.get("name", "").asString();
+            std::string data = request_body.get("data", "").asString();
+            
+            if (name.empty()) {
+                response["success"] = false;
+                response["error"] = "Memory segment name is required";
+            } else {
+                ipc_manager.writeToSharedMemory(name, data);
+                response["success"] = true;
+                response["name"] = name;
+            }
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+    
+    // Comprehensive OS simulation
+    server.Post("/api/os/simulate", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        if (reader.parse(req.body, request_body)) {
+            std::string module = request_body.get("module", "all").asString();
+            std::vector<std::string> modules;
+            for (const char* name : {"processes", "filesystem", "ipc", "deadlock"}) {
+                if (module == name || module == "all") {
+                    modules.push_back(name);
+                }
+            }
+            
+            if (modules.empty()) {
+                res.status = 400;
+                response["success"] = false;
+                response["error"] = "Unknown module: " + module;
+            } else {
+                Json::Value params;
+                params["module"] = module;
+                uint64_t job_id = job_manager.submit("os-simulate", params, [modules](JobContext& ctx) {
+                    return run_simulation_job(modules, ctx);
+                });
+                
+                if (job_id == 0) {
+                    res.status = 429;
+                    res.set_header("Retry-After", "5");
+                    response["success"] = false;
+                    response["error"] = "Job queue is full";
+                } else {
+                    res.status = 202;
+                    response["success"] = true;
+                    response["module"] = module;
+                    response["jobId"] = static_cast<Json::UInt64>(job_id);
+                    response["statusUrl"] = "/api/jobs/" + std::to_string(job_id);
+                }
+            }
+        } else {
+            response["success"] = false;
+            response["error"] = "Invalid request body";
+        }
+        
+        send_json(res, response);
+    });
+}
+
+// Job status, results and cancellation
+void setup_job_routes(Server &server) {
+    server.Get("/api/jobs", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value jobs(Json::arrayValue);
+        
+        for (const auto& job : job_manager.list()) {
+            jobs.append(job_to_json(job, false));
+        }
+        
+        response["jobs"] = jobs;
+        response["queued"] = static_cast<Json::UInt64>(job_manager.queued());
+        response["running"] = static_cast<Json::UInt64>(job_manager.running());
+        response["queueCapacity"] = static_cast<Json::UInt64>(job_manager.queue_capacity());
+        
+        send_json(res, response);
+    });
+    
+    server.Get(R"(/api/jobs/(\d+))", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        JobInfo job;
+        uint64_t id = 0;
+        
+        if (!parse_job_id(req.matches[1], id)) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = "Invalid job id";
+        } else if (job_manager.get(id, job)) {
+            response = job_to_json(job, true);
+        } else {
+            res.status = 404;
+            response["success"] = false;
+            response["error"] = "Job not found";
+        }
+        
+        send_json(res, response);
+    });
+    
+    server.Delete(R"(/api/jobs/(\d+))", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        uint64_t id = 0;
+        JobInfo job;
+        
+        if (!parse_job_id(req.matches[1], id)) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = "Invalid job id";
+        } else if (!job_manager.get(id, job)) {
+            res.status = 404;
+            response["success"] = false;
+            response["error"] = "Job not found";
+        } else if (job_manager.cancel(id)) {
+            job_manager.get(id, job);
+            response["success"] = true;
+            response["job"] = job_to_json(job, false);
+        } else {
+            res.status = 409;
+            response["success"] = false;
+            response["error"] = "Job already finished";
+        }
+        
+        send_json(res, response);
+    });
+}
+
+Json::Value slow_request_to_json(const SlowRequest& slow) {
+    Json::Value j;
+    j["requestId"] = static_cast<Json::UInt64>(slow.id);
+    j["timestamp"] = slow.timestamp;
+    j["method"] = slow.method;
+    j["path"] = slow.path;
+    j["route"] = slow.route;
+    j["status"] = slow.status;
+    j["totalMs"] = slow.total_ms;
+    j["queueMs"] = slow.queue_ms;
+    j["lockWaitMs"] = slow.lock_wait_ms;
+    j["computeMs"] = slow.compute_ms;
+    j["serializeMs"] = slow.serialize_ms;
+    return j;
+}
+
+// Per-route latency tracing with phase breakdown and a slow request log
+void setup_request_tracing(DispatchServer &server, double slow_threshold_ms) {
+    request_tracer.set_slow_threshold_ms(slow_threshold_ms);
+    
+    server.add_pre_routing_hook([](const Request &req, Response &res) {
+        thread_local bool named = false;
+        if (!named) {
+            named = true;
+            set_trace_thread_name("http");
+        }
+        uint64_t id = request_tracer.begin();
+        res.set_header("X-Request-Id", std::to_string(id));
+        return Server::HandlerResponse::Unhandled;
+    });
+    
+    server.add_post_routing_hook([](const Request &req, Response &res) {
+        std::string route = req.matched_route.empty() ? "unmatched" : req.matched_route;
+        request_tracer.end(req.method, req.path, route, res.status);
+    });
+    
+    // Routes ordered by total time spent, hottest first
+    server.Get("/api/traces/routes", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value routes(Json::arrayValue);
+        
+        for (const auto& stats : request_tracer.route_stats()) {
+            Json::Value r;
+            double count = stats.count > 0 ? static_cast<double>(stats.count) : 1.0;
+            r["method"] = stats.method;
+            r["route"] = stats.route;
+            r["count"] = static_cast<Json::UInt64>(stats.count);
+            r["errors"] = static_cast<Json::UInt64>(stats.errors);
+            r["slow"] = static_cast<Json::UInt64>(stats.slow);
+            r["totalMs"] = stats.total_ms;
+            r["avgMs"] = stats.total_ms / count;
+            r["p50Ms"] = stats.p50_ms;
+            r["p95Ms"] = stats.p95_ms;
+            r["p99Ms"] = stats.p99_ms;
+            r["maxMs"] = stats.max_ms;
+            
+            Json::Value phases;
+            phases["queueMs"] = stats.queue_ms / count;
+            phases["lockWaitMs"] = stats.lock_wait_ms / count;
+            phases["computeMs"] = stats.compute_ms / count;
+            phases["serializeMs"] = stats.serialize_ms / count;
+            r["avgPhases"] = phases;
+            routes.append(r);
+        }
+        
+        response["routes"] = routes;
+        response["slowThresholdMs"] = request_tracer.slow_threshold();
+        send_json(res, response);
+    });
+    
+    server.Get("/api/traces/slow", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value requests(Json::arrayValue);
+        
+        size_t limit = 50;
+        if (req.has_param("limit")) {
+            limit = static_cast<size_t>(std::max(1, std::atoi(req.get_param_value("limit").c_str())));
+        }
+        for (const auto& slow : request_tracer.slow_requests(limit)) {
+            requests.append(slow_request_to_json(slow));
+        }
+        
+        response["requests"] = requests;
+        response["slowThresholdMs"] = request_tracer.slow_threshold();
+        send_json(res, response);
+    });
+    
+    server.Put("/api/traces/config", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        
+        bool parsed = reader.parse(req.body, request_body) && request_body.isObject();
+        bool has_threshold = parsed && request_body.isMember("slowThresholdMs");
+        bool has_tracing = parsed && request_body.isMember("eventTracing");
+        if (!has_threshold && !has_tracing) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = "Expected slowThresholdMs and/or eventTracing";
+        } else if (has_threshold && (!request_body["slowThresholdMs"].isNumeric() ||
+                                     request_body["slowThresholdMs"].asDouble() < 0)) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = "slowThresholdMs must be a non-negative number";
+        } else if (has_tracing && !request_body["eventTracing"].isBool()) {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = "eventTracing must be a boolean";
+        } else {
+            if (has_threshold) request_tracer.set_slow_threshold_ms(request_body["slowThresholdMs"].asDouble());
+            if (has_tracing) event_tracer.set_enabled(request_body["eventTracing"].asBool());
+            response["success"] = true;
+            response["slowThresholdMs"] = request_tracer.slow_threshold();
+            response["eventTracing"] = event_tracer.is_enabled();
+        }
+        send_json(res, response);
+    });
+    
+    server.Delete("/api/traces", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        request_tracer.reset();
+        event_tracer.clear();
+        response["success"] = true;
+        send_json(res, response);
+    });
+    
+    // Per-thread event timelines as Chrome trace JSON; open in ui.perfetto.dev
+    // or chrome://tracing. ?sinceMs=N keeps only the last N milliseconds.
+    server.Get("/api/traces/chrome", [](const Request &req, Response &res) {
+        setup_cors(res);
+        int64_t since_ns = 0;
+        if (req.has_param("sinceMs")) {
+            int64_t window_ns = std::atoll(req.get_param_value("sinceMs").c_str()) * 1000000;
+            since_ns = FastClock::now().time_since_epoch().count() - window_ns;
+        }
+        EventTracer::Snapshot snapshot = event_tracer.snapshot(since_ns);
+        res.set_header("X-Trace-Events", std::to_string(snapshot.events.size()));
+        res.set_header("X-Trace-Dropped", std::to_string(snapshot.dropped));
+        res.set_content(chrome_trace_json(snapshot), "application/json");
+    });
+}
+
+static Json::Value lock_profile_to_json(const LockProfile &p) {
+    Json::Value lock;
+    lock["name"] = p.name;
+    lock["acquisitions"] = static_cast<Json::UInt64>(p.acquisitions);
+    lock["contended"] = static_cast<Json::UInt64>(p.contended);
+    lock["contentionRate"] = p.acquisitions > 0 ? static_cast<double>(p.contended) / p.acquisitions : 0.0;
+    lock["totalWaitMs"] = p.total_wait_ms;
+    lock["maxWaitMs"] = p.max_wait_ms;
+    lock["avgWaitUs"] = p.contended > 0 ? p.total_wait_ms * 1000.0 / p.contended : 0.0;
+    lock["totalHoldMs"] = p.total_hold_ms;
+    lock["maxHoldMs"] = p.max_hold_ms;
+    lock["avgHoldUs"] = p.acquisitions > 0 ? p.total_hold_ms * 1000.0 / p.acquisitions : 0.0;
+    
+    Json::Value histogram(Json::arrayValue);
+    for (const auto& [bound_us, count] : p.hold_histogram) {
+        Json::Value bucket;
+        bucket["leUs"] = bound_us < 0 ? Json::Value("+Inf") : Json::Value(bound_us);
+        bucket["count"] = static_cast<Json::UInt64>(count);
+        histogram.append(bucket);
+    }
+    lock["holdHistogram"] = histogram;
+    
+    Json::Value waiters(Json::arrayValue);
+    for (const auto& w : p.top_waiters) {
+        Json::Value waiter;
+        waiter["site"] = w.site;
+        waiter["count"] = static_cast<Json::UInt64>(w.count);
+        waiter["waitMs"] = w.wait_ms;
+        waiters.append(waiter);
+    }
+    lock["topWaiters"] = waiters;
+    return lock;
+}
+
+// Lock contention profile of the named global mutexes, most total wait first.
+// Profiling is off unless CLOUD_LOCK_PROFILING=1 or enabled here.
+void setup_lock_routes(Server &server) {
+    server.Get("/api/locks", [](const Request &req, Response &res) {
+        setup_cors(res);
+        size_t top = 5;
+        if (req.has_param("top")) {
+            top = static_cast<size_t>(std::clamp(std::atoi(req.get_param_value("top").c_str()), 0, 100));
+        }
+        Json::Value response;
+        Json::Value locks(Json::arrayValue);
+        for (const auto& p : lock_profiles(top)) {
+            locks.append(lock_profile_to_json(p));
+        }
+        response["enabled"] = lock_profiling_enabled.load();
+        response["locks"] = locks;
+        send_json(res, response);
+    });
+    
+    server.Put("/api/locks/config", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Reader reader;
+        Json::Value request_body;
+        if (reader.parse(req.body, request_body) && request_body.isObject() &&
+            request_body["enabled"].isBool()) {
+            lock_profiling_enabled.store(request_body["enabled"].asBool());
+            response["success"] = true;
+            response["enabled"] = lock_profiling_enabled.load();
+        } else {
+            res.status = 400;
+            response["success"] = false;
+            response["error"] = "enabled must be a boolean";
+        }
+        send_json(res, response);
+    });
+    
+    server.Delete("/api/locks", [](const Request &req, Response &res) {
+        setup_cors(res);
+        reset_lock_profiles();
+        Json::Value response;
+        response["success"] = true;
+        send_json(res, response);
+    });
+}
+
+// Heap allocations per route, from the first pre-routing hook to the end of
+// the handler. The hooks only exist in -DCLOUD_ALLOC_PROFILING=ON builds;
+// otherwise GET /api/allocations reports compiled: false.
+void setup_alloc_routes(DispatchServer &server) {
+    if (alloc_profiling_compiled()) {
+        server.add_pre_routing_hook([](const Request &req, Response &res) {
+            request_allocs_start = thread_alloc_counts();
+            request_allocs_counted = true;
+            return Server::HandlerResponse::Unhandled;
+        });
+        
+        server.add_post_routing_hook([](const Request &req, Response &res) {
+            if (!request_allocs_counted) {
+                return;
+            }
+            request_allocs_counted = false;
+            // Snapshot before building the site name so its allocation is not charged
+            AllocCounts end = thread_alloc_counts();
+            std::string route = req.matched_route.empty() ? "unmatched" : req.matched_route;
+            record_allocations(req.method + " " + route, request_allocs_start, end);
+        });
+    }
+    
+    server.Get("/api/allocations", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value sites(Json::arrayValue);
+        for (const auto& s : alloc_profiles()) {
+            double ops = s.operations > 0 ? static_cast<double>(s.operations) : 1.0;
+            Json::Value site;
+            site["site"] = s.site;
+            site["operations"] = static_cast<Json::UInt64>(s.operations);
+            site["allocs"] = static_cast<Json::UInt64>(s.allocs);
+            site["bytes"] = static_cast<Json::UInt64>(s.bytes);
+            site["frees"] = static_cast<Json::UInt64>(s.frees);
+            site["allocsPerOp"] = s.allocs / ops;
+            site["bytesPerOp"] = s.bytes / ops;
+            site["maxAllocs"] = static_cast<Json::UInt64>(s.max_allocs);
+            site["maxBytes"] = static_cast<Json::UInt64>(s.max_bytes);
+            sites.append(site);
+        }
+        response["compiled"] = alloc_profiling_compiled();
+        response["sites"] = sites;
+        send_json(res, response);
+    });
+    
+    server.Delete("/api/allocations", [](const Request &req, Response &res) {
+        setup_cors(res);
+        reset_alloc_profiles();
+        Json::Value response;
+        response["success"] = true;
+        send_json(res, response);
+    });
+}
+
+// Prometheus metrics: HTTP request instrumentation and the /metrics scrape
+void setup_metrics(DispatchServer &server) {
+    static Gauge& in_flight = metrics_registry.gauge("http_requests_in_flight",
+        "HTTP requests currently being handled");
+    
+    server.add_pre_routing_hook([](const Request &req, Response &res) {
+        request_started = FastClock::now();
+        request_timed = true;
+        in_flight.inc();
+        return Server::HandlerResponse::Unhandled;
+    });
+    
+    server.add_post_routing_hook([](const Request &req, Response &res) {
+        if (!request_timed) {
+            return;
+        }
+        request_timed = false;
+        in_flight.dec();
+        
+        double elapsed = std::chrono::duration<double>(FastClock::now() - request_started).count();
+        
+        // Label by route pattern, not raw path, to keep cardinality bounded.
+        // Each worker resolves a series once; later requests skip the registry.
+        struct HttpSeries { Counter* requests; Histogram* duration; };
+        thread_local std::map<std::tuple<std::string, std::string, int>, HttpSeries, std::less<>> series;
+        static const std::string unmatched = "unmatched";
+        const std::string& route = req.matched_route.empty() ? unmatched : req.matched_route;
+        auto it = series.find(std::make_tuple(std::string_view(req.method), std::string_view(route), res.status));
+        if (it == series.end()) {
+            HttpSeries s;
+            s.requests = &metrics_registry.counter("http_requests_total", "HTTP requests handled",
+                {{"method", req.method}, {"route", route}, {"status", std::to_string(res.status)}});
+            s.duration = &metrics_registry.histogram("http_request_duration_seconds", "HTTP request latency",
+                {{"method", req.method}, {"route", route}});
+            it = series.emplace(std::make_tuple(req.method, route, res.status), s).first;
+        }
+        it->second.requests->inc();
+        it->second.duration->observe(elapsed);
+    });
+    
+    // Scrape-time gauges for state owned by other modules
+    for (int state = NEW; state <= TERMINATED; state++) {
+        static const char* names[] = {"new", "ready", "running", "waiting", "terminated"};
+        metrics_registry.gauge_callback("scheduler_processes", "Processes in the scheduler by state",
+                                        {{"state", names[state]}}, [state]() {
+            auto lock = traced_lock(process_mutex);
+            int count = 0;
+            for (const auto& p : process_scheduler.getProcesses()) {
+                if (p.state == state) count++;
+            }
+            return static_cast<double>(count);
+        });
+    }
+    metrics_registry.gauge_callback("jobs_queued", "Jobs waiting for a job worker", {},
+                                    []() { return static_cast<double>(job_manager.queued()); });
+    metrics_registry.gauge_callback("jobs_running", "Jobs currently executing", {},
+                                    []() { return static_cast<double>(job_manager.running()); });
+    metrics_registry.gauge_callback("admission_in_flight", "Requests holding an admission slot", {},
+                                    []() { return static_cast<double>(admission_controller.in_flight()); });
+    
+    server.Get("/metrics", [](const Request &req, Response &res) {
+        res.set_content(metrics_registry.render(), "text/plain; version=0.0.4; charset=utf-8");
+    });
+}
+
+// Admission control: per-route concurrency limits and load shedding
+void setup_admission_control(DispatchServer &server) {
+    configure_default_admission(admission_controller);
+    
+    server.add_pre_routing_hook([](const Request &req, Response &res) {
+        // CORS preflights are trivial and never shed
+        if (req.method == "OPTIONS") {
+            return Server::HandlerResponse::Unhandled;
+        }
+        
+        std::string route_class = admission_controller.classify(req.path);
+        auto queued_at = FastClock::now();
+        AdmissionDecision decision = admission_controller.acquire(route_class);
+        trace_phase(TracePhase::QUEUE, queued_at);
+        if (decision == AdmissionDecision::ADMITTED || decision == AdmissionDecision::BYPASSED) {
+            admitted_class = route_class;
+            admission_held = true;
+            return Server::HandlerResponse::Unhandled;
+        }
+        
+        setup_cors(res);
+        Json::Value response;
+        response["success"] = false;
+        response["routeClass"] = route_class;
+        if (decision == AdmissionDecision::QUEUE_FULL) {
+            res.status = 429;
+            response["error"] = "Too many concurrent requests for this route";
+        } else if (decision == AdmissionDecision::TIMED_OUT) {
+            res.status = 503;
+            response["error"] = "Request timed out waiting for capacity";
+        } else {
+            res.status = 503;
+            response["error"] = "Server overloaded";
+        }
+        res.set_header("Retry-After", std::to_string(admission_controller.retry_after(route_class)));
+        thread_local std::map<std::pair<std::string, int>, Counter*> shed;
+        Counter*& shed_counter = shed[{route_class, res.status}];
+        if (!shed_counter) {
+            shed_counter = &metrics_registry.counter("http_requests_shed_total", "Requests rejected by admission control",
+                                                     {{"route_class", route_class}, {"status", std::to_string(res.status)}});
+        }
+        shed_counter->inc();
+        
+        send_json(res, response);
+        return Server::HandlerResponse::Handled;
+    });
+    
+    server.add_post_routing_hook([](const Request &req, Response &res) {
+        if (admission_held) {
+            admission_controller.release(admitted_class);
+            admission_held = false;
+        }
+    });
+    
+    // Admission counters for load balancers and dashboards
+    server.Get("/api/admission", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        Json::Value classes(Json::arrayValue);
+        
+        for (const auto& stats : admission_controller.class_stats()) {
+            Json::Value c;
+            c["name"] = stats.name;
+            c["priority"] = stats.priority;
+            c["inFlight"] = static_cast<Json::UInt64>(stats.in_flight);
+            c["waiting"] = static_cast<Json::UInt64>(stats.waiting);
+            c["maxConcurrent"] = static_cast<Json::UInt64>(stats.limit.max_concurrent);
+            c["maxQueue"] = static_cast<Json::UInt64>(stats.limit.max_queue);
+            c["admitted"] = static_cast<Json::UInt64>(stats.admitted);
+            c["queued"] = static_cast<Json::UInt64>(stats.queued);
+            c["rejected"] = static_cast<Json::UInt64>(stats.rejected);
+            c["timedOut"] = static_cast<Json::UInt64>(stats.timed_out);
+            classes.append(c);
+        }
+        
+        Json::Value background(Json::arrayValue);
+        for (const auto& slot : admission_controller.background_stats()) {
+            Json::Value b;
+            b["name"] = slot.name;
+            b["limit"] = static_cast<Json::UInt64>(slot.limit);
+            b["running"] = static_cast<Json::UInt64>(slot.running);
+            b["started"] = static_cast<Json::UInt64>(slot.started);
+            b["rejected"] = static_cast<Json::UInt64>(slot.rejected);
+            background.append(b);
+        }
+        
+        response["inFlight"] = static_cast<Json::UInt64>(admission_controller.in_flight());
+        response["rejectedTotal"] = static_cast<Json::UInt64>(admission_controller.rejected_total());
+        response["classes"] = classes;
+        response["background"] = background;
+        
+        send_json(res, response);
+    });
+}
+
+// Every route and hook of the HTTP API. Hooks are registered first, in the
+// order they must run: allocation counting, tracing, metrics, then admission
+// control.
+void setup_api_routes(DispatchServer &server, double slow_threshold_ms) {
+    // Handle OPTIONS requests for CORS
+    server.Options(".*", [](const Request &req, Response &res) {
+        setup_cors(res);
+        return;
+    });
+    
+    setup_alloc_routes(server);
+    setup_request_tracing(server, slow_threshold_ms);
+    setup_metrics(server);
+    setup_admission_control(server);
+    setup_file_routes(server);
+    setup_stats_routes(server);
+    setup_log_routes(server);
+    setup_binlog_routes(server);
+    setup_lock_routes(server);
+    setup_thread_routes(server);
+    setup_os_routes(server);
+    setup_job_routes(server);
+    
+    // Health check endpoint
+    server.Get("/api/health", [](const Request &req, Response &res) {
+        setup_cors(res);
+        Json::Value response;
+        response["status"] = "healthy";
+        response["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        
+        send_json(res, response);
+    });
+}
@@ -0,0 +1,11 @@
+#ifndef API_ROUTES_H
+#define API_ROUTES_H
+
+#include "event_server.h"
+
+// Registers the whole HTTP API (routes plus the tracing, metrics and
+// admission hooks) on a server. Shared by cloud_server and the in-process
+// mode of tools/loadgen, which drives the same routes without sockets.
+void setup_api_routes(DispatchServer &server, double slow_threshold_ms);
+
+#endif
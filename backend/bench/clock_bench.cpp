@@ -0,0 +1,76 @@
+// Measures the per-call cost of taking timestamps on the logging hot path:
+// monotonic reads for durations and wall-clock strings for log lines, each
+// against the std::chrono / localtime + put_time code it replaces.
+//
+// Usage: clock_bench [--calls=N]
+
+#include "../fast_clock.h"
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Previous getCurrentTimestampMicro(): localtime + put_time + ostringstream
+static std::string timestamp_put_time() {
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    auto tm = *std::localtime(&time_t);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()) % 1000000;
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    oss << "." << std::setfill('0') << std::setw(6) << us.count();
+    return oss.str();
+}
+
+// Keeps the optimizer from discarding results
+static volatile uint64_t sink;
+
+template <typename Fn>
+double ns_per_call(long calls, Fn fn) {
+    auto started = std::chrono::steady_clock::now();
+    for (long i = 0; i < calls; i++) {
+        fn();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / calls;
+}
+
+int main(int argc, char* argv[]) {
+    long calls = 5000000;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--calls=", 8) == 0) calls = std::stol(argv[i] + 8);
+    }
+
+    std::cout << "FastClock source: " << (FastClock::using_tsc() ? "invariant TSC" : "CLOCK_MONOTONIC (vDSO)")
+              << "\n" << std::fixed << std::setprecision(1);
+
+    struct Row { const char* name; double ns; };
+    Row rows[] = {
+        {"FastClock::now", ns_per_call(calls, [] { sink += FastClock::now().time_since_epoch().count(); })},
+        {"steady_clock::now", ns_per_call(calls, [] {
+            sink += std::chrono::steady_clock::now().time_since_epoch().count(); })},
+        {"high_resolution_clock::now", ns_per_call(calls, [] {
+            sink += std::chrono::high_resolution_clock::now().time_since_epoch().count(); })},
+        {"wall_clock_us", ns_per_call(calls, [] { sink += wall_clock_us(); })},
+        {"format_wall_clock (char*)", ns_per_call(calls, [] {
+            char buffer[32];
+            sink += format_wall_clock(wall_clock_us(), true, buffer); })},
+        {"format_wall_clock (string)", ns_per_call(calls, [] {
+            sink += format_wall_clock(wall_clock_us(), true).size(); })},
+        {"localtime + put_time", ns_per_call(calls / 10, [] { sink += timestamp_put_time().size(); })},
+    };
+    for (const Row& row : rows) {
+        std::cout << std::left << std::setw(30) << row.name << std::right << std::setw(9) << row.ns << " ns/call\n";
+    }
+
+    // Durations from both sources must agree
+    auto fast_start = FastClock::now();
+    auto steady_start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - steady_start < std::chrono::milliseconds(200)) {}
+    double fast_ms = std::chrono::duration<double, std::milli>(FastClock::now() - fast_start).count();
+    double steady_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - steady_start).count();
+    std::cout << "200 ms spin: FastClock " << std::setprecision(3) << fast_ms << " ms, steady_clock " << steady_ms << " ms\n";
+    return 0;
+}
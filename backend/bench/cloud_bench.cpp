@@ -0,0 +1,521 @@
+// Google Benchmark microbenchmarks for the server components, each measured
+// in isolation: the reader/writer lock paths, statistics and event logging,
+// the simulated file system, every scheduling algorithm, message queues and
+// deadlock detection.
+//
+// Usage: cloud_bench [--benchmark_filter=REGEX] [--benchmark_out=FILE]
+//
+// Results go to cloud_bench.json (Google Benchmark JSON, with the host and
+// build context) unless --benchmark_out is given, so runs can be kept and
+// compared over time with tools/perf_compare. Each benchmark also reports
+// allocs_per_iter from a counting operator new. Component console output is
+// discarded while measuring.
+
+#include "../cloud.h"
+#include "../deadlock_detector.h"
+#include "../gantt_view.h"
+#include "../file_system.h"
+#include "../ipc_manager.h"
+#include "../process_scheduler.h"
+#include "../process_trace.h"
+#include "../schedule_sweep.h"
+#include "../workload.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// ===== ALLOCATION COUNTING =====
+
+// Global operator new counts while Google Benchmark's memory run is active;
+// the rest of the time the check is one relaxed load
+static std::atomic<bool> counting_allocations{false};
+static std::atomic<int64_t> allocation_count{0};
+static std::atomic<int64_t> allocated_bytes{0};
+
+void* operator new(std::size_t size) {
+    if (counting_allocations.load(std::memory_order_relaxed)) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+// Sized delete forwards to the unsized form so every replaced deallocation
+// goes through the one free() that pairs with the malloc() above; array and
+// nothrow forms forward here, aligned ones keep the library's own pair.
+// GCC inlines these into callers in this file and then flags the free() of
+// an operator new pointer, not seeing that this operator new is malloc().
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+#pragma GCC diagnostic pop
+
+class AllocationCounter : public benchmark::MemoryManager {
+public:
+    void Start() override {
+        allocation_count = 0;
+        allocated_bytes = 0;
+        counting_allocations = true;
+    }
+    void Stop(Result& result) override {
+        counting_allocations = false;
+        result.num_allocs = allocation_count;
+        result.total_allocated_bytes = allocated_bytes;
+    }
+    void Stop(Result* result) override { Stop(*result); }
+};
+
+// Keeps a benchmark's setup out of allocs_per_iter until end(). Google
+// Benchmark's memory run lasts min(16, iterations) iterations, so one-time
+// allocations counted there would make the figure depend on how fast the
+// timing runs were. Scheduler benchmarks also run one warm-up schedule
+// under it so the buffers a run reuses are already grown.
+class UncountedAllocations {
+private:
+    bool saved;
+
+public:
+    UncountedAllocations() : saved(counting_allocations.exchange(false)) {}
+    ~UncountedAllocations() { end(); }
+    void end() {
+        if (saved) counting_allocations = true;
+        saved = false;
+    }
+};
+
+// ===== HELPERS =====
+
+// Swallows std::cout for the lifetime of the guard. The components still
+// format their messages; only the terminal write is skipped. In threaded
+// benchmarks only thread 0 installs it: the timing loop is bracketed by
+// barriers, so every thread's output falls inside its lifetime.
+class QuietCout {
+private:
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+    NullBuffer null_buffer;
+    std::streambuf* saved = nullptr;
+
+public:
+    explicit QuietCout(bool active = true) {
+        if (active) saved = std::cout.rdbuf(&null_buffer);
+    }
+    ~QuietCout() {
+        if (saved) std::cout.rdbuf(saved);
+    }
+};
+
+// Same process set for every run of a given size
+static void add_processes(ProcessScheduler& scheduler, int count) {
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> arrival(0, std::max(10, count / 4));
+    std::uniform_int_distribution<> burst(1, 10);
+    std::uniform_int_distribution<> priority(1, 5);
+    for (int i = 0; i < count; i++) {
+        int pid = scheduler.getNextPid();
+        scheduler.addProcess(Process(pid, arrival(gen), burst(gen), priority(gen)));
+    }
+}
+
+// ===== READER/WRITER LOCKS =====
+
+static void BM_WriterLock(benchmark::State& state) {
+    lock_profiling_enabled = state.range(0) != 0;
+    for (auto _ : state) {
+        rw_mutex.lock();
+        benchmark::ClobberMemory();
+        rw_mutex.unlock();
+    }
+    lock_profiling_enabled = false;
+}
+BENCHMARK(BM_WriterLock)->ArgName("profiling")->Arg(0)->Arg(1)->ThreadRange(1, 4);
+
+// Entry and exit sections of run_read: the first reader takes rw_mutex on
+// behalf of the others, the last one releases it
+static void BM_ReaderLock(benchmark::State& state) {
+    lock_profiling_enabled = state.range(0) != 0;
+    for (auto _ : state) {
+        mutex_readcount.lock();
+        if (++read_count == 1) rw_mutex.lock();
+        mutex_readcount.unlock();
+
+        benchmark::ClobberMemory();
+
+        mutex_readcount.lock();
+        if (--read_count == 0) rw_mutex.unlock();
+        mutex_readcount.unlock();
+    }
+    lock_profiling_enabled = false;
+}
+BENCHMARK(BM_ReaderLock)->ArgName("profiling")->Arg(0)->Arg(1)->ThreadRange(1, 4);
+
+// ===== STATISTICS AND LOGGING =====
+
+static void BM_UpdateStatistics(benchmark::State& state) {
+    OperationTiming timing;
+    timing.operation = "READ";
+    timing.wait_time_us = 120;
+    timing.operation_time_us = 800;
+    timing.total_time_us = 920;
+    for (auto _ : state) {
+        update_statistics("READ", timing);
+    }
+    if (state.thread_index() == 0) reset_statistics();
+}
+BENCHMARK(BM_UpdateStatistics)->ThreadRange(1, 4);
+
+static void BM_LogEvent(benchmark::State& state) {
+    QuietCout quiet(state.thread_index() == 0);
+    if (state.thread_index() == 0) ensure_directories_exist();
+    for (auto _ : state) {
+        log_event(1, "READ", "SUCCESS (size: 4096 bytes)");
+    }
+}
+BENCHMARK(BM_LogEvent)->ThreadRange(1, 4);
+
+// ===== FILE SYSTEM =====
+
+// First-fit allocation with every block but the last in use: the worst case
+// scan over the block bitmap. Filling the disk is itself quadratic, which
+// bounds the size.
+static void BM_FsAllocateBlock(benchmark::State& state) {
+    QuietCout quiet;
+    int total_blocks = static_cast<int>(state.range(0));
+    FileSystem fs(total_blocks);
+    for (int i = 0; i < total_blocks - 1; i++) fs.allocateBlock();
+    for (auto _ : state) {
+        int block = fs.allocateBlock();
+        benchmark::DoNotOptimize(block);
+        fs.freeBlock(block);
+    }
+}
+BENCHMARK(BM_FsAllocateBlock)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+static void BM_FsWriteFile(benchmark::State& state) {
+    QuietCout quiet;
+    FileSystem fs(1 << 16);
+    fs.createFile("/bench.dat");
+    std::string data(static_cast<size_t>(state.range(0)), 'x');
+    for (auto _ : state) {
+        bool ok = fs.writeFile("/bench.dat", data);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FsWriteFile)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+// Lookup of the last file in a directory of N entries
+static void BM_FsFindInode(benchmark::State& state) {
+    QuietCout quiet;
+    int files = static_cast<int>(state.range(0));
+    FileSystem fs(16);
+    for (int i = 0; i < files; i++) fs.createFile("/file" + std::to_string(i));
+    std::string target = "/file" + std::to_string(files - 1);
+    for (auto _ : state) {
+        int inode = fs.findInode(target);
+        benchmark::DoNotOptimize(inode);
+    }
+}
+BENCHMARK(BM_FsFindInode)->RangeMultiplier(10)->Range(10, 10000);
+
+// ===== PROCESS SCHEDULER =====
+
+static void BM_Scheduler(benchmark::State& state, const char* algorithm) {
+    QuietCout quiet;
+    UncountedAllocations setup;
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    add_processes(scheduler, static_cast<int>(state.range(0)));
+    scheduler.executeScheduler(algorithm, 2);
+    setup.end();
+    for (auto _ : state) {
+        scheduler.executeScheduler(algorithm, 2);
+        benchmark::DoNotOptimize(scheduler.getGanttChart().data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// Every algorithm is O(n log n) over the arrival-sorted list, up to 1M processes
+BENCHMARK_CAPTURE(BM_Scheduler, FCFS, "FCFS")->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Scheduler, SJF, "SJF")->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Scheduler, PRIORITY, "PRIORITY")->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Scheduler, RR, "RR")->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Scheduler, SRTF, "SRTF")->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_Scheduler, PRIORITY_P, "PRIORITY_P")->RangeMultiplier(10)->Range(10, 1000000)->Unit(benchmark::kMicrosecond);
+
+// Cost of one scheduling decision (one dispatch) for the policies that
+// dispatch a process many times. items/s is decisions per second.
+static void BM_SchedulerDecision(benchmark::State& state, const char* algorithm) {
+    QuietCout quiet;
+    UncountedAllocations setup;
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    add_processes(scheduler, static_cast<int>(state.range(0)));
+    int64_t decisions = 0;
+    scheduler.executeScheduler(algorithm, 2);
+    setup.end();
+    for (auto _ : state) {
+        scheduler.executeScheduler(algorithm, 2);
+        decisions += static_cast<int64_t>(scheduler.getDispatchCount());
+    }
+    state.SetItemsProcessed(decisions);
+    state.counters["decisions"] = static_cast<double>(scheduler.getDispatchCount());
+}
+
+BENCHMARK_CAPTURE(BM_SchedulerDecision, RR, "RR")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerDecision, SRTF, "SRTF")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerDecision, MLFQ, "MLFQ")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerDecision, CFS, "CFS")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// Event-driven runs where every process alternates three CPU bursts with
+// two requests on one of 4 devices. items/s is CPU and I/O bursts per second.
+static void BM_SchedulerIo(benchmark::State& state, const char* algorithm) {
+    QuietCout quiet;
+    UncountedAllocations setup;
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> arrival(0, std::max(10, static_cast<int>(state.range(0)) / 4));
+    std::uniform_int_distribution<> burst(1, 10);
+    std::uniform_int_distribution<> io_time(5, 20);
+    std::vector<Process> list;
+    for (int i = 0; i < state.range(0); i++) {
+        list.emplace_back(i + 1, arrival(gen), burst(gen), 1 + i % 5);
+        for (int k = 0; k < 2; k++) {
+            list.back().io_bursts.push_back({static_cast<int>(gen() % 4), io_time(gen), burst(gen)});
+        }
+    }
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    scheduler.setProcesses(list);
+    scheduler.executeScheduler(algorithm, 2);
+    setup.end();
+    for (auto _ : state) {
+        scheduler.executeScheduler(algorithm, 2);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 5);
+    state.counters["overlap"] = scheduler.getIoStats().overlap;
+}
+
+BENCHMARK_CAPTURE(BM_SchedulerIo, FCFS, "FCFS")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerIo, RR, "RR")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerIo, SRTF, "SRTF")->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMicrosecond);
+
+// Job-level EDF and RM over `tasks` periodic tasks at a total utilization
+// of 0.9, to a horizon of a million time units. items/s is jobs per second.
+static void BM_SchedulerRealtime(benchmark::State& state, const char* algorithm) {
+    QuietCout quiet;
+    UncountedAllocations setup;
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    RealtimeConfig config;
+    config.horizon = 1000000;
+    scheduler.setRealtimeConfig(config);
+    int tasks = static_cast<int>(state.range(0));
+    const int periods[] = {10, 20, 25, 40, 50, 100};
+    std::vector<Process> list;
+    for (int i = 0; i < tasks; i++) {
+        int period = periods[i % 6] * tasks;
+        list.emplace_back(i + 1, "T" + std::to_string(i + 1), 0, std::max(1, period * 9 / (10 * tasks)), 1);
+        list.back().period = period;
+    }
+    scheduler.setProcesses(list);
+    scheduler.executeScheduler(algorithm, 2);
+    setup.end();
+    for (auto _ : state) {
+        scheduler.executeScheduler(algorithm, 2);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(scheduler.getRealtimeStats().jobs));
+    state.counters["misses"] = static_cast<double>(scheduler.getRealtimeStats().missed);
+}
+
+BENCHMARK_CAPTURE(BM_SchedulerRealtime, EDF, "EDF")->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerRealtime, RM, "RM")->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMicrosecond);
+
+// Per-CPU runqueues with work stealing; args are (processes, cores)
+static void BM_SchedulerMultiCore(benchmark::State& state, const char* algorithm) {
+    QuietCout quiet;
+    UncountedAllocations setup;
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    scheduler.setCores(static_cast<int>(state.range(1)));
+    add_processes(scheduler, static_cast<int>(state.range(0)));
+    int64_t decisions = 0;
+    scheduler.executeScheduler(algorithm, 2);
+    setup.end();
+    for (auto _ : state) {
+        scheduler.executeScheduler(algorithm, 2);
+        decisions += static_cast<int64_t>(scheduler.getDispatchCount());
+    }
+    state.SetItemsProcessed(decisions);
+    state.counters["migrations"] = static_cast<double>(scheduler.getMigrationCount());
+}
+
+BENCHMARK_CAPTURE(BM_SchedulerMultiCore, RR, "RR")->ArgsProduct({{10000, 100000}, {1, 4, 16}})->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SchedulerMultiCore, SRTF, "SRTF")->ArgsProduct({{10000, 100000}, {1, 4, 16}})->Unit(benchmark::kMicrosecond);
+
+// The default what-if sweep (11 configs) over one process set; args are
+// (processes, helper threads besides the caller)
+static void BM_ScheduleSweep(benchmark::State& state) {
+    QuietCout quiet;
+    ProcessScheduler source;
+    add_processes(source, static_cast<int>(state.range(0)));
+    std::vector<SweepConfig> configs = default_sweep_configs();
+    WorkerPool pool(static_cast<size_t>(state.range(1)));
+    for (auto _ : state) {
+        auto results = run_schedule_sweep(source.getProcesses(), configs, MlfqConfig(), CfsConfig(), RealtimeConfig(), pool);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(configs.size()));
+}
+BENCHMARK(BM_ScheduleSweep)->ArgsProduct({{10000, 100000}, {1, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// The whole RR (quantum 1) schedule of `processes` downsampled to 1000 columns
+static void BM_GanttDownsample(benchmark::State& state) {
+    QuietCout quiet;
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    add_processes(scheduler, static_cast<int>(state.range(0)));
+    scheduler.executeScheduler("RR", 1);
+    const auto& chart = scheduler.getGanttChart();
+    for (auto _ : state) {
+        auto view = downsample_gantt(chart, scheduler.getGanttMaxSlice(), 0, scheduler.getGanttMakespan(), 1000);
+        benchmark::DoNotOptimize(view.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(chart.size()));
+}
+BENCHMARK(BM_GanttDownsample)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Parsing a trace of the benchmark process set; args are
+// (processes, format: 0 = CSV, 1 = binary)
+static void BM_ProcessTraceParse(benchmark::State& state) {
+    QuietCout quiet;
+    ProcessScheduler source;
+    add_processes(source, static_cast<int>(state.range(0)));
+    TraceFormat format = state.range(1) ? TraceFormat::BINARY : TraceFormat::CSV;
+    std::string trace;
+    write_process_trace(source.getProcessTable(), format, [&trace](const char* data, size_t size) {
+        trace.append(data, size);
+        return true;
+    });
+    for (auto _ : state) {
+        ProcessTable table;
+        std::string error = parse_process_trace(trace.data(), trace.size(), table);
+        benchmark::DoNotOptimize(error.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(trace.size()));
+}
+BENCHMARK(BM_ProcessTraceParse)->ArgsProduct({{100000, 1000000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// ===== IPC =====
+
+// Send then receive one message while `backlog` messages for another
+// receiver sit ahead of it in the queue
+static void BM_MessageQueueSendReceive(benchmark::State& state) {
+    QuietCout quiet;
+    int backlog = static_cast<int>(state.range(0));
+    MessageQueue queue(backlog + 1);
+    for (int i = 0; i < backlog; i++) queue.sendMessage(Message(1, 2, "queued", i));
+    Message msg(1, 3, "hello", backlog);
+    for (auto _ : state) {
+        queue.sendMessage(msg);
+        Message received = queue.receiveMessage(3);
+        benchmark::DoNotOptimize(received.message_id);
+    }
+}
+BENCHMARK(BM_MessageQueueSendReceive)->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+// ===== DEADLOCK DETECTION =====
+
+// N processes in a ring: each holds one resource and waits for the next
+// process's, so the wait-for graph is one N-cycle (the worst case for the
+// DFS) unless `cycle` is 0, in which case the last process waits on nothing
+static void BM_DetectDeadlock(benchmark::State& state) {
+    QuietCout quiet;
+    int n = static_cast<int>(state.range(0));
+    bool cycle = state.range(1) != 0;
+    DeadlockDetector detector;
+    for (int i = 0; i < n; i++) {
+        detector.addResource(1000 + i, 1, "R" + std::to_string(i));
+        detector.addProcess(i + 1, "P" + std::to_string(i + 1));
+        detector.requestResource(i + 1, 1000 + i, 1);
+    }
+    for (int i = 0; i < n - (cycle ? 0 : 1); i++) {
+        detector.requestResource(i + 1, 1000 + (i + 1) % n, 1);
+    }
+    for (auto _ : state) {
+        bool found = detector.detectDeadlock();
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_DetectDeadlock)->ArgNames({"processes", "cycle"})
+    ->ArgsProduct({{16, 128, 1024, 4096}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// ===== STRESS TEST =====
+
+// A fixed, seeded stress-test workload, so percentiles and throughput can be
+// compared across builds. Each iteration is one full run; repetitions give
+// the samples for perf_compare.
+static void BM_StressWorkload(benchmark::State& state) {
+    QuietCout quiet;
+    ensure_directories_exist();
+    WorkloadConfig config;
+    config.seed = 7;
+    config.operations = static_cast<int>(state.range(0));
+    config.arrival = ArrivalProcess::CLOSED_LOOP;
+    config.concurrency = 8;
+    config.size_distribution = SizeDistribution::FIXED;
+    config.size_bytes = 256;
+
+    StressTestResult result;
+    for (auto _ : state) {
+        result = run_workload(config, nullptr, nullptr);
+    }
+    reset_statistics();
+    state.counters["ops_per_sec"] = result.throughput_ops_per_sec;
+    for (const char* operation : {"READ", "WRITE", "DELETE"}) {
+        std::string prefix = operation;
+        std::transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+        state.counters[prefix + "_p50_us"] = result.latency[operation].p50_us;
+        state.counters[prefix + "_p99_us"] = result.latency[operation].p99_us;
+    }
+}
+BENCHMARK(BM_StressWorkload)->Arg(20)->Iterations(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// ===== MAIN =====
+
+int main(int argc, char* argv[]) {
+    // Default to a JSON result file next to the console report
+    std::vector<char*> args(argv, argv + argc);
+    bool has_out = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0) has_out = true;
+    }
+    std::string out_flag = "--benchmark_out=cloud_bench.json";
+    std::string format_flag = "--benchmark_out_format=json";
+    if (!has_out) {
+        args.push_back(out_flag.data());
+        args.push_back(format_flag.data());
+    }
+    int args_count = static_cast<int>(args.size());
+
+    AllocationCounter allocation_counter;
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) return 1;
+    benchmark::RegisterMemoryManager(&allocation_counter);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::RegisterMemoryManager(nullptr);
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Compares the httplib thread-per-connection front end with the epoll
+// reactor. Both serve the same DispatchServer route while N idle keep-alive
+// connections are held open, then C client threads measure request latency.
+//
+// Usage: frontend_bench [--idle=N] [--clients=C] [--requests=R] [--work-us=W]
+
+#include "../event_server.h"
+#include <httplib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct BenchConfig {
+    int idle_connections = 200;
+    int clients = 8;
+    int requests_per_client = 200;
+    int work_us = 200;
+};
+
+struct BenchResult {
+    std::string frontend;
+    int threads = 0;
+    int ok = 0;
+    int errors = 0;
+    double seconds = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+};
+
+static int process_thread_count() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("Threads:", 0) == 0) {
+            return std::stoi(line.substr(8));
+        }
+    }
+    return -1;
+}
+
+static std::vector<int> open_idle_connections(int port, int count) {
+    std::vector<int> fds;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    for (int i = 0; i < count; i++) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) break;
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            break;
+        }
+        fds.push_back(fd);
+    }
+    return fds;
+}
+
+static void register_routes(DispatchServer& server, int work_us) {
+    server.Get("/api/bench/ping", [work_us](const httplib::Request&, httplib::Response& res) {
+        // Simulated handler compute
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(work_us);
+        while (std::chrono::steady_clock::now() < until) {}
+        res.set_content("{\"status\":\"ok\"}", "application/json");
+    });
+}
+
+static BenchResult drive_clients(const std::string& frontend, int port, const BenchConfig& cfg) {
+    BenchResult result;
+    result.frontend = frontend;
+
+    auto idle = open_idle_connections(port, cfg.idle_connections);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    result.threads = process_thread_count();
+
+    std::vector<std::vector<double>> latencies(cfg.clients);
+    std::vector<int> errors(cfg.clients, 0);
+    std::vector<std::thread> clients;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < cfg.clients; c++) {
+        clients.emplace_back([&, c]() {
+            httplib::Client client("127.0.0.1", port);
+            client.set_keep_alive(true);
+            client.set_connection_timeout(10);
+            client.set_read_timeout(10);
+            for (int i = 0; i < cfg.requests_per_client; i++) {
+                auto t0 = std::chrono::steady_clock::now();
+                auto res = client.Get("/api/bench/ping");
+                auto t1 = std::chrono::steady_clock::now();
+                if (res && res->status == 200) {
+                    latencies[c].push_back(
+                        std::chrono::duration<double, std::micro>(t1 - t0).count());
+                } else {
+                    errors[c]++;
+                }
+            }
+        });
+    }
+    for (auto& t : clients) t.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (int c = 0; c < cfg.clients; c++) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        result.errors += errors[c];
+    }
+    result.ok = static_cast<int>(all.size());
+    std::sort(all.begin(), all.end());
+    if (!all.empty()) {
+        result.p50_us = all[all.size() / 2];
+        result.p99_us = all[std::min(all.size() - 1, all.size() * 99 / 100)];
+    }
+
+    for (int fd : idle) close(fd);
+    return result;
+}
+
+static BenchResult run_httplib(const BenchConfig& cfg) {
+    DispatchServer server;
+    register_routes(server, cfg.work_us);
+    int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&]() { server.listen_after_bind(); });
+    server.wait_until_ready();
+
+    BenchResult result = drive_clients("httplib", port, cfg);
+
+    server.stop();
+    listener.join();
+    return result;
+}
+
+static BenchResult run_epoll(const BenchConfig& cfg) {
+    DispatchServer server;
+    register_routes(server, cfg.work_us);
+    EventServer event_server(server);
+    int port = event_server.bind_to_port("127.0.0.1", 0);
+    std::thread listener([&]() { event_server.listen_after_bind(); });
+
+    BenchResult result = drive_clients("epoll", port, cfg);
+
+    event_server.stop();
+    listener.join();
+    return result;
+}
+
+static void raise_fd_limit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--idle=", 7) == 0) cfg.idle_connections = std::atoi(argv[i] + 7);
+        else if (std::strncmp(argv[i], "--clients=", 10) == 0) cfg.clients = std::atoi(argv[i] + 10);
+        else if (std::strncmp(argv[i], "--requests=", 11) == 0) cfg.requests_per_client = std::atoi(argv[i] + 11);
+        else if (std::strncmp(argv[i], "--work-us=", 10) == 0) cfg.work_us = std::atoi(argv[i] + 10);
+    }
+    raise_fd_limit();
+
+    std::cout << "\n" << std::string(60, '=') << "\n";
+    std::cout << "HTTP FRONT END BENCHMARK\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "Idle connections: " << cfg.idle_connections
+              << " | Clients: " << cfg.clients
+              << " | Requests/client: " << cfg.requests_per_client
+              << " | Handler work: " << cfg.work_us << "us\n\n";
+
+    std::vector<BenchResult> results = {run_httplib(cfg), run_epoll(cfg)};
+
+    std::cout << std::setw(10) << "Frontend" << std::setw(10) << "Threads"
+              << std::setw(10) << "OK" << std::setw(10) << "Errors"
+              << std::setw(12) << "Req/s" << std::setw(12) << "p50(us)"
+              << std::setw(12) << "p99(us)" << "\n";
+    std::cout << std::string(76, '-') << "\n";
+    for (const auto& r : results) {
+        std::cout << std::setw(10) << r.frontend << std::setw(10) << r.threads
+                  << std::setw(10) << r.ok << std::setw(10) << r.errors
+                  << std::setw(12) << std::fixed << std::setprecision(0) << (r.ok / r.seconds)
+                  << std::setw(12) << r.p50_us << std::setw(12) << r.p99_us << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Measures the per-event recording cost of the metrics registry: counter
+// increments and histogram observations, single-threaded and with T threads
+// hitting the same metric.
+//
+// Usage: metrics_bench [--threads=T] [--events=N]
+
+#include "../metrics.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct BenchConfig {
+    int threads = 4;
+    long events = 10000000;
+};
+
+template <typename Fn>
+double ns_per_event(int threads, long events, Fn record) {
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([events, &record]() {
+            for (long i = 0; i < events; i++) {
+                record(i);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    double elapsed_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - started).count();
+    // Wall time per event seen by one thread
+    return elapsed_ns / events;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--threads=", 10) == 0) config.threads = std::stoi(argv[i] + 10);
+        else if (std::strncmp(argv[i], "--events=", 9) == 0) config.events = std::stol(argv[i] + 9);
+    }
+
+    MetricsRegistry registry;
+    Counter& counter = registry.counter("bench_events_total", "Benchmark events");
+    Histogram& histogram = registry.histogram("bench_latency_seconds", "Benchmark latency");
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (int threads : {1, config.threads}) {
+        double c = ns_per_event(threads, config.events, [&counter](long) { counter.inc(); });
+        double h = ns_per_event(threads, config.events, [&histogram](long i) {
+            histogram.observe((i & 1023) * 1e-5);
+        });
+        std::cout << "threads=" << threads
+                  << "  counter.inc " << c << " ns/event"
+                  << "  histogram.observe " << h << " ns/event" << std::endl;
+    }
+
+    if (counter.value() != static_cast<uint64_t>(config.events) * (1 + config.threads)) {
+        std::cerr << "counter mismatch: " << counter.value() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,490 @@
+#include "binary_log.h"
+#include "fast_clock.h"
+#include <algorithm>
+#include <cstring>
+#include <strings.h>
+#include <filesystem>
+#include <limits>
+#ifdef CLOUD_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+BinaryLogWriter binary_log;
+
+static const char SEGMENT_MAGIC[8] = {'C', 'S', 'B', 'L', 'O', 'G', '0', '1'};
+static const uint32_t SEGMENT_VERSION = 1;
+static const size_t FLUSH_BYTES = 64 * 1024;
+static const int64_t FLUSH_INTERVAL_US = 1000000;
+
+#pragma pack(push, 1)
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    int64_t created_us;
+};
+#pragma pack(pop)
+
+static int64_t now_us() {
+    return wall_clock_us();
+}
+
+static uint32_t clamp_us(double us) {
+    if (us <= 0.0) return 0;
+    if (us >= static_cast<double>(std::numeric_limits<uint32_t>::max())) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    return static_cast<uint32_t>(us);
+}
+
+// ===== ENUMS =====
+
+const char* log_op_name(LogOp op) {
+    switch (op) {
+        case LogOp::READ: return "READ";
+        case LogOp::WRITE: return "WRITE";
+        case LogOp::DELETE: return "DELETE";
+        case LogOp::UPLOAD: return "UPLOAD";
+        case LogOp::DOWNLOAD: return "DOWNLOAD";
+        case LogOp::STRESS_TEST: return "STRESS_TEST";
+        case LogOp::SYSTEM: return "SYSTEM";
+        case LogOp::REALTIME: return "REALTIME";
+        case LogOp::OTHER: break;
+    }
+    return "OTHER";
+}
+
+const char* log_status_name(LogStatus status) {
+    switch (status) {
+        case LogStatus::STARTED: return "STARTED";
+        case LogStatus::SUCCESS: return "SUCCESS";
+        case LogStatus::COMPLETED: return "COMPLETED";
+        case LogStatus::ERROR: return "ERROR";
+        case LogStatus::WARNING: return "WARNING";
+        case LogStatus::FALLBACK: return "FALLBACK";
+        case LogStatus::TIMING: return "TIMING";
+        case LogStatus::INFO: break;
+    }
+    return "INFO";
+}
+
+LogOp log_op_from_string(const std::string& action) {
+    for (uint16_t i = 1; i <= static_cast<uint16_t>(LogOp::REALTIME); i++) {
+        if (action == log_op_name(static_cast<LogOp>(i))) return static_cast<LogOp>(i);
+    }
+    return LogOp::OTHER;
+}
+
+LogStatus log_status_from_string(const std::string& status) {
+    for (uint16_t i = 1; i <= static_cast<uint16_t>(LogStatus::TIMING); i++) {
+        const char* name = log_status_name(static_cast<LogStatus>(i));
+        if (strncasecmp(status.c_str(), name, std::strlen(name)) == 0) return static_cast<LogStatus>(i);
+    }
+    return LogStatus::INFO;
+}
+
+template <typename Enum>
+static bool parse_mask(const std::string& names, Enum last, const char* (*name_of)(Enum), uint32_t& mask) {
+    mask = 0;
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(',', start);
+        if (end == std::string::npos) end = names.size();
+        std::string name = names.substr(start, end - start);
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        if (!name.empty()) {
+            bool found = false;
+            for (uint16_t i = 0; i <= static_cast<uint16_t>(last); i++) {
+                if (name == name_of(static_cast<Enum>(i))) {
+                    mask |= 1u << i;
+                    found = true;
+                }
+            }
+            if (!found) return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+bool parse_log_op_mask(const std::string& names, uint32_t& mask) {
+    return parse_mask(names, LogOp::REALTIME, log_op_name, mask);
+}
+
+bool parse_log_status_mask(const std::string& names, uint32_t& mask) {
+    return parse_mask(names, LogStatus::TIMING, log_status_name, mask);
+}
+
+// ===== WRITER =====
+
+static std::string segment_path(const std::string& dir, uint64_t id) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "events-%08llu.clog", static_cast<unsigned long long>(id));
+    return (fs::path(dir) / name).string();
+}
+
+#ifdef CLOUD_HAVE_ZLIB
+// Writes <path>.gz through a temporary name, then removes the raw segment
+static void compress_segment(const std::string& path) {
+    std::string tmp_path = path + ".gz.tmp";
+    FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) return;
+    gzFile out = gzopen(tmp_path.c_str(), "wb1");
+    if (!out) {
+        std::fclose(in);
+        return;
+    }
+    std::vector<char> chunk(256 * 1024);
+    bool ok = true;
+    size_t n;
+    while ((n = std::fread(chunk.data(), 1, chunk.size(), in)) > 0) {
+        if (gzwrite(out, chunk.data(), static_cast<unsigned>(n)) != static_cast<int>(n)) {
+            ok = false;
+            break;
+        }
+    }
+    std::fclose(in);
+    ok = gzclose(out) == Z_OK && ok;
+
+    std::error_code ec;
+    if (ok) {
+        fs::rename(tmp_path, path + ".gz", ec);
+        if (!ec) fs::remove(path, ec);
+    } else {
+        fs::remove(tmp_path, ec);
+    }
+}
+#endif
+
+BinaryLogWriter::BinaryLogWriter(const std::string& dir, size_t segment_bytes,
+                                 int64_t segment_age_sec, size_t segments)
+    : directory(dir), max_segment_bytes(segment_bytes),
+      max_segment_age_us(segment_age_sec * 1000000), max_segments(std::max<size_t>(1, segments)),
+      file(nullptr), current_id(0), current_bytes(0), current_created_us(0), last_flush_us(0),
+      records_written(0), compressing_id(0), opened(false) {}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    close();
+}
+
+void BinaryLogWriter::ensure_open() {
+    if (opened) return;
+    opened = true;
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    for (const auto& segment : list_binary_log_segments(directory)) {
+        current_id = std::max(current_id, segment.id);
+    }
+    open_segment(now_us());
+}
+
+void BinaryLogWriter::open_segment(int64_t now) {
+    current_id++;
+    current_path = segment_path(directory, current_id);
+    file = std::fopen(current_path.c_str(), "wb");
+    current_created_us = now;
+    last_flush_us = now;
+    current_bytes = 0;
+    interned.clear();
+    if (!file) return;
+
+    SegmentHeader header;
+    std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(header.magic));
+    header.version = SEGMENT_VERSION;
+    header.record_size = sizeof(BinaryLogRecord);
+    header.created_us = now;
+    buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void BinaryLogWriter::flush_buffer() {
+    if (file && !buffer.empty()) {
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+        std::fflush(file);
+        current_bytes += buffer.size();
+    }
+    buffer.clear();
+}
+
+void BinaryLogWriter::close_segment() {
+    if (!file) return;
+    flush_buffer();
+    std::fclose(file);
+    file = nullptr;
+
+#ifdef CLOUD_HAVE_ZLIB
+    // One background compression at a time; closed segments are immutable
+    if (compressor.joinable()) compressor.join();
+    compressing_id = current_id;
+    compressor = std::thread(compress_segment, current_path);
+#endif
+    prune_segments();
+}
+
+void BinaryLogWriter::prune_segments() {
+    std::vector<BinaryLogSegment> segments = list_binary_log_segments(directory);
+    std::error_code ec;
+    for (size_t i = 0; i + max_segments < segments.size(); i++) {
+        // The compressor renames its segment to .gz when done; removing the
+        // raw file underneath it would leave an orphaned .gz behind
+        if (segments[i].id == current_id || segments[i].id == compressing_id) continue;
+        fs::remove(segments[i].path, ec);
+    }
+}
+
+uint32_t BinaryLogWriter::intern(const std::string& message) {
+    auto it = interned.find(message);
+    if (it != interned.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(interned.size() + 1);
+    interned.emplace(message, id);
+    uint16_t length = static_cast<uint16_t>(std::min<size_t>(message.size(), 0xFFFF));
+    buffer.push_back('S');
+    buffer.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    buffer.append(message.data(), length);
+    return id;
+}
+
+void BinaryLogWriter::append(LogOp op, LogStatus status, int thread_id, const std::string& message,
+                             double wait_us, double operation_us, double total_us) {
+    std::lock_guard<std::mutex> lock(mtx);
+    ensure_open();
+    int64_t now = now_us();
+
+    // Rotate on size, age, or a full per-segment dictionary
+    if (current_bytes + buffer.size() >= max_segment_bytes ||
+        now - current_created_us >= max_segment_age_us || interned.size() >= 65535) {
+        close_segment();
+        open_segment(now);
+    }
+
+    BinaryLogRecord record;
+    record.timestamp_us = now;
+    record.thread_id = static_cast<uint32_t>(thread_id);
+    record.op = static_cast<uint16_t>(op);
+    record.status = static_cast<uint16_t>(status);
+    record.message_id = message.empty() ? 0 : intern(message);
+    record.wait_us = clamp_us(wait_us);
+    record.operation_us = clamp_us(operation_us);
+    record.total_us = clamp_us(total_us);
+    buffer.push_back('R');
+    buffer.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    records_written++;
+
+    if (buffer.size() >= FLUSH_BYTES || now - last_flush_us >= FLUSH_INTERVAL_US) {
+        flush_buffer();
+        last_flush_us = now;
+    }
+}
+
+void BinaryLogWriter::flush() {
+    std::lock_guard<std::mutex> lock(mtx);
+    flush_buffer();
+    last_flush_us = now_us();
+}
+
+void BinaryLogWriter::rotate() {
+    std::lock_guard<std::mutex> lock(mtx);
+    ensure_open();
+    close_segment();
+    open_segment(now_us());
+}
+
+void BinaryLogWriter::close() {
+    std::lock_guard<std::mutex> lock(mtx);
+    flush_buffer();
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    if (compressor.joinable()) compressor.join();
+}
+
+// ===== READER =====
+
+namespace {
+
+// Reads raw or gzip segments through one interface
+class SegmentInput {
+private:
+#ifdef CLOUD_HAVE_ZLIB
+    gzFile in;
+#else
+    FILE* in;
+#endif
+
+public:
+    explicit SegmentInput(const std::string& path) {
+#ifdef CLOUD_HAVE_ZLIB
+        in = gzopen(path.c_str(), "rb");
+        if (in) gzbuffer(in, 256 * 1024);
+#else
+        in = std::fopen(path.c_str(), "rb");
+#endif
+    }
+    ~SegmentInput() {
+#ifdef CLOUD_HAVE_ZLIB
+        if (in) gzclose(in);
+#else
+        if (in) std::fclose(in);
+#endif
+    }
+    bool ok() const { return in != nullptr; }
+    size_t read(char* out, size_t n) {
+#ifdef CLOUD_HAVE_ZLIB
+        int got = gzread(in, out, static_cast<unsigned>(n));
+        return got > 0 ? static_cast<size_t>(got) : 0;
+#else
+        return std::fread(out, 1, n, in);
+#endif
+    }
+};
+
+} // namespace
+
+std::vector<BinaryLogSegment> list_binary_log_segments(const std::string& dir) {
+    std::map<uint64_t, BinaryLogSegment> by_id;
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(dir, ec)) {
+        std::string name = file.path().filename().string();
+        unsigned long long id = 0;
+        char ext[16] = {0};
+        if (std::sscanf(name.c_str(), "events-%llu.%15s", &id, ext) != 2) continue;
+        bool compressed = std::strcmp(ext, "clog.gz") == 0;
+        if (!compressed && std::strcmp(ext, "clog") != 0) continue;
+
+        // A raw segment wins over its .gz while compression is finishing
+        auto it = by_id.find(id);
+        if (it != by_id.end() && !it->second.compressed) continue;
+
+        BinaryLogSegment segment;
+        segment.path = file.path().string();
+        segment.id = id;
+        segment.compressed = compressed;
+        segment.bytes = file.file_size(ec);
+        by_id[id] = segment;
+    }
+
+    std::vector<BinaryLogSegment> segments;
+    for (auto& [id, segment] : by_id) {
+        SegmentInput in(segment.path);
+        SegmentHeader header;
+        if (in.ok() && in.read(reinterpret_cast<char*>(&header), sizeof(header)) == sizeof(header)) {
+            segment.created_us = header.created_us;
+        }
+        segments.push_back(segment);
+    }
+    return segments;
+}
+
+bool read_binary_log_segment(const std::string& path,
+                             const std::function<bool(const DecodedLogRecord&)>& callback) {
+    SegmentInput in(path);
+    if (!in.ok()) return false;
+
+    SegmentHeader header;
+    if (in.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header) ||
+        std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.record_size != sizeof(BinaryLogRecord)) {
+        return false;
+    }
+
+    std::vector<std::string> messages(1);   // id 0 = no message
+    std::vector<char> chunk(1024 * 1024);
+    size_t have = 0;
+    size_t got;
+    while ((got = in.read(chunk.data() + have, chunk.size() - have)) > 0) {
+        have += got;
+        size_t pos = 0;
+        while (pos < have) {
+            char tag = chunk[pos];
+            if (tag == 'R') {
+                if (have - pos < 1 + sizeof(BinaryLogRecord)) break;
+                DecodedLogRecord decoded;
+                std::memcpy(&decoded.record, chunk.data() + pos + 1, sizeof(BinaryLogRecord));
+                uint32_t id = decoded.record.message_id;
+                decoded.message = id < messages.size() ? &messages[id] : &messages[0];
+                pos += 1 + sizeof(BinaryLogRecord);
+                if (!callback(decoded)) return true;
+            } else if (tag == 'S') {
+                const size_t fixed = 1 + sizeof(uint32_t) + sizeof(uint16_t);
+                if (have - pos < fixed) break;
+                uint32_t id;
+                uint16_t length;
+                std::memcpy(&id, chunk.data() + pos + 1, sizeof(id));
+                std::memcpy(&length, chunk.data() + pos + 1 + sizeof(id), sizeof(length));
+                if (have - pos < fixed + length) break;
+                if (messages.size() <= id) messages.resize(id + 1);
+                messages[id].assign(chunk.data() + pos + fixed, length);
+                pos += fixed + length;
+            } else {
+                return false;   // corrupt frame
+            }
+        }
+        // Keep a partial frame for the next read
+        std::memmove(chunk.data(), chunk.data() + pos, have - pos);
+        have -= pos;
+    }
+    return true;
+}
+
+bool BinaryLogFilter::matches(const BinaryLogRecord& r, const std::string* message) const {
+    if (r.timestamp_us < from_us || r.timestamp_us > to_us) return false;
+    if (op_mask && !(op_mask & (1u << r.op))) return false;
+    if (status_mask && !(status_mask & (1u << r.status))) return false;
+    if (thread_id >= 0 && r.thread_id != static_cast<uint32_t>(thread_id)) return false;
+    if (!contains.empty() && (!message || message->find(contains) == std::string::npos)) return false;
+    return true;
+}
+
+uint64_t scan_binary_log(const std::string& dir, const BinaryLogFilter& filter,
+                         const std::function<bool(const DecodedLogRecord&)>& callback) {
+    std::vector<BinaryLogSegment> segments = list_binary_log_segments(dir);
+    uint64_t scanned = 0;
+    bool stopped = false;
+    for (size_t i = 0; i < segments.size() && !stopped; i++) {
+        // A segment covers [created, next segment's created)
+        if (segments[i].created_us > filter.to_us) break;
+        if (i + 1 < segments.size() && segments[i + 1].created_us < filter.from_us) continue;
+
+        read_binary_log_segment(segments[i].path, [&](const DecodedLogRecord& decoded) {
+            scanned++;
+            // Records are appended in time order
+            if (decoded.record.timestamp_us > filter.to_us) {
+                stopped = true;
+                return false;
+            }
+            if (!filter.matches(decoded.record, decoded.message)) return true;
+            if (!callback(decoded)) {
+                stopped = true;
+                return false;
+            }
+            return true;
+        });
+    }
+    return scanned;
+}
+
+BinaryLogAggregate aggregate_binary_log(const std::string& dir, const BinaryLogFilter& filter) {
+    BinaryLogAggregate aggregate;
+    aggregate.scanned = scan_binary_log(dir, filter, [&aggregate](const DecodedLogRecord& decoded) {
+        const BinaryLogRecord& r = decoded.record;
+        if (aggregate.matched == 0) aggregate.first_us = r.timestamp_us;
+        aggregate.matched++;
+        aggregate.last_us = r.timestamp_us;
+
+        BinaryLogOpSummary& op = aggregate.by_op[log_op_name(static_cast<LogOp>(r.op))];
+        op.count++;
+        op.by_status[log_status_name(static_cast<LogStatus>(r.status))]++;
+        if (r.total_us > 0) {
+            op.timed++;
+            op.total_us_sum += r.total_us;
+            op.wait_us_sum += r.wait_us;
+            op.total_us_max = std::max(op.total_us_max, r.total_us);
+        }
+        return true;
+    });
+    return aggregate;
+}
@@ -0,0 +1,156 @@
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Structured event log. A segment file is an 8-byte magic, a header and a
+// stream of frames in host (little-endian) byte order:
+//   'S' u32 id, u16 length, bytes     - interns a message for this segment
+//   'R' BinaryLogRecord                - one event
+// Message ids are local to a segment so each segment decodes on its own.
+// Closed segments are gzip-compressed when zlib is available.
+
+enum class LogOp : uint16_t {
+    OTHER = 0, READ, WRITE, DELETE, UPLOAD, DOWNLOAD, STRESS_TEST, SYSTEM, REALTIME
+};
+
+enum class LogStatus : uint16_t {
+    INFO = 0, STARTED, SUCCESS, COMPLETED, ERROR, WARNING, FALLBACK, TIMING
+};
+
+const char* log_op_name(LogOp op);
+const char* log_status_name(LogStatus status);
+LogOp log_op_from_string(const std::string& action);
+// Classifies free-form status text by its leading keyword
+LogStatus log_status_from_string(const std::string& status);
+
+#pragma pack(push, 1)
+struct BinaryLogRecord {
+    int64_t timestamp_us;
+    uint32_t thread_id;
+    uint16_t op;
+    uint16_t status;
+    uint32_t message_id;      // 0 = no message
+    uint32_t wait_us;
+    uint32_t operation_us;
+    uint32_t total_us;
+};
+#pragma pack(pop)
+static_assert(sizeof(BinaryLogRecord) == 32, "record layout is part of the file format");
+
+struct DecodedLogRecord {
+    BinaryLogRecord record;
+    const std::string* message;   // valid during the reader callback only
+};
+
+struct BinaryLogSegment {
+    std::string path;
+    uint64_t id = 0;
+    int64_t created_us = 0;
+    uint64_t bytes = 0;
+    bool compressed = false;
+};
+
+class BinaryLogWriter {
+private:
+    std::string directory;
+    size_t max_segment_bytes;
+    int64_t max_segment_age_us;
+    size_t max_segments;
+
+    FILE* file;
+    std::string current_path;
+    uint64_t current_id;
+    uint64_t current_bytes;
+    int64_t current_created_us;
+    int64_t last_flush_us;
+    std::string buffer;
+    std::unordered_map<std::string, uint32_t> interned;
+    uint64_t records_written;
+    std::thread compressor;
+    uint64_t compressing_id;      // segment the compressor owns, 0 when idle
+    bool opened;
+    std::mutex mtx;
+
+    void ensure_open();
+    void open_segment(int64_t now_us);
+    void close_segment();
+    void flush_buffer();
+    uint32_t intern(const std::string& message);
+    void prune_segments();
+
+public:
+    BinaryLogWriter(const std::string& dir = "./logs/binlog",
+                    size_t segment_bytes = 8 * 1024 * 1024,
+                    int64_t segment_age_sec = 3600, size_t segments = 64);
+    ~BinaryLogWriter();
+
+    void append(LogOp op, LogStatus status, int thread_id, const std::string& message,
+                double wait_us = 0.0, double operation_us = 0.0, double total_us = 0.0);
+    void flush();
+    // Closes the active segment and starts a new one
+    void rotate();
+    void close();
+
+    uint64_t written() const { return records_written; }
+    const std::string& dir() const { return directory; }
+};
+
+struct BinaryLogFilter {
+    int64_t from_us = 0;
+    int64_t to_us = INT64_MAX;
+    uint32_t op_mask = 0;         // bit per LogOp, 0 = all
+    uint32_t status_mask = 0;     // bit per LogStatus, 0 = all
+    int64_t thread_id = -1;
+    std::string contains;         // message substring
+
+    bool matches(const BinaryLogRecord& r, const std::string* message) const;
+};
+
+// Comma-separated names ("READ,WRITE") to a filter mask; false on an unknown name
+bool parse_log_op_mask(const std::string& names, uint32_t& mask);
+bool parse_log_status_mask(const std::string& names, uint32_t& mask);
+
+struct BinaryLogOpSummary {
+    uint64_t count = 0;
+    std::map<std::string, uint64_t> by_status;
+    double total_us_sum = 0.0;
+    double wait_us_sum = 0.0;
+    uint32_t total_us_max = 0;
+    uint64_t timed = 0;           // records carrying durations
+};
+
+struct BinaryLogAggregate {
+    uint64_t scanned = 0;
+    uint64_t matched = 0;
+    int64_t first_us = 0;
+    int64_t last_us = 0;
+    std::map<std::string, BinaryLogOpSummary> by_op;
+};
+
+// Segments in a log directory, oldest first
+std::vector<BinaryLogSegment> list_binary_log_segments(const std::string& dir);
+
+// Streams every record of a segment; the callback returns false to stop.
+// Returns false when the file cannot be read or is not a log segment.
+bool read_binary_log_segment(const std::string& path,
+                             const std::function<bool(const DecodedLogRecord&)>& callback);
+
+// Streams matching records across a directory, skipping whole segments
+// outside the time range. Returns the number of records scanned.
+uint64_t scan_binary_log(const std::string& dir, const BinaryLogFilter& filter,
+                         const std::function<bool(const DecodedLogRecord&)>& callback);
+
+BinaryLogAggregate aggregate_binary_log(const std::string& dir, const BinaryLogFilter& filter);
+
+extern BinaryLogWriter binary_log;
+
+#endif
@@ -1,19 +1,25 @@
 #ifndef CLOUD_H
 #define CLOUD_H
 
+#include "fast_clock.h"
+#include "lock_profiler.h"
 #include <climits>
 #include <string>
 #include <pthread.h>
 #include <chrono>
 #include <vector>
 #include <map>
+#include <atomic>
+#include <functional>
+#include <memory>
 
-// Timing structure for microsecond precision
+// Timing structure for microsecond precision (FastClock: TSC or vDSO reads)
 struct OperationTiming {
-    std::chrono::high_resolution_clock::time_point start_time;
-    std::chrono::high_resolution_clock::time_point lock_acquired_time;
-    std::chrono::high_resolution_clock::time_point operation_complete_time;
-    std::chrono::high_resolution_clock::time_point end_time;
+    const char* operation = "";   // "READ", "WRITE" or "DELETE"
+    FastClock::time_point start_time;
+    FastClock::time_point lock_acquired_time;
+    FastClock::time_point operation_complete_time;
+    FastClock::time_point end_time;
     
     // Calculated durations in microseconds
     long long wait_time_us = 0;
@@ -54,12 +60,44 @@ struct OperationStats {
     double get_avg_total_time() const { return count > 0 ? (double)total_time_us / count : 0.0; }
 };
 
+// Latency distribution of one operation type within a stress test run
+struct LatencySummary {
+    int count = 0;
+    double avg_wait_us = 0.0;
+    double avg_total_us = 0.0;
+    double p50_us = 0.0;
+    double p95_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+};
+
+// Outcome of a stress test, retrievable after the run finishes
+struct StressTestResult {
+    int requested_threads = 0;
+    int launched_threads = 0;
+    int readers = 0;
+    int writers = 0;
+    int deleters = 0;
+    bool cancelled = false;
+    double duration_ms = 0.0;
+    double throughput_ops_per_sec = 0.0;
+    std::map<std::string, LatencySummary> latency;
+    
+    // Workload that produced the run (see workload.h)
+    uint64_t seed = 0;
+    std::string arrival = "burst";
+    int warmup_operations = 0;
+    uint64_t plan_digest = 0;
+    double avg_start_lag_ms = 0.0;    // open loop: actual minus scheduled start
+    double max_start_lag_ms = 0.0;
+};
+
 // Global variables
 extern std::string cloudData;
-extern pthread_mutex_t rw_mutex;
-extern pthread_mutex_t mutex_readcount;
-extern pthread_mutex_t log_mutex;
-extern pthread_mutex_t stats_mutex;
+extern ProfiledMutex rw_mutex;
+extern ProfiledMutex mutex_readcount;
+extern ProfiledMutex log_mutex;
+extern ProfiledMutex stats_mutex;
 extern int read_count;
 
 // Global statistics
@@ -80,6 +118,12 @@ void* reader(void* arg);
 void* writer(void* arg);
 void* deleter(void* arg);
 
+// Single operations; the thread functions above wrap these. run_write uploads
+// test_file, or payload when given (test_file then only labels the source).
+OperationTiming run_read(int id);
+OperationTiming run_write(int id, const std::string& test_file, const std::string* payload = nullptr);
+OperationTiming run_delete(int id);
+
 // File operation functions
 void uploadFile(const std::string& filename);
 void downloadFile(const std::string& filename);
@@ -101,6 +145,7 @@ void cleanup_timing_system();
 
 // Utility functions
 std::string getRandomTestFile();
+std::shared_ptr<const std::vector<std::string>> get_test_files();
 std::string getCurrentTimestamp();
 std::string getCurrentTimestampMicro();
 void ensure_directories_exist();
@@ -108,10 +153,16 @@ void show_directory_structure();
 
 // Stress test function
 void run_stress_test(int num_threads);
+StressTestResult run_stress_test(int num_threads,
+                                 const std::function<void(int, int)>& on_progress,
+                                 const std::atomic<bool>* cancel_requested);
+LatencySummary summarize_latencies(std::vector<OperationTiming>::const_iterator begin,
+                                   std::vector<OperationTiming>::const_iterator end,
+                                   const std::string& operation);
 
 // Advanced timing utilities
-std::chrono::high_resolution_clock::time_point get_current_time();
-long long get_microseconds_since(const std::chrono::high_resolution_clock::time_point& start);
+FastClock::time_point get_current_time();
+long long get_microseconds_since(const FastClock::time_point& start);
 
 
 void run_cloud_simulator();
@@ -1,5 +1,7 @@
 
 #include "cloud.h"
+#include "alloc_profiler.h"
+#include "event_trace.h"
 #include <iostream>
 #include <unistd.h>
 #include <fstream>
@@ -9,24 +11,26 @@
 #include <chrono>
 #include <cerrno> 
 // Enhanced Reader with microsecond-precision timing
-void* reader(void* arg) {
-    int id = *((int*)arg);
+OperationTiming run_read(int id) {
+    AllocScope alloc_scope("reader");
     OperationTiming timing;
     timing.start_time = get_current_time();
+    set_trace_thread_name("READER#" + std::to_string(id));
     update_operation_stats("READ", 0, true);
     log_event(id, "READ", "STARTED");
     log_real_time_status("Reader #" + std::to_string(id) + " attempting to acquire read lock");
 
-    pthread_mutex_lock(&mutex_readcount);
+    mutex_readcount.lock();
     read_count++;
     if (read_count == 1) { // first reader blocks writers
-        pthread_mutex_lock(&rw_mutex);
+        rw_mutex.lock();
         log_real_time_status("Reader #" + std::to_string(id) + " acquired exclusive access (first reader)");
 
     }
 
-    pthread_mutex_unlock(&mutex_readcount);
+    mutex_readcount.unlock();
     timing.lock_acquired_time = get_current_time();
+    trace_event(TraceCategory::LOCK, "read_lock_wait", timing.start_time, timing.lock_acquired_time, id);
 
     log_real_time_status("Reader #" + std::to_string(id) + " lock acquired after " + 
 
@@ -69,6 +73,7 @@ void* reader(void* arg) {
   timing.operation_complete_time = get_current_time();
 
   // Write to download file with enhanced error handling
+   auto io_started = FastClock::now();
    std::ofstream out(download_filename);
     if (out) {
         // Write metadata header
@@ -80,6 +85,7 @@ void* reader(void* arg) {
         out << "================================\n\n";
         out << content;
         out.close();
+        trace_event(TraceCategory::IO, "download_write", io_started, FastClock::now(), id);
 
         
 
@@ -115,19 +121,21 @@ void* reader(void* arg) {
 
     // Release read lock
 
-    pthread_mutex_lock(&mutex_readcount);
+    mutex_readcount.lock();
 
     read_count--;
 
     if (read_count == 0) { // last reader unblocks writers
 
-        pthread_mutex_unlock(&rw_mutex);
+        rw_mutex.unlock();
 
         log_real_time_status("Reader #" + std::to_string(id) + " released exclusive access (last reader)");
 
     }
 
-    pthread_mutex_unlock(&mutex_readcount);
+    mutex_readcount.unlock();
+    trace_event(TraceCategory::CRITICAL, "read_critical_section", timing.lock_acquired_time, FastClock::now(), id);
+    trace_event(TraceCategory::OP, "READ", timing.start_time, timing.end_time, id);
 
     
 
@@ -135,6 +143,7 @@ void* reader(void* arg) {
 
     log_timing_event(id, "READ", timing);
 
+    timing.operation = "READ";
     update_statistics("READ", timing);
 
     update_operation_stats("READ", timing.total_time_us, false);
@@ -143,21 +152,20 @@ void* reader(void* arg) {
 
     log_event(id, "READ", "COMPLETED (total time: " + std::to_string(timing.total_time_us) + "μs)");
 
-    return nullptr;
-
+    return timing;
 }
 
 
 
 // Enhanced Writer with microsecond-precision timing and real file operations
 
-void* writer(void* arg) {
-
-    int id = *((int*)arg);
+OperationTiming run_write(int id, const std::string& test_file, const std::string* payload) {
+    AllocScope alloc_scope("writer");
 
     OperationTiming timing;
 
     timing.start_time = get_current_time();
+    set_trace_thread_name("WRITER#" + std::to_string(id));
 
     update_operation_stats("WRITE", 0, true);
 
@@ -169,11 +177,12 @@ void* writer(void* arg) {
 
     
 
-    pthread_mutex_lock(&rw_mutex);
+    rw_mutex.lock();
 
     timing.lock_acquired_time = get_current_time();
 
     timing.wait_time_us = get_microseconds_since(timing.start_time);
+    trace_event(TraceCategory::LOCK, "write_lock_wait", timing.start_time, timing.lock_acquired_time, id);
 
     
 
@@ -185,27 +194,28 @@ void* writer(void* arg) {
 
     size_t prev_size = cloudData.size();
 
-    std::string test_file = getRandomTestFile();
-
-    
-
     std::cout << "[Writer " << id << "] uploading from '" << test_file 
 
               << "'... (prev size: " << prev_size << ") [Wait: " << timing.wait_time_us << "μs]\n";
 
     
 
-    // Read from test file with enhanced error handling
-
-    std::ifstream in(test_file);
-
-    if (in) {
-
-        std::string content((std::istreambuf_iterator<char>(in)),
-
-                           std::istreambuf_iterator<char>());
+    // Read from test file (or take the caller's payload) with enhanced error handling
+    std::string content;
+    bool loaded = payload != nullptr;
+    if (payload) {
+        content = *payload;
+    } else {
+        auto io_started = FastClock::now();
+        std::ifstream in(test_file);
+        if (in) {
+            content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            loaded = true;
+            trace_event(TraceCategory::IO, "upload_read", io_started, FastClock::now(), id);
+        }
+    }
 
-        in.close();
+    if (loaded) {
 
         
 
@@ -313,7 +323,9 @@ void* writer(void* arg) {
 
     
 
-    pthread_mutex_unlock(&rw_mutex);
+    rw_mutex.unlock();
+    trace_event(TraceCategory::CRITICAL, "write_critical_section", timing.lock_acquired_time, FastClock::now(), id);
+    trace_event(TraceCategory::OP, "WRITE", timing.start_time, timing.end_time, id);
 
     log_real_time_status("Writer #" + std::to_string(id) + " released exclusive access");
 
@@ -323,6 +335,7 @@ void* writer(void* arg) {
 
     log_timing_event(id, "WRITE", timing);
 
+    timing.operation = "WRITE";
     update_statistics("WRITE", timing);
 
     update_operation_stats("WRITE", timing.total_time_us, false);
@@ -331,21 +344,20 @@ void* writer(void* arg) {
 
     log_event(id, "WRITE", "COMPLETED (total time: " + std::to_string(timing.total_time_us) + "μs)");
 
-    return nullptr;
-
+    return timing;
 }
 
 
 
 // Enhanced Deleter with microsecond-precision timing and backup functionality
 
-void* deleter(void* arg) {
-
-    int id = *((int*)arg);
+OperationTiming run_delete(int id) {
+    AllocScope alloc_scope("deleter");
 
     OperationTiming timing;
 
     timing.start_time = get_current_time();
+    set_trace_thread_name("DELETER#" + std::to_string(id));
 
     update_operation_stats("DELETE", 0, true);
 
@@ -357,11 +369,12 @@ void* deleter(void* arg) {
 
     
 
-    pthread_mutex_lock(&rw_mutex);
+    rw_mutex.lock();
 
     timing.lock_acquired_time = get_current_time();
 
     timing.wait_time_us = get_microseconds_since(timing.start_time);
+    trace_event(TraceCategory::LOCK, "delete_lock_wait", timing.start_time, timing.lock_acquired_time, id);
 
     
 
@@ -393,6 +406,7 @@ void* deleter(void* arg) {
 
         
 
+        auto io_started = FastClock::now();
         std::ofstream backup(backup_filename);
 
         if (backup) {
@@ -410,6 +424,7 @@ void* deleter(void* arg) {
             backup << cloudData;
 
             backup.close();
+            trace_event(TraceCategory::IO, "backup_write", io_started, FastClock::now(), id);
 
             
 
@@ -447,7 +462,9 @@ void* deleter(void* arg) {
 
     
 
-    pthread_mutex_unlock(&rw_mutex);
+    rw_mutex.unlock();
+    trace_event(TraceCategory::CRITICAL, "delete_critical_section", timing.lock_acquired_time, FastClock::now(), id);
+    trace_event(TraceCategory::OP, "DELETE", timing.start_time, timing.end_time, id);
 
     log_real_time_status("Deleter #" + std::to_string(id) + " released exclusive access");
 
@@ -461,6 +478,7 @@ void* deleter(void* arg) {
 
     log_timing_event(id, "DELETE", timing);
 
+    timing.operation = "DELETE";
     update_statistics("DELETE", timing);
 
     update_operation_stats("DELETE", timing.total_time_us, false);
@@ -469,6 +487,21 @@ void* deleter(void* arg) {
 
     log_event(id, "DELETE", "COMPLETED (total time: " + std::to_string(timing.total_time_us) + "μs)");
 
+    return timing;
+}
+
+void* reader(void* arg) {
+    run_read(*((int*)arg));
     return nullptr;
+}
 
-}
\ No newline at end of file
+void* writer(void* arg) {
+    // Pick the source file before taking the lock
+    run_write(*((int*)arg), getRandomTestFile());
+    return nullptr;
+}
+
+void* deleter(void* arg) {
+    run_delete(*((int*)arg));
+    return nullptr;
+}
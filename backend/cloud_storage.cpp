@@ -1,4 +1,9 @@
 #include "cloud.h"
+#include "metrics.h"
+#include "log_store.h"
+#include "binary_log.h"
+#include "workload.h"
+#include "alloc_profiler.h"
 #include <iomanip>
 #include <iostream>
 #include <fstream>
@@ -9,16 +14,21 @@
 #include <ctime>
 #include <sstream>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
 
 // Existing global definitions
 std::string cloudData = "InitialFile";
-pthread_mutex_t rw_mutex = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t mutex_readcount = PTHREAD_MUTEX_INITIALIZER;
-pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
+ProfiledMutex rw_mutex("rw_mutex");
+ProfiledMutex mutex_readcount("mutex_readcount");
+ProfiledMutex log_mutex("log_mutex");
 int read_count = 0;
 
 // NEW: Timing-related global definitions
-pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+ProfiledMutex stats_mutex("stats_mutex");
 int total_operations = 0;
 int active_readers = 0;
 int active_writers = 0;
@@ -37,12 +47,12 @@ std::vector<OperationTiming> detailed_timings;
 
 // ===== TIMING UTILITY FUNCTIONS =====
 
-std::chrono::high_resolution_clock::time_point get_current_time() {
-    return std::chrono::high_resolution_clock::now();
+FastClock::time_point get_current_time() {
+    return FastClock::now();
 }
 
-long long get_microseconds_since(const std::chrono::high_resolution_clock::time_point& start) {
-    auto end = std::chrono::high_resolution_clock::now();
+long long get_microseconds_since(const FastClock::time_point& start) {
+    auto end = FastClock::now();
     return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 }
 
@@ -64,33 +74,20 @@ std::string format_duration(double ms) {
     }
 }
 
+// Both use a per-second cached prefix instead of localtime + put_time per call
 std::string getCurrentTimestamp() {
-    auto now = std::time(nullptr);
-    auto tm = *std::localtime(&now);
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+    return format_wall_clock(wall_clock_us());
 }
 
 std::string getCurrentTimestampMicro() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto tm = *std::localtime(&time_t);
-    
-    auto ms = std::chrono::duration_cast<std::chrono::microseconds>(
-        now.time_since_epoch()) % 1000000;
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    oss << "." << std::setfill('0') << std::setw(6) << ms.count();
-    return oss.str();
+    return format_wall_clock(wall_clock_us(), true);
 }
 
 // ===== LOGGING FUNCTIONS =====
 
 // Keep existing log_event function for backward compatibility
 void log_event(int thread_id, const std::string& action, const std::string& status) {
-    pthread_mutex_lock(&log_mutex);
+    log_mutex.lock();
     
     std::string timestamp = getCurrentTimestamp();
     std::string thread_type;
@@ -105,59 +102,33 @@ void log_event(int thread_id, const std::string& action, const std::string& stat
     // Log to console
     std::cout << log_entry << std::endl;
     
-    // Log to file
-    std::ofstream log_file("./logs/simulation.log", std::ios::app);
-    if (log_file) {
-        log_file << log_entry << std::endl;
-        log_file.close();
-    }
+    // Log to file (simulation.log, indexed for /api/logs)
+    log_store.append(thread_type, thread_id, action, status, log_entry);
+    binary_log.append(log_op_from_string(action), log_status_from_string(status), thread_id, status);
     
-    pthread_mutex_unlock(&log_mutex);
+    log_mutex.unlock();
 }
 
 void log_real_time_status(const std::string& message) {
-    pthread_mutex_lock(&log_mutex);
+    log_mutex.lock();
     std::string timestamp = getCurrentTimestampMicro();
     std::string log_entry = "[" + timestamp + "] [REAL-TIME] " + message;
     
     std::cout << log_entry << std::endl;
     
-    std::ofstream log_file("./logs/realtime_status.log", std::ios::app);
-    if (log_file) {
-        log_file << log_entry << std::endl;
-        log_file.close();
-    }
-    pthread_mutex_unlock(&log_mutex);
+    binary_log.append(LogOp::REALTIME, LogStatus::INFO, 0, message);
+    log_mutex.unlock();
 }
 
 void log_timing_event(int thread_id, const std::string& action, const OperationTiming& timing) {
-    pthread_mutex_lock(&log_mutex);
-    
-    std::string timestamp = getCurrentTimestampMicro();
-    std::string thread_type;
-    
-    if (action == "READ") thread_type = "READER";
-    else if (action == "WRITE") thread_type = "WRITER";
-    else if (action == "DELETE") thread_type = "DELETER";
-    else thread_type = "MAIN";
-    
-    std::string log_entry = "[" + timestamp + "] [" + thread_type + "#" + 
-                           std::to_string(thread_id) + "] " + action + 
-                           " - Wait: " + std::to_string(timing.wait_time_us) + "μs, " +
-                           "Operation: " + std::to_string(timing.operation_time_us) + "μs, " +
-                           "Total: " + std::to_string(timing.total_time_us) + "μs";
-    
-    std::ofstream perf_file("./logs/performance.log", std::ios::app);
-    if (perf_file) {
-        perf_file << log_entry << std::endl;
-        perf_file.close();
-    }
-    pthread_mutex_unlock(&log_mutex);
+    // Per-operation timings are high volume; they go to the binary log only
+    binary_log.append(log_op_from_string(action), LogStatus::TIMING, thread_id, "",
+                      timing.wait_time_us, timing.operation_time_us, timing.total_time_us);
 }
 
 // Overloaded version for simple logging
 void log_timing_event(int thread_id, const std::string& action, const std::string& status, double duration_ms) {
-    pthread_mutex_lock(&log_mutex);
+    log_mutex.lock();
     
     std::string timestamp = getCurrentTimestamp();
     std::string thread_type;
@@ -169,21 +140,21 @@ void log_timing_event(int thread_id, const std::string& action, const std::strin
     
     std::string log_entry = "[" + timestamp + "] [" + thread_type + "#" + std::to_string(thread_id) + "] " + action + " " + status;
     
+    std::string logged_status = status;
     if (duration_ms >= 0) {
+        logged_status += " (took: " + format_duration(duration_ms) + ")";
         log_entry += " (took: " + format_duration(duration_ms) + ")";
     }
     
     // Log to console
     std::cout << log_entry << std::endl;
     
-    // Log to file
-    std::ofstream log_file("./logs/simulation.log", std::ios::app);
-    if (log_file) {
-        log_file << log_entry << std::endl;
-        log_file.close();
-    }
+    // Log to file (simulation.log, indexed for /api/logs)
+    log_store.append(thread_type, thread_id, action, logged_status, log_entry);
+    binary_log.append(log_op_from_string(action), log_status_from_string(status), thread_id, status,
+                      0.0, 0.0, duration_ms > 0 ? duration_ms * 1000.0 : 0.0);
     
-    pthread_mutex_unlock(&log_mutex);
+    log_mutex.unlock();
 }
 
 // ===== TIMING SYSTEM FUNCTIONS =====
@@ -192,12 +163,12 @@ void log_timing_event(int thread_id, const std::string& action, const std::strin
 void initialize_timing_system() {
     system_start_time = std::chrono::steady_clock::now();
     
-    pthread_mutex_lock(&stats_mutex);
+    stats_mutex.lock();
     total_operations = 0;
     active_readers = active_writers = active_deleters = 0;
     completed_reads = completed_writes = completed_deletes = 0;
     total_read_time = total_write_time = total_delete_time = 0.0;
-    pthread_mutex_unlock(&stats_mutex);
+    stats_mutex.unlock();
     
     std::cout << "\n🕐 TIMING SYSTEM INITIALIZED\n";
     std::cout << "System start time: " << getCurrentTimestamp() << "\n";
@@ -214,9 +185,49 @@ void cleanup_timing_system() {
     log_timing_event(0, "SYSTEM", "TIMING_CLEANUP", total_system_time);
 }
 
+// Storage engine metrics, resolved once so recording stays lock-free
+struct StorageMetrics {
+    Counter* completed;
+    Gauge* active;
+    Histogram* wait_seconds;
+    Histogram* total_seconds;
+};
+
+static StorageMetrics* storage_metrics(const std::string& operation) {
+    static StorageMetrics metrics[3];
+    static std::once_flag once;
+    static const char* names[3] = {"READ", "WRITE", "DELETE"};
+    std::call_once(once, []() {
+        for (int i = 0; i < 3; i++) {
+            MetricLabels labels = {{"operation", names[i]}};
+            metrics[i].completed = &metrics_registry.counter("cloud_operations_total",
+                "Completed storage operations", labels);
+            metrics[i].active = &metrics_registry.gauge("cloud_active_operations",
+                "Storage operations currently in progress", labels);
+            metrics[i].wait_seconds = &metrics_registry.histogram("cloud_lock_wait_seconds",
+                "Time spent waiting for the storage lock", labels);
+            metrics[i].total_seconds = &metrics_registry.histogram("cloud_operation_duration_seconds",
+                "End-to-end storage operation latency", labels);
+        }
+    });
+    for (int i = 0; i < 3; i++) {
+        if (operation == names[i]) return &metrics[i];
+    }
+    return nullptr;
+}
+
 // NEW: Update operation statistics
 void update_operation_stats(const std::string& operation, double duration, bool started) {
-    pthread_mutex_lock(&stats_mutex);
+    if (StorageMetrics* m = storage_metrics(operation)) {
+        if (started) {
+            m->active->inc();
+        } else {
+            m->active->dec();
+            m->completed->inc();
+        }
+    }
+
+    stats_mutex.lock();
     
     if (operation == "READ") {
         if (started) {
@@ -248,20 +259,24 @@ void update_operation_stats(const std::string& operation, double duration, bool
         total_operations++;
     }
     
-    pthread_mutex_unlock(&stats_mutex);
+    stats_mutex.unlock();
 }
 
 // ===== STATISTICS FUNCTIONS =====
 
 void update_statistics(const std::string& operation, const OperationTiming& timing) {
-    pthread_mutex_lock(&stats_mutex);
+    if (StorageMetrics* m = storage_metrics(operation)) {
+        m->wait_seconds->observe(timing.wait_time_us / 1e6);
+        m->total_seconds->observe(timing.total_time_us / 1e6);
+    }
+    stats_mutex.lock();
     global_stats[operation].add_timing(timing);
     detailed_timings.push_back(timing);
-    pthread_mutex_unlock(&stats_mutex);
+    stats_mutex.unlock();
 }
 
 void print_performance_report() {
-    pthread_mutex_lock(&stats_mutex);
+    stats_mutex.lock();
     
     std::cout << "\n" << std::string(60, '=') << "\n";
     std::cout << "📊 PERFORMANCE ANALYSIS REPORT\n";
@@ -279,15 +294,18 @@ void print_performance_report() {
         }
     }
     
+    stats_mutex.unlock();
+    
+    print_lock_report(std::cout);
+    print_alloc_report(std::cout);
     std::cout << std::string(60, '=') << "\n";
-    pthread_mutex_unlock(&stats_mutex);
 }
 
 void reset_statistics() {
-    pthread_mutex_lock(&stats_mutex);
+    stats_mutex.lock();
     global_stats.clear();
     detailed_timings.clear();
-    pthread_mutex_unlock(&stats_mutex);
+    stats_mutex.unlock();
 }
 
 // ===== UTILITY FUNCTIONS =====
@@ -311,8 +329,14 @@ void show_directory_structure() {
     }
 }
 
-std::string getRandomTestFile() {
-    std::vector<std::string> test_files;
+// Sorted listing of ./test_files, rescanned only when the directory's
+// modification time changes (uploads add files there)
+std::shared_ptr<const std::vector<std::string>> get_test_files() {
+    static std::mutex mtx;
+    static std::shared_ptr<const std::vector<std::string>> cached;
+    static std::filesystem::file_time_type scanned_mtime;
+
+    std::lock_guard<std::mutex> lock(mtx);
 
     // Create test_files directory if it doesn't exist
     if (!std::filesystem::exists("./test_files/")) {
@@ -345,23 +369,35 @@ std::string getRandomTestFile() {
         logfile.close();
     }
 
-    // Scan for files in test_files directory
-    for (const auto& entry : std::filesystem::directory_iterator("./test_files/")) {
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time("./test_files/", ec);
+    if (cached && !ec && mtime == scanned_mtime) {
+        return cached;
+    }
+
+    auto test_files = std::make_shared<std::vector<std::string>>();
+    for (const auto& entry : std::filesystem::directory_iterator("./test_files/", ec)) {
         if (entry.is_regular_file()) {
-            test_files.push_back(entry.path().string());
+            test_files->push_back(entry.path().string());
         }
     }
+    std::sort(test_files->begin(), test_files->end());
+    scanned_mtime = mtime;
+    cached = test_files;
+    return cached;
+}
 
-    if (test_files.empty()) {
+std::string getRandomTestFile() {
+    auto test_files = get_test_files();
+    if (test_files->empty()) {
         return "./test_files/default.txt"; // fallback
     }
 
     // Return random file
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, test_files.size() - 1);
+    thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<size_t> dis(0, test_files->size() - 1);
     
-    return test_files[dis(gen)];
+    return (*test_files)[dis(gen)];
 }
 
 // ===== FILE OPERATION FUNCTIONS =====
@@ -405,9 +441,9 @@ void uploadFile(const std::string& filename) {
     in.close();
 
     // CRITICAL: Proper synchronization for cloudData access
-    pthread_mutex_lock(&rw_mutex);
+    rw_mutex.lock();
     cloudData = content;
-    pthread_mutex_unlock(&rw_mutex);
+    rw_mutex.unlock();
     
     double duration = get_elapsed_time_ms(start_time);
     
@@ -428,9 +464,9 @@ void downloadFile(const std::string& filename) {
     
     // CRITICAL: Proper synchronization for cloudData access
     std::string content;
-    pthread_mutex_lock(&rw_mutex);
+    rw_mutex.lock();
     content = cloudData; // Copy while holding the lock
-    pthread_mutex_unlock(&rw_mutex);
+    rw_mutex.unlock();
     
     std::ofstream out(filename, std::ios::out | std::ios::binary);
     if (!out) {
@@ -457,45 +493,50 @@ void downloadFile(const std::string& filename) {
 
 // Stress test function - spawns multiple threads to test the system
 void run_stress_test(int num_threads) {
-    std::cout << "\n=== Starting Stress Test with " << num_threads << " threads ===\n" << std::endl;
-    log_event(0, "STRESS_TEST", "Starting with " + std::to_string(num_threads) + " threads");
-    
-    std::vector<pthread_t> threads;
-    std::vector<int*> thread_ids;
-    
-    // Create a mix of readers, writers, and deleters
-    for (int i = 0; i < num_threads; i++) {
-        pthread_t thread;
-        int* tid = new int(i + 1);
-        thread_ids.push_back(tid);
-        
-        // Distribute thread types: 50% readers, 30% writers, 20% deleters
-        int type = i % 10;
-        if (type < 5) {
-            // Reader
-            pthread_create(&thread, nullptr, reader, tid);
-        } else if (type < 8) {
-            // Writer
-            pthread_create(&thread, nullptr, writer, tid);
-        } else {
-            // Deleter
-            pthread_create(&thread, nullptr, deleter, tid);
-        }
-        
-        threads.push_back(thread);
-    }
-    
-    // Wait for all threads to complete
-    for (pthread_t thread : threads) {
-        pthread_join(thread, nullptr);
-    }
-    
-    // Cleanup
-    for (int* tid : thread_ids) {
-        delete tid;
-    }
-    
-    std::cout << "\n=== Stress Test Completed ===\n" << std::endl;
-    log_event(0, "STRESS_TEST", "Completed successfully");
+    run_stress_test(num_threads, nullptr, nullptr);
     print_performance_report();
-}
\ No newline at end of file
+}
+
+// Nearest-rank percentiles over the total time of one operation type
+LatencySummary summarize_latencies(std::vector<OperationTiming>::const_iterator begin,
+                                   std::vector<OperationTiming>::const_iterator end,
+                                   const std::string& operation) {
+    LatencySummary summary;
+    std::vector<double> totals;
+    double wait_sum = 0.0;
+    double total_sum = 0.0;
+    for (auto it = begin; it != end; ++it) {
+        if (operation != it->operation) continue;
+        totals.push_back(it->total_time_us);
+        wait_sum += it->wait_time_us;
+        total_sum += it->total_time_us;
+    }
+    if (totals.empty()) return summary;
+
+    std::sort(totals.begin(), totals.end());
+    auto rank = [&totals](double p) {
+        size_t index = static_cast<size_t>(std::ceil(p * totals.size()));
+        return totals[index == 0 ? 0 : index - 1];
+    };
+    summary.count = static_cast<int>(totals.size());
+    summary.avg_wait_us = wait_sum / totals.size();
+    summary.avg_total_us = total_sum / totals.size();
+    summary.p50_us = rank(0.50);
+    summary.p95_us = rank(0.95);
+    summary.p99_us = rank(0.99);
+    summary.max_us = totals.back();
+    return summary;
+}
+
+// The original stress test: num_threads operations in the default 5/3/2
+// mix, all started at once. on_progress is called with (finished, total);
+// when cancel_requested becomes true no further operations are launched and
+// the running ones drain. See run_workload for the configurable version.
+StressTestResult run_stress_test(int num_threads,
+                                 const std::function<void(int, int)>& on_progress,
+                                 const std::atomic<bool>* cancel_requested) {
+    WorkloadConfig config;
+    config.operations = num_threads;
+    config.concurrency = num_threads;
+    return run_workload(config, on_progress, cancel_requested);
+}
@@ -1,13 +1,16 @@
 #include "deadlock_detector.h"
+#include "metrics.h"
 #include <iostream>
 #include <iomanip>
 
 DeadlockDetector::DeadlockDetector() {
-    // Initialize with basic resources (1 unit each for proper circular deadlock)
-    addResource(1, 1, "Printer");
-    addResource(2, 1, "Scanner");
-    addResource(3, 1, "USB_Drive");
-    addResource(4, 1, "Network_Port");
+    // Initialize with basic resources (1 unit each for proper circular deadlock).
+    // Added silently: the global detector is built during static
+    // initialization, before tools like loadgen can redirect std::cout
+    resources.emplace_back(1, 1, "Printer");
+    resources.emplace_back(2, 1, "Scanner");
+    resources.emplace_back(3, 1, "USB_Drive");
+    resources.emplace_back(4, 1, "Network_Port");
 }
 
 void DeadlockDetector::addResource(int resource_id, int total_units, const std::string& name) {
@@ -21,6 +24,10 @@ void DeadlockDetector::addProcess(int process_id, const std::string& name) {
 }
 
 bool DeadlockDetector::requestResource(int process_id, int resource_id, int units) {
+    static Counter& granted = metrics_registry.counter("deadlock_resource_requests_total", "Resource requests",
+                                                       {{"result", "granted"}});
+    static Counter& blocked = metrics_registry.counter("deadlock_resource_requests_total", "Resource requests",
+                                                       {{"result", "blocked"}});
     auto proc_it = std::find_if(processes.begin(), processes.end(),
                                [process_id](const DLProcess& p) { return p.process_id == process_id; });
     auto res_it = std::find_if(resources.begin(), resources.end(),
@@ -46,8 +53,10 @@ bool DeadlockDetector::requestResource(int process_id, int resource_id, int unit
         process.maximum[resource_id] = std::max(current_maximum, current_allocated + units);
         process.needed[resource_id] = process.maximum[resource_id] - current_allocated;
         
+        blocked.inc();
         return false;
     }
+    granted.inc();
     
     // Update allocation
     process.allocated[resource_id] += units;
@@ -92,6 +101,10 @@ bool DeadlockDetector::releaseResource(int process_id, int resource_id, int unit
 }
 
 bool DeadlockDetector::detectDeadlock() {
+    static Counter& deadlock_runs = metrics_registry.counter("deadlock_detections_total", "Deadlock detection runs",
+                                                             {{"result", "deadlock"}});
+    static Counter& clear_runs = metrics_registry.counter("deadlock_detections_total", "Deadlock detection runs",
+                                                          {{"result", "clear"}});
     buildWaitForGraph();
     
     int n = processes.size();
@@ -100,12 +113,12 @@ bool DeadlockDetector::detectDeadlock() {
     std::vector<bool> visited(n, false);
     std::vector<bool> rec_stack(n, false);
     
-    for (int i = 0; i < n; i++) {
-        if (hasCycle(i, visited, rec_stack)) {
-            return true;
-        }
+    bool found = false;
+    for (int i = 0; i < n && !found; i++) {
+        found = hasCycle(i, visited, rec_stack);
     }
-    return false;
+    (found ? deadlock_runs : clear_runs).inc();
+    return found;
 }
 
 void DeadlockDetector::buildWaitForGraph() {
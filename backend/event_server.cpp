@@ -0,0 +1,539 @@
+#include "event_server.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// In-memory httplib::Stream: reads come from the framed request buffer and
+// writes accumulate into the response buffer handed back to the reactor.
+class BufferedStream : public httplib::Stream {
+private:
+    const std::string& input;
+    size_t position;
+    std::string& output;
+    std::string remote_addr;
+    int remote_port;
+    int sock;
+
+public:
+    BufferedStream(const std::string& in, std::string& out,
+                   const std::string& addr, int port, int fd)
+        : input(in), position(0), output(out), remote_addr(addr),
+          remote_port(port), sock(fd) {}
+
+    bool is_readable() const override { return position < input.size(); }
+    bool wait_readable() const override { return true; }
+    bool wait_writable() const override { return true; }
+
+    ssize_t read(char* ptr, size_t size) override {
+        size_t n = std::min(size, input.size() - position);
+        std::memcpy(ptr, input.data() + position, n);
+        position += n;
+        return static_cast<ssize_t>(n);
+    }
+
+    ssize_t write(const char* ptr, size_t size) override {
+        output.append(ptr, size);
+        return static_cast<ssize_t>(size);
+    }
+
+    void get_remote_ip_and_port(std::string& ip, int& port) const override {
+        ip = remote_addr;
+        port = remote_port;
+    }
+
+    void get_local_ip_and_port(std::string& ip, int& port) const override {
+        ip.clear();
+        port = 0;
+    }
+
+    socket_t socket() const override { return sock; }
+    time_t duration() const override { return 0; }
+};
+
+bool iequals_prefix(const std::string& s, size_t pos, const char* name) {
+    size_t len = std::strlen(name);
+    if (pos + len > s.size()) return false;
+    for (size_t i = 0; i < len; i++) {
+        if (std::tolower(static_cast<unsigned char>(s[pos + i])) != name[i]) return false;
+    }
+    return true;
+}
+
+void set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+const char* const kOverloadedResponse =
+    "HTTP/1.1 503 Service Unavailable\r\n"
+    "Content-Type: application/json\r\n"
+    "Retry-After: 1\r\n"
+    "Connection: close\r\n"
+    "Content-Length: 46\r\n"
+    "\r\n"
+    "{\"success\":false,\"error\":\"Server overloaded\"}\n";
+
+const char* const kBadRequestResponse =
+    "HTTP/1.1 400 Bad Request\r\n"
+    "Connection: close\r\n"
+    "Content-Length: 0\r\n"
+    "\r\n";
+
+} // namespace
+
+// ===== DISPATCH SERVER =====
+
+bool DispatchServer::dispatch_buffer(const std::string& raw_request, std::string& raw_response,
+                                     const std::string& remote_addr, int remote_port, int sock) {
+    BufferedStream strm(raw_request, raw_response, remote_addr, remote_port, sock);
+    bool connection_closed = false;
+    bool ok = process_request(strm, remote_addr, remote_port, "", 0,
+                              false, connection_closed, nullptr);
+
+    // httplib marks error responses and "Connection: close" requests itself.
+    // Skip an interim "100 Continue" so only the final headers are inspected.
+    size_t headers_start = 0;
+    if (raw_response.compare(0, 12, "HTTP/1.1 100") == 0) {
+        headers_start = raw_response.find("\r\n\r\n") + 4;
+    }
+    size_t header_end = raw_response.find("\r\n\r\n", headers_start);
+    size_t close_pos = raw_response.find("\r\nConnection: close\r\n", headers_start);
+    bool close_header = header_end != std::string::npos && close_pos < header_end + 2;
+    return !ok || connection_closed || close_header;
+}
+
+void DispatchServer::add_pre_routing_hook(HandlerWithResponse hook) {
+    pre_hooks.push_back(std::move(hook));
+    if (pre_hooks.size() == 1) {
+        set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+            for (auto& pre : pre_hooks) {
+                if (pre(req, res) == HandlerResponse::Handled) {
+                    return HandlerResponse::Handled;
+                }
+            }
+            return HandlerResponse::Unhandled;
+        });
+    }
+}
+
+void DispatchServer::add_post_routing_hook(Handler hook) {
+    post_hooks.push_back(std::move(hook));
+    if (post_hooks.size() == 1) {
+        set_post_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+            for (auto& post : post_hooks) {
+                post(req, res);
+            }
+        });
+    }
+}
+
+// ===== EVENT SERVER =====
+
+EventServer::EventServer(DispatchServer& server, EventServerConfig cfg)
+    : routes(server), config(cfg), listen_fd(-1), epoll_fd(-1), wake_fd(-1), port(-1),
+      running(false), next_connection_id(1), open_connections(0),
+      requests_served(0), requests_rejected(0) {
+    size_t threads = config.worker_threads;
+    if (threads == 0) {
+        threads = std::max(2u, std::thread::hardware_concurrency());
+    }
+    pool = std::make_unique<WorkerPool>(threads, config.max_pending);
+}
+
+EventServer::~EventServer() {
+    stop();
+    pool->shutdown();
+    for (auto& [fd, conn] : connections) {
+        ::close(fd);
+    }
+    connections.clear();
+    if (listen_fd >= 0) ::close(listen_fd);
+    if (epoll_fd >= 0) ::close(epoll_fd);
+    if (wake_fd >= 0) ::close(wake_fd);
+}
+
+int EventServer::bind_to_port(const std::string& host, int requested_port) {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* result = nullptr;
+    std::string service = std::to_string(requested_port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &result) != 0) {
+        return -1;
+    }
+
+    listen_fd = ::socket(result->ai_family, result->ai_socktype | SOCK_CLOEXEC, result->ai_protocol);
+    if (listen_fd < 0) {
+        freeaddrinfo(result);
+        return -1;
+    }
+
+    int yes = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    if (::bind(listen_fd, result->ai_addr, result->ai_addrlen) != 0 ||
+        ::listen(listen_fd, SOMAXCONN) != 0) {
+        freeaddrinfo(result);
+        ::close(listen_fd);
+        listen_fd = -1;
+        return -1;
+    }
+    freeaddrinfo(result);
+    set_nonblocking(listen_fd);
+
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+    port = ntohs(addr.sin_port);
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listen_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+    ev.data.fd = wake_fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev);
+
+    running = true;
+    return port;
+}
+
+bool EventServer::listen(const std::string& host, int requested_port) {
+    if (bind_to_port(host, requested_port) < 0) return false;
+    return listen_after_bind();
+}
+
+bool EventServer::listen_after_bind() {
+    if (listen_fd < 0) return false;
+    routes.attach_listener(listen_fd);
+
+    std::vector<epoll_event> events(1024);
+    auto last_sweep = std::chrono::steady_clock::now();
+
+    while (running) {
+        int n = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), 1000);
+        if (n < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            uint32_t mask = events[i].events;
+
+            if (fd == listen_fd) {
+                accept_connections();
+                continue;
+            }
+            if (fd == wake_fd) {
+                uint64_t value;
+                while (::read(wake_fd, &value, sizeof(value)) > 0) {}
+                drain_completions();
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& conn = *it->second;
+
+            if (mask & (EPOLLERR | EPOLLHUP)) {
+                close_connection(fd);
+                continue;
+            }
+            if (mask & EPOLLIN) {
+                handle_readable(conn);
+                if (connections.find(fd) == connections.end()) continue;
+            }
+            if (mask & EPOLLOUT) {
+                flush(conn);
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_sweep >= std::chrono::seconds(1)) {
+            sweep_idle_connections();
+            last_sweep = now;
+        }
+    }
+
+    routes.detach_listener();
+    return true;
+}
+
+void EventServer::stop() {
+    if (!running.exchange(false)) return;
+    if (wake_fd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void EventServer::accept_connections() {
+    for (;;) {
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        int fd = accept4(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            // EAGAIN: backlog drained. EMFILE and friends: retry on next wakeup.
+            return;
+        }
+        if (connections.size() >= config.max_connections) {
+            ::close(fd);
+            requests_rejected++;
+            continue;
+        }
+
+        int yes = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+
+        auto conn = std::make_unique<Connection>();
+        conn->fd = fd;
+        conn->id = next_connection_id++;
+        conn->last_active = std::chrono::steady_clock::now();
+        char ip[INET_ADDRSTRLEN] = {0};
+        inet_ntop(AF_INET, &addr.sin_addr, ip, sizeof(ip));
+        conn->remote_addr = ip;
+        conn->remote_port = ntohs(addr.sin_port);
+
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+
+        connections[fd] = std::move(conn);
+        open_connections++;
+    }
+}
+
+void EventServer::handle_readable(Connection& conn) {
+    char buffer[16384];
+    for (;;) {
+        ssize_t n = ::recv(conn.fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            conn.in.append(buffer, static_cast<size_t>(n));
+            conn.last_active = std::chrono::steady_clock::now();
+            if (conn.in.size() > config.max_request_bytes + config.max_header_bytes) {
+                close_connection(conn.fd);
+                return;
+            }
+            continue;
+        }
+        if (n == 0) {
+            // Peer finished sending; answer what it sent, then close
+            conn.read_closed = true;
+            update_interest(conn, conn.want_write);
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        close_connection(conn.fd);
+        return;
+    }
+    try_dispatch(conn);
+}
+
+// Returns the byte length of the first complete request in the buffer,
+// 0 when more data is needed and -1 when the request cannot be framed.
+long EventServer::frame_request(const std::string& buffer) const {
+    size_t header_end = buffer.find("\r\n\r\n");
+    if (header_end == std::string::npos) {
+        return buffer.size() > config.max_header_bytes ? -1 : 0;
+    }
+    if (header_end > config.max_header_bytes) return -1;
+
+    size_t content_length = 0;
+    bool chunked = false;
+    size_t line = buffer.find("\r\n");
+    while (line < header_end) {
+        size_t start = line + 2;
+        if (iequals_prefix(buffer, start, "content-length:")) {
+            content_length = std::strtoull(buffer.c_str() + start + 15, nullptr, 10);
+        } else if (iequals_prefix(buffer, start, "transfer-encoding:")) {
+            size_t end = buffer.find("\r\n", start);
+            std::string value = buffer.substr(start + 18, end - start - 18);
+            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+            chunked = value.find("chunked") != std::string::npos;
+        }
+        line = buffer.find("\r\n", start);
+    }
+
+    size_t body_start = header_end + 4;
+    if (!chunked) {
+        if (content_length > config.max_request_bytes) return -1;
+        size_t total = body_start + content_length;
+        return buffer.size() >= total ? static_cast<long>(total) : 0;
+    }
+
+    // Walk chunk headers until the terminating zero-size chunk
+    size_t pos = body_start;
+    for (;;) {
+        size_t size_end = buffer.find("\r\n", pos);
+        if (size_end == std::string::npos) return 0;
+        size_t chunk_size = std::strtoull(buffer.c_str() + pos, nullptr, 16);
+        if (chunk_size == 0) {
+            size_t trailer_end = buffer.find("\r\n\r\n", size_end);
+            if (trailer_end == std::string::npos) {
+                return 0;
+            }
+            return static_cast<long>(trailer_end + 4);
+        }
+        pos = size_end + 2 + chunk_size + 2;
+        if (pos - body_start > config.max_request_bytes) return -1;
+        if (pos > buffer.size()) return 0;
+    }
+}
+
+void EventServer::try_dispatch(Connection& conn) {
+    if (conn.busy || conn.close_after_write || !conn.out.empty()) return;
+
+    long length = frame_request(conn.in);
+    if (length == 0) {
+        // Nothing more will arrive to complete the buffer
+        if (conn.read_closed) close_connection(conn.fd);
+        return;
+    }
+    if (length < 0) {
+        conn.in.clear();
+        conn.out = kBadRequestResponse;
+        conn.close_after_write = true;
+        flush(conn);
+        return;
+    }
+
+    auto request = std::make_shared<std::string>(conn.in.substr(0, static_cast<size_t>(length)));
+    conn.in.erase(0, static_cast<size_t>(length));
+    conn.busy = true;
+
+    int fd = conn.fd;
+    uint64_t id = conn.id;
+    std::string remote_addr = conn.remote_addr;
+    int remote_port = conn.remote_port;
+
+    bool queued = pool->submit([this, fd, id, request, remote_addr, remote_port]() {
+        Completion completion{fd, id, std::string(), false};
+        completion.close = routes.dispatch_buffer(*request, completion.response,
+                                                  remote_addr, remote_port, fd);
+        post_completion(std::move(completion));
+    });
+
+    if (!queued) {
+        // Compute pool saturated: shed at the edge instead of queueing unbounded
+        requests_rejected++;
+        conn.busy = false;
+        conn.out = kOverloadedResponse;
+        conn.close_after_write = true;
+        flush(conn);
+    }
+}
+
+void EventServer::post_completion(Completion completion) {
+    {
+        std::lock_guard<std::mutex> lock(completion_mutex);
+        completions.push_back(std::move(completion));
+    }
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wake_fd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void EventServer::drain_completions() {
+    std::vector<Completion> ready;
+    {
+        std::lock_guard<std::mutex> lock(completion_mutex);
+        ready.swap(completions);
+    }
+
+    for (auto& completion : ready) {
+        requests_served++;
+        auto it = connections.find(completion.fd);
+        // The fd may have been closed and reused while the request was running
+        if (it == connections.end() || it->second->id != completion.id) continue;
+
+        Connection& conn = *it->second;
+        conn.busy = false;
+        conn.out = std::move(completion.response);
+        conn.out_offset = 0;
+        conn.close_after_write = completion.close;
+        conn.last_active = std::chrono::steady_clock::now();
+        flush(conn);
+    }
+}
+
+void EventServer::flush(Connection& conn) {
+    while (conn.out_offset < conn.out.size()) {
+        ssize_t n = ::send(conn.fd, conn.out.data() + conn.out_offset,
+                           conn.out.size() - conn.out_offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.out_offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            update_interest(conn, true);
+            return;
+        }
+        close_connection(conn.fd);
+        return;
+    }
+
+    conn.out.clear();
+    conn.out_offset = 0;
+    conn.last_active = std::chrono::steady_clock::now();
+    if (conn.close_after_write) {
+        close_connection(conn.fd);
+        return;
+    }
+    update_interest(conn, false);
+
+    // Pipelined requests may already be waiting in the input buffer
+    try_dispatch(conn);
+}
+
+void EventServer::update_interest(Connection& conn, bool want_write) {
+    bool want_read = !conn.read_closed;
+    if (conn.want_write == want_write && conn.want_read == want_read) return;
+    conn.want_write = want_write;
+    conn.want_read = want_read;
+    epoll_event ev{};
+    ev.events = (want_read ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+                (want_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    ev.data.fd = conn.fd;
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn.fd, &ev);
+}
+
+void EventServer::close_connection(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(it);
+    open_connections--;
+}
+
+void EventServer::sweep_idle_connections() {
+    if (config.idle_timeout_sec <= 0) return;
+    auto deadline = std::chrono::steady_clock::now() - std::chrono::seconds(config.idle_timeout_sec);
+
+    std::vector<int> expired;
+    for (const auto& [fd, conn] : connections) {
+        if (!conn->busy && conn->out.empty() && conn->last_active < deadline) {
+            expired.push_back(fd);
+        }
+    }
+    for (int fd : expired) {
+        close_connection(fd);
+    }
+}
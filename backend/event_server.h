@@ -0,0 +1,131 @@
+#ifndef EVENT_SERVER_H
+#define EVENT_SERVER_H
+
+#include <httplib.h>
+#include "worker_pool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// httplib::Server whose routing can also be driven from an external reactor.
+// The reactor hands over one complete HTTP request as a byte buffer and gets
+// the serialized response back, so every route, pre/post-routing hook and
+// error handler registered on the server is shared by both front ends.
+class DispatchServer : public httplib::Server {
+public:
+    // Returns true when the connection must be closed after the response.
+    bool dispatch_buffer(const std::string& raw_request, std::string& raw_response,
+                         const std::string& remote_addr, int remote_port, int sock);
+
+    // Content providers poll the listening socket to detect shutdown, so the
+    // reactor publishes its own listener here while it is running.
+    void attach_listener(int listen_fd) { svr_sock_ = listen_fd; }
+    void detach_listener() { svr_sock_ = INVALID_SOCKET; }
+
+    // httplib keeps a single pre/post-routing handler; these compose several.
+    // Pre hooks run in registration order until one handles the request.
+    // Post hooks all run, in registration order, for every response.
+    // Register hooks before the server starts.
+    void add_pre_routing_hook(HandlerWithResponse hook);
+    void add_post_routing_hook(Handler hook);
+
+private:
+    std::vector<HandlerWithResponse> pre_hooks;
+    std::vector<Handler> post_hooks;
+};
+
+struct EventServerConfig {
+    size_t worker_threads = 0;                    // 0 = hardware concurrency
+    size_t max_pending = 1024;                    // queued requests before 503
+    size_t max_connections = 65536;
+    int idle_timeout_sec = 60;                    // keep-alive idle limit
+    size_t max_header_bytes = 16 * 1024;
+    size_t max_request_bytes = 64 * 1024 * 1024;
+};
+
+// Single-threaded epoll reactor with non-blocking sockets. Idle keep-alive
+// connections cost a small buffer each and no thread; only requests that are
+// fully read are dispatched onto a bounded WorkerPool.
+class EventServer {
+private:
+    struct Connection {
+        int fd;
+        uint64_t id;
+        std::string in;
+        std::string out;
+        size_t out_offset = 0;
+        bool busy = false;                        // request is on the pool
+        bool close_after_write = false;
+        bool read_closed = false;                 // peer shut down its side
+        bool want_read = true;
+        bool want_write = false;
+        std::chrono::steady_clock::time_point last_active;
+        std::string remote_addr;
+        int remote_port = 0;
+    };
+
+    struct Completion {
+        int fd;
+        uint64_t id;
+        std::string response;
+        bool close;
+    };
+
+    DispatchServer& routes;
+    EventServerConfig config;
+    std::unique_ptr<WorkerPool> pool;
+
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+    int port;
+    std::atomic<bool> running;
+    uint64_t next_connection_id;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+
+    std::mutex completion_mutex;
+    std::vector<Completion> completions;
+
+    std::atomic<size_t> open_connections;
+    std::atomic<uint64_t> requests_served;
+    std::atomic<uint64_t> requests_rejected;
+
+    void accept_connections();
+    void handle_readable(Connection& conn);
+    void try_dispatch(Connection& conn);
+    void flush(Connection& conn);
+    void update_interest(Connection& conn, bool want_write);
+    void close_connection(int fd);
+    void drain_completions();
+    void sweep_idle_connections();
+    void post_completion(Completion completion);
+    long frame_request(const std::string& buffer) const;
+
+public:
+    EventServer(DispatchServer& server, EventServerConfig cfg = EventServerConfig());
+    ~EventServer();
+
+    EventServer(const EventServer&) = delete;
+    EventServer& operator=(const EventServer&) = delete;
+
+    // Mirrors httplib::Server: bind first (port 0 picks a free port), then run.
+    int bind_to_port(const std::string& host, int port);
+    bool listen_after_bind();
+    bool listen(const std::string& host, int port);
+    void stop();
+
+    bool is_running() const { return running.load(); }
+    int bound_port() const { return port; }
+    size_t connection_count() const { return open_connections.load(); }
+    uint64_t served_count() const { return requests_served.load(); }
+    uint64_t rejected_count() const { return requests_rejected.load(); }
+    size_t worker_count() const { return pool ? pool->thread_count() : 0; }
+};
+
+#endif
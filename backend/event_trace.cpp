@@ -0,0 +1,206 @@
+#include "event_trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <shared_mutex>
+#include <unordered_set>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+EventTracer event_tracer;
+
+const char* trace_category_name(TraceCategory category) {
+    switch (category) {
+        case TraceCategory::LOCK: return "lock";
+        case TraceCategory::CRITICAL: return "critical";
+        case TraceCategory::IO: return "io";
+        case TraceCategory::HTTP: return "http";
+        case TraceCategory::OP: return "op";
+    }
+    return "other";
+}
+
+// ===== PER-THREAD RINGS =====
+
+namespace {
+
+// Owns the calling thread's ring and hands it back to the pool on exit
+struct ThreadRing {
+    EventTracer::Ring* ring = nullptr;
+    bool acquired = false;
+    uint32_t tid = static_cast<uint32_t>(syscall(SYS_gettid));
+
+    ~ThreadRing() {
+        if (ring) event_tracer.release_ring(ring);
+    }
+};
+
+ThreadRing& thread_ring() {
+    thread_local ThreadRing state;
+    return state;
+}
+
+} // namespace
+
+void trace_event(TraceCategory category, const char* name,
+                 FastClock::time_point start, FastClock::time_point end, int64_t arg) {
+    if (!event_tracer.is_enabled()) return;
+    ThreadRing& state = thread_ring();
+    if (!state.acquired) {
+        state.acquired = true;
+        state.ring = event_tracer.acquire_ring();
+    }
+    if (!state.ring) {
+        event_tracer.note_drop();
+        return;
+    }
+
+    // Single writer per ring: fill the slot, then publish it through head
+    EventTracer::Ring& ring = *state.ring;
+    uint64_t index = ring.head.load(std::memory_order_relaxed);
+    TraceEvent& slot = ring.events[index % EventTracer::RING_CAPACITY];
+    slot.start_ns = start.time_since_epoch().count();
+    slot.end_ns = end.time_since_epoch().count();
+    slot.name = name;
+    slot.arg = arg;
+    slot.tid = state.tid;
+    slot.category = category;
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+const char* trace_intern(const std::string& name) {
+    static std::shared_mutex mtx;
+    static std::unordered_set<std::string> names;
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = names.find(name);
+        if (it != names.end()) return it->c_str();
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    return names.insert(name).first->c_str();
+}
+
+void set_trace_thread_name(const std::string& name) {
+    event_tracer.name_thread(thread_ring().tid, name);
+}
+
+// ===== TRACER =====
+
+EventTracer::EventTracer() : enabled(true), cleared_before_ns(0), unowned_drops(0) {}
+
+EventTracer::Ring* EventTracer::acquire_ring() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!free_rings.empty()) {
+        Ring* ring = free_rings.back();
+        free_rings.pop_back();
+        return ring;
+    }
+    if (rings.size() >= MAX_RINGS) return nullptr;
+    rings.push_back(std::make_unique<Ring>());
+    return rings.back().get();
+}
+
+// The ring keeps its events (each carries its tid) until overwritten
+void EventTracer::release_ring(Ring* ring) {
+    std::lock_guard<std::mutex> lock(mtx);
+    free_rings.push_back(ring);
+}
+
+void EventTracer::name_thread(uint32_t tid, const std::string& name) {
+    std::lock_guard<std::mutex> lock(mtx);
+    // Short-lived stress test threads would grow this without bound
+    if (thread_names.size() >= 4096) thread_names.clear();
+    thread_names[tid] = name;
+}
+
+EventTracer::Snapshot EventTracer::snapshot(int64_t since_ns) {
+    Snapshot result;
+    int64_t from_ns = std::max(since_ns, cleared_before_ns.load(std::memory_order_relaxed));
+    std::vector<Ring*> pool;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (const auto& ring : rings) pool.push_back(ring.get());
+        result.thread_names = thread_names;
+    }
+    result.dropped = unowned_drops.load(std::memory_order_relaxed);
+
+    for (Ring* ring : pool) {
+        uint64_t before = ring->head.load(std::memory_order_acquire);
+        uint64_t first = before > RING_CAPACITY ? before - RING_CAPACITY : 0;
+        std::vector<TraceEvent> copied;
+        copied.reserve(before - first);
+        for (uint64_t i = first; i < before; i++) {
+            copied.push_back(ring->events[i % RING_CAPACITY]);
+        }
+        // Slots the writer may have reused during the copy are discarded
+        uint64_t after = ring->head.load(std::memory_order_acquire);
+        uint64_t safe = after >= RING_CAPACITY ? after - RING_CAPACITY + 1 : 0;
+        if (first > 0) result.dropped += first;
+        for (uint64_t i = first; i < before; i++) {
+            const TraceEvent& event = copied[i - first];
+            if (i < safe || event.start_ns < from_ns) continue;
+            result.events.push_back(event);
+        }
+    }
+
+    std::sort(result.events.begin(), result.events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.start_ns < b.start_ns;
+    });
+    return result;
+}
+
+void EventTracer::clear() {
+    cleared_before_ns.store(FastClock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+// ===== CHROME TRACE EXPORT =====
+
+static void append_json_string(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+std::string chrome_trace_json(const EventTracer::Snapshot& snapshot) {
+    std::string out;
+    out.reserve(128 * (snapshot.events.size() + snapshot.thread_names.size()) + 64);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char buffer[160];
+
+    for (const auto& [tid, name] : snapshot.thread_names) {
+        std::snprintf(buffer, sizeof(buffer), "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                      first ? "" : ",", tid);
+        out += buffer;
+        append_json_string(out, name);
+        out += "}}";
+        first = false;
+    }
+
+    for (const TraceEvent& event : snapshot.events) {
+        out += first ? "{\"ph\":\"X\",\"name\":" : ",{\"ph\":\"X\",\"name\":";
+        append_json_string(out, event.name ? event.name : "");
+        std::snprintf(buffer, sizeof(buffer), ",\"cat\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                      trace_category_name(event.category), event.tid,
+                      event.start_ns / 1000.0, std::max<int64_t>(0, event.end_ns - event.start_ns) / 1000.0);
+        out += buffer;
+        if (event.arg >= 0) {
+            std::snprintf(buffer, sizeof(buffer), ",\"args\":{\"id\":%lld}", static_cast<long long>(event.arg));
+            out += buffer;
+        }
+        out += '}';
+        first = false;
+    }
+    out += "]}";
+    return out;
+}
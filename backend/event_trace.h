@@ -0,0 +1,109 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include "fast_clock.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Timeline tracing for contention analysis. Each thread appends complete
+// (begin + end) events to its own fixed-size ring without locks or
+// allocation; the exporter copies the rings while writers keep running and
+// renders Chrome trace JSON that Perfetto and chrome://tracing can load.
+
+enum class TraceCategory : uint8_t {
+    LOCK,       // waiting to acquire a lock
+    CRITICAL,   // holding a lock
+    IO,         // file reads and writes
+    HTTP,       // request handling and its phases
+    OP          // a whole reader/writer/deleter operation
+};
+
+const char* trace_category_name(TraceCategory category);
+
+struct TraceEvent {
+    int64_t start_ns;       // FastClock time
+    int64_t end_ns;
+    const char* name;       // string literal or trace_intern() result
+    int64_t arg;            // e.g. reader/writer id, -1 = none
+    uint32_t tid;
+    TraceCategory category;
+};
+
+// Records one event on the calling thread's ring
+void trace_event(TraceCategory category, const char* name,
+                 FastClock::time_point start, FastClock::time_point end, int64_t arg = -1);
+
+// Stable copy of a dynamic name (e.g. a route) for use in events
+const char* trace_intern(const std::string& name);
+
+// Label for the calling thread in the exported timeline
+void set_trace_thread_name(const std::string& name);
+
+// Records an event covering its own lifetime
+class TraceScope {
+private:
+    TraceCategory category;
+    const char* name;
+    int64_t arg;
+    FastClock::time_point started;
+
+public:
+    TraceScope(TraceCategory c, const char* n, int64_t a = -1)
+        : category(c), name(n), arg(a), started(FastClock::now()) {}
+    ~TraceScope() { trace_event(category, name, started, FastClock::now(), arg); }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+class EventTracer {
+public:
+    static constexpr size_t RING_CAPACITY = 4096;   // events per thread ring
+    static constexpr size_t MAX_RINGS = 128;        // threads traced at once
+
+    struct Ring {
+        TraceEvent events[RING_CAPACITY];
+        std::atomic<uint64_t> head{0};              // events ever written
+    };
+
+    struct Snapshot {
+        std::vector<TraceEvent> events;             // ordered by start time
+        std::map<uint32_t, std::string> thread_names;
+        uint64_t dropped = 0;                       // events lost to overflow or full pool
+    };
+
+private:
+    std::vector<std::unique_ptr<Ring>> rings;       // never freed, reused after thread exit
+    std::vector<Ring*> free_rings;
+    std::map<uint32_t, std::string> thread_names;
+    std::atomic<bool> enabled;
+    std::atomic<int64_t> cleared_before_ns;
+    std::atomic<uint64_t> unowned_drops;
+    std::mutex mtx;                                 // ring pool and names only
+
+public:
+    EventTracer();
+
+    Ring* acquire_ring();
+    void release_ring(Ring* ring);
+    void note_drop() { unowned_drops.fetch_add(1, std::memory_order_relaxed); }
+    void name_thread(uint32_t tid, const std::string& name);
+
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    void set_enabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+
+    // Events that started at or after since_ns and after the last clear()
+    Snapshot snapshot(int64_t since_ns = 0);
+    void clear();
+};
+
+// {"traceEvents": [...]} with thread-name metadata and "X" events in µs
+std::string chrome_trace_json(const EventTracer::Snapshot& snapshot);
+
+extern EventTracer event_tracer;
+
+#endif
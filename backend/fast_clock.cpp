@@ -0,0 +1,105 @@
+#include "fast_clock.h"
+#include <cstring>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+FastClock::Calibration FastClock::calibration = {0, 0, 0, 0};
+
+#if defined(__x86_64__) || defined(__i386__)
+// CPUID.80000007H:EDX[8]: the TSC ticks at a constant rate in all P/C-states
+static bool has_invariant_tsc() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) return false;
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+}
+
+// TSC and CLOCK_MONOTONIC read as close together as possible: retries while
+// the bracketing monotonic reads are far apart (preemption, VM exits)
+static void paired_read(uint64_t& tsc, int64_t& ns) {
+    int64_t best_gap = INT64_MAX;
+    for (int attempt = 0; attempt < 16; attempt++) {
+        int64_t before = FastClock::monotonic_ns();
+        uint64_t t = __rdtsc();
+        int64_t after = FastClock::monotonic_ns();
+        if (after - before < best_gap) {
+            best_gap = after - before;
+            tsc = t;
+            ns = before + (after - before) / 2;
+        }
+    }
+}
+#endif
+
+void FastClock::calibrate(int window_ms) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (!has_invariant_tsc() || window_ms <= 0) return;
+
+    uint64_t tsc_start = 0, tsc_end = 0;
+    int64_t ns_start = 0, ns_end = 0;
+    paired_read(tsc_start, ns_start);
+    std::this_thread::sleep_for(std::chrono::milliseconds(window_ms));
+    paired_read(tsc_end, ns_end);
+    if (tsc_end <= tsc_start || ns_end <= ns_start) return;
+
+    // mult / 2^shift = ns per tick; 32 fractional bits keep the error far
+    // below a nanosecond per second while the 128-bit product cannot overflow
+    const uint32_t shift = 32;
+    double ns_per_tick = static_cast<double>(ns_end - ns_start) / static_cast<double>(tsc_end - tsc_start);
+    Calibration c{};
+    paired_read(c.base_tsc, c.base_ns);
+    c.mult = static_cast<uint64_t>(ns_per_tick * static_cast<double>(1ull << shift));
+    c.shift = shift;
+    calibration = c;
+#else
+    (void)window_ms;
+#endif
+}
+
+namespace {
+// Calibrate before main() so request threads never race the update
+struct CalibrateAtStartup {
+    CalibrateAtStartup() { FastClock::calibrate(); }
+} calibrate_at_startup;
+}
+
+// ===== WALL CLOCK FORMATTING =====
+
+struct WallClockCache {
+    int64_t second = -1;
+    char prefix[20];     // "YYYY-mm-dd HH:MM:SS"
+};
+
+size_t format_wall_clock(int64_t epoch_us, bool micros, char* out) {
+    thread_local WallClockCache cache;
+    int64_t second = epoch_us / 1000000;
+    if (second != cache.second) {
+        std::time_t t = static_cast<std::time_t>(second);
+        std::tm local{};
+        localtime_r(&t, &local);
+        std::strftime(cache.prefix, sizeof(cache.prefix), "%Y-%m-%d %H:%M:%S", &local);
+        cache.second = second;
+    }
+
+    std::memcpy(out, cache.prefix, 19);
+    if (!micros) {
+        out[19] = '\0';
+        return 19;
+    }
+    uint32_t fraction = static_cast<uint32_t>(epoch_us % 1000000);
+    out[19] = '.';
+    for (int i = 25; i >= 20; i--) {
+        out[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    out[26] = '\0';
+    return 26;
+}
+
+std::string format_wall_clock(int64_t epoch_us, bool micros) {
+    char buffer[32];
+    size_t length = format_wall_clock(epoch_us, micros, buffer);
+    return std::string(buffer, length);
+}
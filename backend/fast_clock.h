@@ -0,0 +1,70 @@
+#ifndef FAST_CLOCK_H
+#define FAST_CLOCK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Monotonic clock for durations on hot paths. With an invariant TSC, now()
+// is rdtsc scaled by a factor calibrated against CLOCK_MONOTONIC at startup;
+// otherwise it is CLOCK_MONOTONIC, which glibc serves from the vDSO. Both
+// paths share the CLOCK_MONOTONIC epoch, so time points from before and
+// after calibration compare correctly.
+struct FastClock {
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<FastClock>;
+    static constexpr bool is_steady = true;
+
+    // ns = base_ns + ((tsc - base_tsc) * mult) >> shift; mult == 0 until calibrated
+    struct Calibration {
+        uint64_t base_tsc;
+        int64_t base_ns;
+        uint64_t mult;
+        uint32_t shift;
+    };
+    static Calibration calibration;
+
+    static int64_t monotonic_ns() noexcept {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    static time_point now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        if (calibration.mult != 0) {
+            uint64_t delta = __rdtsc() - calibration.base_tsc;
+            unsigned __int128 scaled = static_cast<unsigned __int128>(delta) * calibration.mult;
+            return time_point(duration(calibration.base_ns + static_cast<int64_t>(scaled >> calibration.shift)));
+        }
+#endif
+        return time_point(duration(monotonic_ns()));
+    }
+
+    // True when now() reads the TSC
+    static bool using_tsc() noexcept { return calibration.mult != 0; }
+    // Calibrates against CLOCK_MONOTONIC over `window_ms`; runs once at startup
+    static void calibrate(int window_ms = 25);
+};
+
+// Wall-clock microseconds since the epoch (CLOCK_REALTIME through the vDSO)
+inline int64_t wall_clock_us() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+// "YYYY-mm-dd HH:MM:SS[.uuuuuu]" in local time. The date/time prefix is
+// cached per thread for the current second, so only the first call in a
+// second pays for localtime_r.
+std::string format_wall_clock(int64_t epoch_us, bool micros = false);
+// Writes the same text into out (at least 27 bytes); returns its length
+size_t format_wall_clock(int64_t epoch_us, bool micros, char* out);
+
+#endif
@@ -1,4 +1,5 @@
 #include "file_system.h"
+#include "metrics.h"
 #include <sstream>
 #include <iomanip>
 
@@ -7,8 +8,23 @@ FileSystem::FileSystem(int total_blks, int blk_size)
     
     data_blocks.resize(total_blocks, false);
     
-    // Create root directory
-    createDirectory("/");
+    // Create root directory; silently, as the global file system is built
+    // during static initialization, before any std::cout redirect
+    directories["/"] = std::vector<DirectoryEntry>();
+}
+
+enum FsOperation { FS_CREATE, FS_WRITE, FS_READ, FS_DELETE };
+
+// The labelled counters are looked up once; each operation is then one
+// atomic increment
+static void count_fs_operation(FsOperation operation) {
+    static Counter* counters[] = {
+        &metrics_registry.counter("fs_operations_total", "File system operations", {{"operation", "create"}}),
+        &metrics_registry.counter("fs_operations_total", "File system operations", {{"operation", "write"}}),
+        &metrics_registry.counter("fs_operations_total", "File system operations", {{"operation", "read"}}),
+        &metrics_registry.counter("fs_operations_total", "File system operations", {{"operation", "delete"}}),
+    };
+    counters[operation]->inc();
 }
 
 bool FileSystem::createDirectory(const std::string& path) {
@@ -23,6 +39,7 @@ bool FileSystem::createDirectory(const std::string& path) {
 }
 
 bool FileSystem::createFile(const std::string& path, int owner_id) {
+    count_fs_operation(FS_CREATE);
     // Extract directory and filename
     size_t last_slash = path.find_last_of('/');
     std::string dir_path = (last_slash == 0) ? "/" : path.substr(0, last_slash);
@@ -53,6 +70,7 @@ bool FileSystem::createFile(const std::string& path, int owner_id) {
 }
 
 bool FileSystem::writeFile(const std::string& path, const std::string& data) {
+    count_fs_operation(FS_WRITE);
     int inode_num = findInode(path);
     if (inode_num == -1) {
         std::cout << "File not found: " << path << "\n";
@@ -89,6 +107,7 @@ bool FileSystem::writeFile(const std::string& path, const std::string& data) {
 }
 
 std::string FileSystem::readFile(const std::string& path) {
+    count_fs_operation(FS_READ);
     int inode_num = findInode(path);
     if (inode_num == -1) {
         std::cout << "File not found: " << path << "\n";
@@ -112,6 +131,7 @@ std::string FileSystem::readFile(const std::string& path) {
 }
 
 bool FileSystem::deleteFile(const std::string& path) {
+    count_fs_operation(FS_DELETE);
     size_t last_slash = path.find_last_of('/');
     std::string dir_path = (last_slash == 0) ? "/" : path.substr(0, last_slash);
     std::string filename = path.substr(last_slash + 1);
@@ -186,18 +206,25 @@ double FileSystem::getDiskUtilization() {
 }
 
 int FileSystem::allocateBlock() {
+    static Counter& allocated = metrics_registry.counter("fs_blocks_allocated_total", "Data blocks allocated");
+    static Counter& failures = metrics_registry.counter("fs_allocation_failures_total",
+                                                        "Block allocations that found no free block");
     for (int i = 0; i < total_blocks; i++) {
         if (!data_blocks[i]) {
             data_blocks[i] = true;
+            allocated.inc();
             return i;
         }
     }
+    failures.inc();
     return -1; // No free blocks
 }
 
 void FileSystem::freeBlock(int block_number) {
+    static Counter& freed = metrics_registry.counter("fs_blocks_freed_total", "Data blocks freed");
     if (block_number >= 0 && block_number < total_blocks) {
         data_blocks[block_number] = false;
+        freed.inc();
     }
 }
 
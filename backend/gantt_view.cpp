@@ -0,0 +1,121 @@
+#include "gantt_view.h"
+#include <algorithm>
+#include <unordered_map>
+
+GanttRange gantt_candidates(const std::vector<GanttEntry>& chart, int max_slice, int from, int to) {
+    auto by_start = [](const GanttEntry& entry, long long time) { return entry.start_time < time; };
+    GanttRange range;
+    range.begin = std::lower_bound(chart.begin(), chart.end(), static_cast<long long>(from) - max_slice, by_start) -
+                  chart.begin();
+    range.end = std::lower_bound(chart.begin() + range.begin, chart.end(), static_cast<long long>(to), by_start) -
+                chart.begin();
+    return range;
+}
+
+GanttWindow gantt_window(const std::vector<GanttEntry>& chart, int max_slice, int from, int to) {
+    GanttWindow window;
+    if (to <= from) return window;
+    GanttRange range = gantt_candidates(chart, max_slice, from, to);
+    auto by_start = [](const GanttEntry& entry, int time) { return entry.start_time < time; };
+    size_t split = std::lower_bound(chart.begin() + range.begin, chart.begin() + range.end, from, by_start) -
+                   chart.begin();
+    for (size_t i = range.begin; i < split; i++) {
+        if (gantt_overlaps(chart[i], from, to)) window.head.push_back(i);
+    }
+    window.tail.begin = split;
+    window.tail.end = range.end;
+    return window;
+}
+
+namespace {
+
+// One core's row of the downsampled view
+struct Lane {
+    long long bucket = -1;
+    std::unordered_map<int, std::pair<long long, uint32_t>> run_time;   // pid -> (time, name) in `bucket`
+    long long last = -1;                                                 // this core's latest output entry
+};
+
+} // namespace
+
+std::vector<GanttEntry> downsample_gantt(const std::vector<GanttEntry>& chart, int max_slice,
+                                         int from, int to, int buckets) {
+    std::vector<GanttEntry> view;
+    if (to <= from || buckets <= 0) {
+        return view;
+    }
+    const long long span = static_cast<long long>(to) - from;
+    const long long count = std::min<long long>(buckets, span);
+    // Bucket k covers [boundary(k), boundary(k + 1))
+    auto boundary = [&](long long k) { return static_cast<int>(from + (span * k + count - 1) / count); };
+    auto bucket_of = [&](int time) { return (static_cast<long long>(time) - from) * count / span; };
+
+    std::vector<Lane> lanes;
+    auto emit = [&](Lane& lane, int core, int pid, uint32_t name, int start, int end) {
+        if (lane.last >= 0) {
+            GanttEntry& last = view[lane.last];
+            if (last.process_id == pid && last.end_time == start) {
+                last.end_time = end;
+                return;
+            }
+        }
+        lane.last = static_cast<long long>(view.size());
+        view.emplace_back(pid, name, start, end, core);
+    };
+    // Ends the lane's current bucket with its longest-running process
+    auto close_bucket = [&](Lane& lane, int core) {
+        if (lane.bucket < 0 || lane.run_time.empty()) {
+            return;
+        }
+        auto best = lane.run_time.begin();
+        for (auto it = lane.run_time.begin(); it != lane.run_time.end(); ++it) {
+            if (it->second.first > best->second.first ||
+                (it->second.first == best->second.first && it->first < best->first)) {
+                best = it;
+            }
+        }
+        emit(lane, core, best->first, best->second.second, boundary(lane.bucket), boundary(lane.bucket + 1));
+        lane.run_time.clear();
+    };
+
+    GanttRange range = gantt_candidates(chart, max_slice, from, to);
+    for (size_t i = range.begin; i < range.end; i++) {
+        const GanttEntry& entry = chart[i];
+        if (!gantt_overlaps(entry, from, to)) continue;
+        if (entry.core >= static_cast<int>(lanes.size())) lanes.resize(entry.core + 1);
+        Lane& lane = lanes[entry.core];
+        int start = std::max(entry.start_time, from);
+        int end = std::min(entry.end_time, to);
+        long long first = bucket_of(start);
+        long long last = bucket_of(end - 1);
+
+        if (lane.bucket != first) {
+            close_bucket(lane, entry.core);
+            lane.bucket = first;
+        }
+        if (first == last) {
+            auto& slot = lane.run_time[entry.process_id];
+            slot.first += end - start;
+            slot.second = entry.name_id;
+            continue;
+        }
+        // The entry fills every bucket strictly between its first and last
+        auto& slot = lane.run_time[entry.process_id];
+        slot.first += boundary(first + 1) - start;
+        slot.second = entry.name_id;
+        close_bucket(lane, entry.core);
+        if (last > first + 1) {
+            emit(lane, entry.core, entry.process_id, entry.name_id, boundary(first + 1), boundary(last));
+        }
+        lane.bucket = last;
+        lane.run_time[entry.process_id] = {end - boundary(last), entry.name_id};
+    }
+    for (size_t core = 0; core < lanes.size(); core++) {
+        close_bucket(lanes[core], static_cast<int>(core));
+    }
+
+    std::stable_sort(view.begin(), view.end(), [](const GanttEntry& a, const GanttEntry& b) {
+        return a.start_time != b.start_time ? a.start_time < b.start_time : a.core < b.core;
+    });
+    return view;
+}
@@ -0,0 +1,50 @@
+#ifndef GANTT_VIEW_H
+#define GANTT_VIEW_H
+
+#include "process_scheduler.h"
+#include <cstddef>
+#include <vector>
+
+// Windowed reads of a Gantt chart (ProcessScheduler::getGanttChart()), for
+// schedules with millions of slices. `max_slice` is the chart's longest
+// entry (getGanttMaxSlice()): an entry that starts more than max_slice
+// before a window cannot reach into it, so a window is found by binary
+// search on start time.
+
+struct GanttRange {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+// Entries [begin, end) include every entry overlapping [from, to), plus
+// possibly some that end at or before `from`
+GanttRange gantt_candidates(const std::vector<GanttEntry>& chart, int max_slice, int from, int to);
+
+inline bool gantt_overlaps(const GanttEntry& entry, int from, int to) {
+    return entry.end_time > from && entry.start_time < to;
+}
+
+// Exactly the entries overlapping [from, to), in chart order, with O(1)
+// access by position. Those starting before `from` (at most one per core)
+// are listed in `head`; every entry of `tail`, which starts in [from, to),
+// overlaps, so a page at any offset is reached without a scan.
+struct GanttWindow {
+    std::vector<size_t> head;
+    GanttRange tail;
+
+    size_t size() const { return head.size() + (tail.end - tail.begin); }
+    size_t operator[](size_t k) const { return k < head.size() ? head[k] : tail.begin + (k - head.size()); }
+};
+
+GanttWindow gantt_window(const std::vector<GanttEntry>& chart, int max_slice, int from, int to);
+
+// [from, to) at `buckets` columns per core. Each core's window is split into
+// equal buckets, a bucket shows the process that ran longest in it, and runs
+// of buckets showing the same process merge into one entry. Idle buckets are
+// left out. Entries start and end on bucket boundaries and come in chart
+// order. With no more buckets than time units the result is the exact
+// schedule, clipped to the window.
+std::vector<GanttEntry> downsample_gantt(const std::vector<GanttEntry>& chart, int max_slice,
+                                         int from, int to, int buckets);
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Binary min-heap over ids 0..capacity-1 that knows where each id sits, so a
+// queued id's key can be changed in O(log n) (decrease-key and increase-key)
+// and membership is O(1). Equal keys come out lowest id first.
+template <typename Key>
+class IndexedMinHeap {
+private:
+    std::vector<int> heap;       // ids in heap order
+    std::vector<int> position;   // id -> index in heap, -1 when absent
+    std::vector<Key> keys;       // id -> key, valid while queued
+
+    bool less(int a, int b) const {
+        if (keys[a] < keys[b]) return true;
+        if (keys[b] < keys[a]) return false;
+        return a < b;
+    }
+
+    void place(size_t index, int id) {
+        heap[index] = id;
+        position[id] = static_cast<int>(index);
+    }
+
+    void sift_up(size_t index) {
+        int id = heap[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!less(id, heap[parent])) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, id);
+    }
+
+    void sift_down(size_t index) {
+        int id = heap[index];
+        size_t size = heap.size();
+        while (true) {
+            size_t child = 2 * index + 1;
+            if (child >= size) break;
+            if (child + 1 < size && less(heap[child + 1], heap[child])) child++;
+            if (!less(heap[child], id)) break;
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, id);
+    }
+
+public:
+    explicit IndexedMinHeap(size_t capacity = 0) : position(capacity, -1), keys(capacity) {
+        heap.reserve(capacity);
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool contains(int id) const { return position[id] >= 0; }
+    int top() const { return heap.front(); }
+    const Key& key(int id) const { return keys[id]; }
+
+    void push(int id, Key key) {
+        keys[id] = std::move(key);
+        heap.push_back(id);
+        sift_up(heap.size() - 1);
+    }
+
+    int pop() {
+        int id = heap.front();
+        erase(id);
+        return id;
+    }
+
+    void erase(int id) {
+        size_t index = static_cast<size_t>(position[id]);
+        int last = heap.back();
+        heap.pop_back();
+        position[id] = -1;
+        if (last == id) return;
+        place(index, last);
+        sift_down(index);
+        sift_up(static_cast<size_t>(position[last]));
+    }
+
+    // Re-keys a queued id in either direction
+    void update(int id, Key key) {
+        bool decreased = key < keys[id];
+        keys[id] = std::move(key);
+        if (decreased) sift_up(static_cast<size_t>(position[id]));
+        else sift_down(static_cast<size_t>(position[id]));
+    }
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "ipc_manager.h"
+#include "metrics.h"
 #include <stdexcept>
 #include <cstring>
 #include <iostream>
@@ -146,8 +147,18 @@ bool IPCManager::sendMessage(int queue_id, int sender, int receiver, const strin
         return false;
     }
     
+    static Counter& sent_ok = metrics_registry.counter("ipc_messages_sent_total", "IPC messages sent",
+                                                       {{"result", "ok"}});
+    static Counter& sent_full = metrics_registry.counter("ipc_messages_sent_total", "IPC messages sent",
+                                                         {{"result", "queue_full"}});
+    static Counter& sent_bytes = metrics_registry.counter("ipc_message_bytes_total", "IPC message payload bytes sent");
     Message msg(sender, receiver, content, next_message_id++);
-    return it->second.sendMessage(msg);
+    bool sent = it->second.sendMessage(msg);
+    (sent ? sent_ok : sent_full).inc();
+    if (sent) {
+        sent_bytes.inc(content.size());
+    }
+    return sent;
 }
 
 Message IPCManager::receiveMessage(int queue_id, int receiver) {
@@ -156,11 +167,20 @@ Message IPCManager::receiveMessage(int queue_id, int receiver) {
         throw runtime_error("Message queue not found: " + to_string(queue_id));
     }
     
-    return it->second.receiveMessage(receiver);
+    static Counter& received = metrics_registry.counter("ipc_messages_received_total", "IPC messages received");
+    Message msg = it->second.receiveMessage(receiver);
+    received.inc();
+    return msg;
 }
 
 void* IPCManager::createSharedMemory(const string& name, size_t size) {
-    return shared_memory.createSegment(name, size);
+    static Counter& created = metrics_registry.counter("ipc_shared_memory_segments_created_total",
+                                                       "Shared memory segments created");
+    void* segment = shared_memory.createSegment(name, size);
+    if (segment) {
+        created.inc();
+    }
+    return segment;
 }
 
 void* IPCManager::accessSharedMemory(const string& name) {
@@ -0,0 +1,189 @@
+#include "job_manager.h"
+#include <algorithm>
+#include <exception>
+
+JobManager job_manager;
+
+static long long now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const char* job_status_name(JobStatus status) {
+    switch (status) {
+        case JobStatus::QUEUED: return "QUEUED";
+        case JobStatus::RUNNING: return "RUNNING";
+        case JobStatus::SUCCEEDED: return "SUCCEEDED";
+        case JobStatus::FAILED: return "FAILED";
+        case JobStatus::CANCELLED: return "CANCELLED";
+    }
+    return "UNKNOWN";
+}
+
+// ===== JOB CONTEXT =====
+
+void JobContext::set_progress(double fraction, const std::string& message) {
+    std::lock_guard<std::mutex> lock(mtx);
+    record.info.progress = std::min(1.0, std::max(0.0, fraction));
+    if (!message.empty()) {
+        record.info.message = message;
+    }
+}
+
+bool JobContext::is_cancelled() const {
+    return record.cancel_requested.load(std::memory_order_relaxed);
+}
+
+const std::atomic<bool>& JobContext::cancel_flag() const {
+    return record.cancel_requested;
+}
+
+// ===== JOB MANAGER =====
+
+JobManager::JobManager(size_t workers, size_t max_queue, size_t retained)
+    : pool(std::make_unique<WorkerPool>(workers, max_queue)), next_job_id(1),
+      max_retained(retained) {}
+
+JobManager::~JobManager() {
+    shutdown();
+}
+
+void JobManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto& [id, record] : jobs) {
+            record->cancel_requested = true;
+        }
+    }
+    pool->shutdown();
+}
+
+uint64_t JobManager::submit(const std::string& type, const Json::Value& params, JobFunction fn) {
+    auto record = std::make_shared<JobRecord>();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        record->info.id = next_job_id++;
+        record->info.type = type;
+        record->info.params = params;
+        record->info.submitted_ms = now_ms();
+        record->info.message = "Queued";
+        jobs[record->info.id] = record;
+        prune_finished();
+    }
+
+    bool queued = pool->submit([this, record, fn]() { run_job(record, fn); });
+    if (!queued) {
+        std::lock_guard<std::mutex> lock(mtx);
+        jobs.erase(record->info.id);
+        return 0;
+    }
+    return record->info.id;
+}
+
+void JobManager::run_job(const std::shared_ptr<JobRecord>& record, const JobFunction& fn) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (record->info.status == JobStatus::CANCELLED) return;
+        record->info.status = JobStatus::RUNNING;
+        record->info.started_ms = now_ms();
+        record->info.message = "Running";
+    }
+
+    JobContext context(*record, mtx);
+    Json::Value result;
+    std::string error;
+    bool failed = false;
+    try {
+        result = fn(context);
+    } catch (const std::exception& e) {
+        failed = true;
+        error = e.what();
+    } catch (...) {
+        failed = true;
+        error = "Unknown error";
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    record->info.finished_ms = now_ms();
+    record->info.result = result;
+    if (failed) {
+        record->info.status = JobStatus::FAILED;
+        record->info.error = error;
+        record->info.message = "Failed";
+    } else if (record->cancel_requested) {
+        record->info.status = JobStatus::CANCELLED;
+        record->info.message = "Cancelled";
+    } else {
+        record->info.status = JobStatus::SUCCEEDED;
+        record->info.progress = 1.0;
+        record->info.message = "Completed";
+    }
+}
+
+bool JobManager::get(uint64_t id, JobInfo& out) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) return false;
+    out = it->second->info;
+    return true;
+}
+
+std::vector<JobInfo> JobManager::list() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<JobInfo> result;
+    result.reserve(jobs.size());
+    for (const auto& [id, record] : jobs) {
+        JobInfo info = record->info;
+        info.result = Json::Value();   // listings omit potentially large results
+        result.push_back(std::move(info));
+    }
+    return result;
+}
+
+bool JobManager::cancel(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) return false;
+
+    JobRecord& record = *it->second;
+    if (record.info.status == JobStatus::QUEUED) {
+        record.cancel_requested = true;
+        record.info.status = JobStatus::CANCELLED;
+        record.info.finished_ms = now_ms();
+        record.info.message = "Cancelled before start";
+        return true;
+    }
+    if (record.info.status == JobStatus::RUNNING) {
+        record.cancel_requested = true;
+        record.info.message = "Cancellation requested";
+        return true;
+    }
+    return false;
+}
+
+size_t JobManager::queued() const {
+    return pool->pending();
+}
+
+size_t JobManager::running() const {
+    return pool->active();
+}
+
+size_t JobManager::queue_capacity() const {
+    return pool->capacity();
+}
+
+// Drops the oldest finished jobs once more than max_retained are kept;
+// queued and running jobs are never dropped. Runs on each submit.
+// Called with mtx held.
+void JobManager::prune_finished() {
+    if (jobs.size() <= max_retained) return;
+    for (auto it = jobs.begin(); it != jobs.end() && jobs.size() > max_retained;) {
+        JobStatus status = it->second->info.status;
+        if (status != JobStatus::QUEUED && status != JobStatus::RUNNING) {
+            it = jobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
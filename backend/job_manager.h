@@ -0,0 +1,94 @@
+#ifndef JOB_MANAGER_H
+#define JOB_MANAGER_H
+
+#include "worker_pool.h"
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class JobStatus {
+    QUEUED, RUNNING, SUCCEEDED, FAILED, CANCELLED
+};
+
+const char* job_status_name(JobStatus status);
+
+struct JobRecord;
+
+// Handle given to a running job for progress reporting and cooperative
+// cancellation. Jobs should poll is_cancelled() between units of work.
+class JobContext {
+private:
+    JobRecord& record;
+    std::mutex& mtx;
+
+public:
+    JobContext(JobRecord& rec, std::mutex& m) : record(rec), mtx(m) {}
+
+    void set_progress(double fraction, const std::string& message = "");
+    bool is_cancelled() const;
+    const std::atomic<bool>& cancel_flag() const;
+};
+
+// Snapshot of a job returned to callers (the live record stays internal)
+struct JobInfo {
+    uint64_t id = 0;
+    std::string type;
+    JobStatus status = JobStatus::QUEUED;
+    double progress = 0.0;
+    std::string message;
+    std::string error;
+    Json::Value params;
+    Json::Value result;
+    long long submitted_ms = 0;
+    long long started_ms = 0;
+    long long finished_ms = 0;
+};
+
+struct JobRecord {
+    JobInfo info;
+    std::atomic<bool> cancel_requested{false};
+};
+
+class JobManager {
+public:
+    using JobFunction = std::function<Json::Value(JobContext&)>;
+
+private:
+    std::map<uint64_t, std::shared_ptr<JobRecord>> jobs;
+    std::unique_ptr<WorkerPool> pool;
+    mutable std::mutex mtx;
+    uint64_t next_job_id;
+    size_t max_retained;
+
+    void run_job(const std::shared_ptr<JobRecord>& record, const JobFunction& fn);
+    void prune_finished();
+
+public:
+    JobManager(size_t workers = 2, size_t max_queue = 16, size_t max_retained = 256);
+    ~JobManager();
+
+    // Returns the new job id, or 0 when the job queue is full.
+    uint64_t submit(const std::string& type, const Json::Value& params, JobFunction fn);
+    bool get(uint64_t id, JobInfo& out) const;
+    std::vector<JobInfo> list() const;
+
+    // Queued jobs are cancelled immediately; running jobs are flagged and
+    // stop at their next cancellation check.
+    bool cancel(uint64_t id);
+
+    size_t queued() const;
+    size_t running() const;
+    size_t queue_capacity() const;
+    void shutdown();
+};
+
+extern JobManager job_manager;
+
+#endif
@@ -0,0 +1,185 @@
+#include "lock_profiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+static bool profiling_from_env() {
+    const char* value = std::getenv("CLOUD_LOCK_PROFILING");
+    return value && std::strcmp(value, "0") != 0 && *value != '\0';
+}
+
+std::atomic<bool> lock_profiling_enabled{profiling_from_env()};
+
+// Registry of live mutexes; function-local so globals in any translation
+// unit can register during static initialization
+static std::mutex& registry_mutex() {
+    static std::mutex mtx;
+    return mtx;
+}
+
+static std::vector<ProfiledMutex*>& registry() {
+    static std::vector<ProfiledMutex*> mutexes;
+    return mutexes;
+}
+
+static void atomic_max(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+static size_t hold_bucket(int64_t held_ns) {
+    int64_t bound_ns = 1000;
+    for (size_t i = 0; i + 1 < LOCK_HOLD_BUCKETS; i++, bound_ns *= 4) {
+        if (held_ns < bound_ns) return i;
+    }
+    return LOCK_HOLD_BUCKETS - 1;
+}
+
+static int64_t now_ns() {
+    return FastClock::now().time_since_epoch().count();
+}
+
+// ===== PROFILED MUTEX =====
+
+ProfiledMutex::ProfiledMutex(const char* lock_name) : name(lock_name) {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    registry().push_back(this);
+}
+
+ProfiledMutex::~ProfiledMutex() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    auto& mutexes = registry();
+    mutexes.erase(std::remove(mutexes.begin(), mutexes.end(), this), mutexes.end());
+}
+
+void ProfiledMutex::lock_profiled(const char* file, int line) {
+    acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (pthread_mutex_trylock(&m) == 0) {
+        acquired_ns = now_ns();
+        return;
+    }
+
+    int64_t started = now_ns();
+    pthread_mutex_lock(&m);
+    int64_t acquired = now_ns();
+    acquired_ns = acquired;
+
+    uint64_t waited = static_cast<uint64_t>(acquired - started);
+    contended.fetch_add(1, std::memory_order_relaxed);
+    wait_ns.fetch_add(waited, std::memory_order_relaxed);
+    atomic_max(max_wait_ns, waited);
+
+    std::lock_guard<std::mutex> lock(waiters_mtx);
+    auto& site = waiters[{file, line}];
+    site.first++;
+    site.second += waited;
+}
+
+bool ProfiledMutex::try_lock() {
+    if (pthread_mutex_trylock(&m) != 0) return false;
+    if (lock_profiling_enabled.load(std::memory_order_relaxed)) {
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+        acquired_ns = now_ns();
+    } else {
+        acquired_ns = 0;
+    }
+    return true;
+}
+
+void ProfiledMutex::record_hold(int64_t held_ns) {
+    uint64_t held = static_cast<uint64_t>(std::max<int64_t>(0, held_ns));
+    hold_ns.fetch_add(held, std::memory_order_relaxed);
+    atomic_max(max_hold_ns, held);
+    hold_buckets[hold_bucket(held_ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+LockProfile ProfiledMutex::profile(size_t top_waiters) {
+    LockProfile p;
+    p.name = name;
+    p.acquisitions = acquisitions.load(std::memory_order_relaxed);
+    p.contended = contended.load(std::memory_order_relaxed);
+    p.total_wait_ms = wait_ns.load(std::memory_order_relaxed) / 1e6;
+    p.max_wait_ms = max_wait_ns.load(std::memory_order_relaxed) / 1e6;
+    p.total_hold_ms = hold_ns.load(std::memory_order_relaxed) / 1e6;
+    p.max_hold_ms = max_hold_ns.load(std::memory_order_relaxed) / 1e6;
+
+    double bound_us = 1.0;
+    for (size_t i = 0; i < LOCK_HOLD_BUCKETS; i++, bound_us *= 4) {
+        double bound = i + 1 < LOCK_HOLD_BUCKETS ? bound_us : -1.0;   // -1 = +Inf
+        p.hold_histogram.emplace_back(bound, hold_buckets[i].load(std::memory_order_relaxed));
+    }
+
+    std::lock_guard<std::mutex> lock(waiters_mtx);
+    for (const auto& [site, stats] : waiters) {
+        const char* base = std::strrchr(site.first, '/');
+        LockWaiterStats w;
+        w.site = std::string(base ? base + 1 : site.first) + ":" + std::to_string(site.second);
+        w.count = stats.first;
+        w.wait_ms = stats.second / 1e6;
+        p.top_waiters.push_back(std::move(w));
+    }
+    std::sort(p.top_waiters.begin(), p.top_waiters.end(), [](const LockWaiterStats& a, const LockWaiterStats& b) {
+        return a.wait_ms > b.wait_ms;
+    });
+    if (p.top_waiters.size() > top_waiters) p.top_waiters.resize(top_waiters);
+    return p;
+}
+
+void ProfiledMutex::reset() {
+    acquisitions.store(0, std::memory_order_relaxed);
+    contended.store(0, std::memory_order_relaxed);
+    wait_ns.store(0, std::memory_order_relaxed);
+    max_wait_ns.store(0, std::memory_order_relaxed);
+    hold_ns.store(0, std::memory_order_relaxed);
+    max_hold_ns.store(0, std::memory_order_relaxed);
+    for (auto& bucket : hold_buckets) bucket.store(0, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(waiters_mtx);
+    waiters.clear();
+}
+
+// ===== REPORTING =====
+
+std::vector<LockProfile> lock_profiles(size_t top_waiters) {
+    std::vector<LockProfile> result;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex());
+        for (ProfiledMutex* m : registry()) {
+            result.push_back(m->profile(top_waiters));
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const LockProfile& a, const LockProfile& b) {
+        return a.total_wait_ms > b.total_wait_ms;
+    });
+    return result;
+}
+
+void reset_lock_profiles() {
+    std::lock_guard<std::mutex> lock(registry_mutex());
+    for (ProfiledMutex* m : registry()) {
+        m->reset();
+    }
+}
+
+void print_lock_report(std::ostream& out) {
+    out << "\nLOCK CONTENTION";
+    if (!lock_profiling_enabled.load(std::memory_order_relaxed)) {
+        out << " (profiling off; set CLOUD_LOCK_PROFILING=1 or PUT /api/locks/config)\n";
+        return;
+    }
+    out << ":\n";
+    out << "  " << std::left << std::setw(18) << "lock" << std::right
+        << std::setw(10) << "acquired" << std::setw(10) << "contended"
+        << std::setw(12) << "wait ms" << std::setw(12) << "max wait" << std::setw(12) << "hold ms" << "\n";
+    for (const auto& p : lock_profiles(3)) {
+        out << "  " << std::left << std::setw(18) << p.name << std::right
+            << std::setw(10) << p.acquisitions << std::setw(10) << p.contended
+            << std::fixed << std::setprecision(3)
+            << std::setw(12) << p.total_wait_ms << std::setw(12) << p.max_wait_ms
+            << std::setw(12) << p.total_hold_ms << "\n";
+        for (const auto& w : p.top_waiters) {
+            out << "      waiter " << w.site << ": " << w.count << " waits, " << w.wait_ms << " ms\n";
+        }
+    }
+    out << std::defaultfloat;
+}
@@ -0,0 +1,103 @@
+#ifndef LOCK_PROFILER_H
+#define LOCK_PROFILER_H
+
+#include "fast_clock.h"
+#include <pthread.h>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Named mutexes with contention profiling. Acquisitions first try_lock; only
+// a failed attempt counts as contended and is timed, so the uncontended path
+// stays a single atomic. Hold times are measured from acquisition to
+// unlock (which may happen on another thread, as with the readers' rw_mutex
+// hand-off). When profiling is off lock() is pthread_mutex_lock plus one
+// relaxed load.
+
+extern std::atomic<bool> lock_profiling_enabled;
+
+// Hold-time buckets: < 1us, < 4us, < 16us ... < 1s (powers of 4), >= 1s
+constexpr size_t LOCK_HOLD_BUCKETS = 12;
+
+struct LockWaiterStats {
+    std::string site;          // "file.cpp:123"
+    uint64_t count = 0;
+    double wait_ms = 0.0;
+};
+
+struct LockProfile {
+    std::string name;
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;
+    double total_wait_ms = 0.0;
+    double max_wait_ms = 0.0;
+    double total_hold_ms = 0.0;
+    double max_hold_ms = 0.0;
+    std::vector<std::pair<double, uint64_t>> hold_histogram;   // (upper bound us, count); last bound is +Inf
+    std::vector<LockWaiterStats> top_waiters;                  // by total wait, descending
+};
+
+class ProfiledMutex {
+private:
+    pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+    const char* name;
+    int64_t acquired_ns = 0;   // written by the holder; 0 = unprofiled acquisition
+
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> wait_ns{0};
+    std::atomic<uint64_t> max_wait_ns{0};
+    std::atomic<uint64_t> hold_ns{0};
+    std::atomic<uint64_t> max_hold_ns{0};
+    std::atomic<uint64_t> hold_buckets[LOCK_HOLD_BUCKETS] = {};
+
+    // Contended call sites, keyed by (file, line); only touched after a wait
+    std::mutex waiters_mtx;
+    std::map<std::pair<const char*, int>, std::pair<uint64_t, uint64_t>> waiters;   // count, wait ns
+
+    void lock_profiled(const char* file, int line);
+    void record_hold(int64_t held_ns);
+
+public:
+    explicit ProfiledMutex(const char* lock_name);
+    ~ProfiledMutex();
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    // The default arguments capture the caller's location for top waiters
+    void lock(const char* file = __builtin_FILE(), int line = __builtin_LINE()) {
+        if (!lock_profiling_enabled.load(std::memory_order_relaxed)) {
+            pthread_mutex_lock(&m);
+            acquired_ns = 0;
+            return;
+        }
+        lock_profiled(file, line);
+    }
+
+    void unlock() {
+        int64_t acquired = acquired_ns;
+        if (acquired != 0) {
+            acquired_ns = 0;
+            record_hold(FastClock::now().time_since_epoch().count() - acquired);
+        }
+        pthread_mutex_unlock(&m);
+    }
+
+    bool try_lock();
+
+    const char* lock_name() const { return name; }
+    LockProfile profile(size_t top_waiters = 5);
+    void reset();
+};
+
+// Every ProfiledMutex in the process, most contended (total wait) first
+std::vector<LockProfile> lock_profiles(size_t top_waiters = 5);
+void reset_lock_profiles();
+void print_lock_report(std::ostream& out);
+
+#endif
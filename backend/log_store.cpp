@@ -0,0 +1,319 @@
+#include "log_store.h"
+#include "fast_clock.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+LogStore log_store;
+
+static int64_t now_us() {
+    return wall_clock_us();
+}
+
+LogStore::LogStore(const std::string& path, size_t segment_bytes, size_t segments, size_t ring_size)
+    : base_path(path), max_segment_bytes(segment_bytes), max_segments(std::max<size_t>(1, segments)),
+      ring_capacity(std::max<size_t>(1, ring_size)), ring_head(0), next_rotation_id(1), next_seq(1),
+      opened(false) {}
+
+// "[YYYY-mm-dd HH:MM:SS] [TYPE#id] ACTION status..."
+bool LogStore::parse_line(const std::string& line, LogEntry& entry) {
+    entry.line = line;
+    if (line.size() < 22 || line[0] != '[') return false;
+
+    std::tm tm{};
+    if (std::sscanf(line.c_str() + 1, "%d-%d-%d %d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                    &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+        return false;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    tm.tm_isdst = -1;
+    entry.timestamp_us = static_cast<int64_t>(std::mktime(&tm)) * 1000000;
+
+    size_t tag_start = line.find("] [");
+    size_t tag_end = tag_start == std::string::npos ? tag_start : line.find(']', tag_start + 3);
+    if (tag_end == std::string::npos) return true;
+    std::string tag = line.substr(tag_start + 3, tag_end - tag_start - 3);
+    size_t hash = tag.find('#');
+    entry.thread_type = tag.substr(0, hash);
+    if (hash != std::string::npos) {
+        entry.thread_id = std::atoi(tag.c_str() + hash + 1);
+    }
+
+    size_t action_start = tag_end + 2;
+    if (action_start >= line.size()) return true;
+    size_t action_end = line.find(' ', action_start);
+    entry.action = line.substr(action_start, action_end - action_start);
+    if (action_end != std::string::npos) {
+        entry.status = line.substr(action_end + 1);
+    }
+    return true;
+}
+
+// ===== SEGMENTS AND INDEX =====
+
+void LogStore::index_entry(Segment& segment, uint64_t seq, int64_t timestamp_us, uint64_t offset) {
+    if (segment.count == 0) {
+        segment.first_seq = seq;
+        segment.first_timestamp_us = timestamp_us;
+    }
+    if ((seq - segment.first_seq) % INDEX_STRIDE == 0) {
+        segment.index.push_back({seq, timestamp_us, offset});
+    }
+    segment.last_timestamp_us = timestamp_us;
+    segment.count++;
+}
+
+// One-time scan of a file left by a previous run
+void LogStore::scan_segment(Segment& segment) {
+    std::ifstream in(segment.path);
+    std::string line;
+    uint64_t offset = 0;
+    while (std::getline(in, line)) {
+        LogEntry entry;
+        parse_line(line, entry);
+        index_entry(segment, next_seq++, entry.timestamp_us, offset);
+        offset += line.size() + 1;
+    }
+    segment.bytes = offset;
+}
+
+void LogStore::ensure_open() {
+    if (opened) return;
+    opened = true;
+
+    fs::path base(base_path);
+    fs::path dir = base.has_parent_path() ? base.parent_path() : fs::path(".");
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    // Rotated segments are named <base>.<rotation id>, oldest has the lowest id
+    std::vector<std::pair<uint64_t, std::string>> rotated;
+    std::string prefix = base.filename().string() + ".";
+    for (const auto& file : fs::directory_iterator(dir, ec)) {
+        std::string name = file.path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+        std::string suffix = name.substr(prefix.size());
+        if (!std::all_of(suffix.begin(), suffix.end(), ::isdigit)) continue;
+        rotated.emplace_back(std::stoull(suffix), file.path().string());
+    }
+    std::sort(rotated.begin(), rotated.end());
+
+    for (const auto& [id, path] : rotated) {
+        Segment segment;
+        segment.path = path;
+        scan_segment(segment);
+        segments.push_back(std::move(segment));
+        next_rotation_id = id + 1;
+    }
+
+    Segment current;
+    current.path = base_path;
+    scan_segment(current);
+    segments.push_back(std::move(current));
+
+    while (segments.size() > max_segments) {
+        fs::remove(segments.front().path, ec);
+        segments.pop_front();
+    }
+    active.open(base_path, std::ios::app);
+}
+
+void LogStore::rotate() {
+    active.close();
+    Segment& current = segments.back();
+    std::string rotated_path = base_path + "." + std::to_string(next_rotation_id++);
+    std::error_code ec;
+    fs::rename(base_path, rotated_path, ec);
+    current.path = rotated_path;
+
+    Segment fresh;
+    fresh.path = base_path;
+    segments.push_back(std::move(fresh));
+    while (segments.size() > max_segments) {
+        fs::remove(segments.front().path, ec);
+        segments.pop_front();
+    }
+    active.open(base_path, std::ios::trunc);
+}
+
+// ===== RING =====
+
+void LogStore::ring_push(const LogEntry& entry) {
+    if (ring.size() < ring_capacity) {
+        ring.push_back(entry);
+    } else {
+        ring[ring_head] = entry;
+        ring_head = (ring_head + 1) % ring_capacity;
+    }
+}
+
+// i-th oldest entry in the ring
+const LogEntry& LogStore::ring_at(size_t i) const {
+    return ring[(ring_head + i) % ring.size()];
+}
+
+uint64_t LogStore::ring_oldest_seq() const {
+    return next_seq - ring.size();
+}
+
+uint64_t LogStore::oldest_seq() const {
+    for (const auto& segment : segments) {
+        if (segment.count > 0) return segment.first_seq;
+    }
+    return next_seq;
+}
+
+uint64_t LogStore::append(const std::string& thread_type, int thread_id, const std::string& action,
+                          const std::string& status, const std::string& line) {
+    std::lock_guard<std::mutex> lock(mtx);
+    ensure_open();
+
+    LogEntry entry;
+    entry.seq = next_seq++;
+    entry.timestamp_us = now_us();
+    entry.thread_type = thread_type;
+    entry.thread_id = thread_id;
+    entry.action = action;
+    entry.status = status;
+    entry.line = line;
+    std::replace(entry.line.begin(), entry.line.end(), '\n', ' ');
+
+    Segment& segment = segments.back();
+    uint64_t offset = segment.bytes;
+    active << entry.line << '\n';
+    active.flush();
+    segment.bytes += entry.line.size() + 1;
+    index_entry(segment, entry.seq, entry.timestamp_us, offset);
+    ring_push(entry);
+
+    if (segment.bytes >= max_segment_bytes) {
+        rotate();
+    }
+    return entry.seq;
+}
+
+// ===== QUERIES =====
+
+std::vector<LogEntry> LogStore::read_files(uint64_t start_seq, size_t limit,
+                                           int64_t from_us, int64_t until_us) {
+    std::vector<LogEntry> result;
+    active.flush();
+    uint64_t seq = start_seq;
+
+    for (const auto& segment : segments) {
+        if (result.size() >= limit) break;
+        if (segment.count == 0 || seq >= segment.first_seq + segment.count) continue;
+        seq = std::max(seq, segment.first_seq);
+
+        // Last index point at or before seq
+        auto point = std::upper_bound(segment.index.begin(), segment.index.end(), seq,
+            [](uint64_t s, const IndexPoint& p) { return s < p.seq; });
+        --point;
+
+        std::ifstream in(segment.path);
+        in.seekg(static_cast<std::streamoff>(point->offset));
+        uint64_t current = point->seq;
+        std::string line;
+        while (result.size() < limit && current < segment.first_seq + segment.count &&
+               std::getline(in, line)) {
+            if (current >= seq) {
+                LogEntry entry;
+                parse_line(line, entry);
+                entry.seq = current;
+                if (until_us != 0 && entry.timestamp_us > until_us) {
+                    return result;
+                }
+                if (entry.timestamp_us >= from_us) {
+                    result.push_back(std::move(entry));
+                }
+            }
+            current++;
+        }
+        seq = current;
+    }
+    return result;
+}
+
+// First sequence number whose timestamp may be >= from_us
+uint64_t LogStore::seek_time(int64_t from_us) const {
+    for (const auto& segment : segments) {
+        if (segment.count == 0 || segment.last_timestamp_us < from_us) continue;
+        auto point = std::partition_point(segment.index.begin(), segment.index.end(),
+            [from_us](const IndexPoint& p) { return p.timestamp_us < from_us; });
+        if (point != segment.index.begin()) --point;
+        return point->seq;
+    }
+    return next_seq;
+}
+
+LogQueryResult LogStore::tail(size_t limit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    ensure_open();
+    LogQueryResult result;
+    result.first_seq = oldest_seq() < next_seq ? oldest_seq() : 0;
+    result.last_seq = next_seq - 1;
+
+    if (limit <= ring.size()) {
+        for (size_t i = ring.size() - limit; i < ring.size(); i++) {
+            result.entries.push_back(ring_at(i));
+        }
+        return result;
+    }
+    uint64_t available = next_seq - oldest_seq();
+    uint64_t start = next_seq - std::min<uint64_t>(limit, available);
+    result.entries = read_files(start, limit);
+    return result;
+}
+
+LogQueryResult LogStore::since(uint64_t cursor, size_t limit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    ensure_open();
+    LogQueryResult result;
+    result.first_seq = oldest_seq() < next_seq ? oldest_seq() : 0;
+    result.last_seq = next_seq - 1;
+
+    uint64_t start = std::max(cursor + 1, oldest_seq());
+    if (start >= next_seq) return result;
+
+    if (!ring.empty() && start >= ring_oldest_seq()) {
+        for (size_t i = start - ring_oldest_seq(); i < ring.size() && result.entries.size() < limit; i++) {
+            result.entries.push_back(ring_at(i));
+        }
+        return result;
+    }
+    result.entries = read_files(start, limit);
+    return result;
+}
+
+LogQueryResult LogStore::range(int64_t from_us, int64_t to_us, size_t limit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    ensure_open();
+    LogQueryResult result;
+    result.first_seq = oldest_seq() < next_seq ? oldest_seq() : 0;
+    result.last_seq = next_seq - 1;
+
+    if (!ring.empty() && from_us >= ring_at(0).timestamp_us) {
+        // Binary search for the first ring entry at or after from_us
+        size_t lo = 0;
+        size_t hi = ring.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (ring_at(mid).timestamp_us < from_us) lo = mid + 1;
+            else hi = mid;
+        }
+        for (size_t i = lo; i < ring.size() && result.entries.size() < limit; i++) {
+            if (ring_at(i).timestamp_us > to_us) break;
+            result.entries.push_back(ring_at(i));
+        }
+        return result;
+    }
+
+    // Entries read back from disk carry whole seconds
+    int64_t from_second = from_us - from_us % 1000000;
+    result.entries = read_files(seek_time(from_second), limit, from_second, to_us);
+    return result;
+}
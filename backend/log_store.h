@@ -0,0 +1,105 @@
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One simulation log line. seq is a cursor that increases by one per entry
+// across rotations; timestamp_us is wall-clock time since the epoch (second
+// resolution for entries read back from disk).
+struct LogEntry {
+    uint64_t seq = 0;
+    int64_t timestamp_us = 0;
+    std::string thread_type;
+    int thread_id = 0;
+    std::string action;
+    std::string status;
+    std::string line;
+};
+
+struct LogQueryResult {
+    std::vector<LogEntry> entries;
+    uint64_t first_seq = 0;     // oldest entry still retained (0 when empty)
+    uint64_t last_seq = 0;      // newest entry written
+};
+
+// Append-only simulation log: the newest entries stay in an in-memory ring
+// and older ones are read back from rotated files through a sparse index
+// (one offset every INDEX_STRIDE entries). Queries seek straight to the
+// nearest index point, so their cost depends on the entries returned, not
+// on the file size.
+class LogStore {
+public:
+    static constexpr size_t INDEX_STRIDE = 64;
+
+private:
+    struct IndexPoint {
+        uint64_t seq;
+        int64_t timestamp_us;
+        uint64_t offset;
+    };
+
+    struct Segment {
+        std::string path;
+        uint64_t first_seq = 0;
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        int64_t first_timestamp_us = 0;
+        int64_t last_timestamp_us = 0;
+        std::vector<IndexPoint> index;
+    };
+
+    std::string base_path;
+    size_t max_segment_bytes;
+    size_t max_segments;
+    size_t ring_capacity;
+
+    std::vector<LogEntry> ring;
+    size_t ring_head;                 // slot of the next write
+    std::deque<Segment> segments;     // oldest first, last one is active
+    uint64_t next_rotation_id;
+    uint64_t next_seq;
+    std::ofstream active;
+    bool opened;
+    mutable std::mutex mtx;
+
+    void ensure_open();
+    void scan_segment(Segment& segment);
+    void index_entry(Segment& segment, uint64_t seq, int64_t timestamp_us, uint64_t offset);
+    void rotate();
+    void ring_push(const LogEntry& entry);
+    const LogEntry& ring_at(size_t i) const;
+    uint64_t oldest_seq() const;
+    uint64_t ring_oldest_seq() const;
+    // Reads up to limit entries starting at start_seq, skipping entries older
+    // than from_us and stopping at one newer than until_us (when non-zero)
+    std::vector<LogEntry> read_files(uint64_t start_seq, size_t limit,
+                                     int64_t from_us = 0, int64_t until_us = 0);
+    uint64_t seek_time(int64_t from_us) const;
+
+public:
+    LogStore(const std::string& path = "./logs/simulation.log",
+             size_t segment_bytes = 4 * 1024 * 1024, size_t segments = 8,
+             size_t ring_size = 4096);
+
+    // Writes a formatted line; newlines in the line are flattened
+    uint64_t append(const std::string& thread_type, int thread_id, const std::string& action,
+                    const std::string& status, const std::string& line);
+
+    // Newest `limit` entries, oldest first
+    LogQueryResult tail(size_t limit);
+    // Entries after `cursor`, oldest first
+    LogQueryResult since(uint64_t cursor, size_t limit);
+    // Entries with from_us <= timestamp <= to_us, oldest first
+    LogQueryResult range(int64_t from_us, int64_t to_us, size_t limit);
+
+    static bool parse_line(const std::string& line, LogEntry& entry);
+};
+
+extern LogStore log_store;
+
+#endif
@@ -0,0 +1,262 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+MetricsRegistry metrics_registry;
+
+size_t next_metric_stripe() {
+    static std::atomic<size_t> next_stripe{0};
+    return next_stripe.fetch_add(1, std::memory_order_relaxed) % METRIC_STRIPES;
+}
+
+static void atomic_add(std::atomic<double>& target, double delta) {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+    }
+}
+
+// ===== METRIC TYPES =====
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& cell : cells) {
+        total += cell.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Gauge::add(double delta) {
+    atomic_add(current, delta);
+}
+
+Histogram::Histogram(std::vector<double> upper_bounds) : bounds(std::move(upper_bounds)) {
+    std::sort(bounds.begin(), bounds.end());
+    for (auto& stripe : stripes) {
+        stripe.buckets.reset(new std::atomic<uint64_t>[bounds.size() + 1]);
+        for (size_t i = 0; i <= bounds.size(); i++) {
+            stripe.buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Histogram::observe(double v) {
+    size_t index = std::lower_bound(bounds.begin(), bounds.end(), v) - bounds.begin();
+    Stripe& stripe = stripes[metric_stripe()];
+    stripe.buckets[index].fetch_add(1, std::memory_order_relaxed);
+    atomic_add(stripe.sum, v);
+}
+
+std::vector<uint64_t> Histogram::bucket_counts() const {
+    std::vector<uint64_t> counts(bounds.size() + 1, 0);
+    for (const auto& stripe : stripes) {
+        for (size_t i = 0; i < counts.size(); i++) {
+            counts[i] += stripe.buckets[i].load(std::memory_order_relaxed);
+        }
+    }
+    return counts;
+}
+
+uint64_t Histogram::count() const {
+    uint64_t total = 0;
+    for (uint64_t c : bucket_counts()) total += c;
+    return total;
+}
+
+double Histogram::sum() const {
+    double total = 0.0;
+    for (const auto& stripe : stripes) {
+        total += stripe.sum.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+const std::vector<double>& latency_buckets() {
+    static const std::vector<double> buckets = {
+        0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01,
+        0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+    };
+    return buckets;
+}
+
+// ===== REGISTRY =====
+
+static std::string escape_label_value(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+    return out;
+}
+
+std::string format_labels(const MetricLabels& labels) {
+    if (labels.empty()) return "";
+    std::string out = "{";
+    for (size_t i = 0; i < labels.size(); i++) {
+        if (i > 0) out += ",";
+        out += labels[i].first + "=\"" + escape_label_value(labels[i].second) + "\"";
+    }
+    out += "}";
+    return out;
+}
+
+MetricsRegistry::Family* MetricsRegistry::find_family(const std::string& name, Type type) const {
+    auto it = families.find(name);
+    if (it == families.end() || it->second->type != type) return nullptr;
+    return it->second.get();
+}
+
+// Called with the exclusive lock held
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, Type type, const std::string& help) {
+    auto& slot = families[name];
+    if (!slot) {
+        slot = std::make_unique<Family>();
+        slot->type = type;
+        slot->help = help;
+        family_order.push_back(name);
+    }
+    return *slot;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::string key = format_labels(labels);
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        if (Family* f = find_family(name, Type::COUNTER)) {
+            auto it = f->counters.find(key);
+            if (it != f->counters.end()) return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    auto& metric = family(name, Type::COUNTER, help).counters[key];
+    if (!metric) metric = std::make_unique<Counter>();
+    return *metric;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::string key = format_labels(labels);
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        if (Family* f = find_family(name, Type::GAUGE)) {
+            auto it = f->gauges.find(key);
+            if (it != f->gauges.end()) return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    auto& metric = family(name, Type::GAUGE, help).gauges[key];
+    if (!metric) metric = std::make_unique<Gauge>();
+    return *metric;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const MetricLabels& labels, const std::vector<double>& bounds) {
+    std::string key = format_labels(labels);
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        if (Family* f = find_family(name, Type::HISTOGRAM)) {
+            auto it = f->histograms.find(key);
+            if (it != f->histograms.end()) return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    Family& f = family(name, Type::HISTOGRAM, help);
+    if (f.bounds.empty()) f.bounds = bounds;
+    auto& metric = f.histograms[key];
+    if (!metric) metric = std::make_unique<Histogram>(f.bounds);
+    return *metric;
+}
+
+void MetricsRegistry::gauge_callback(const std::string& name, const std::string& help,
+                                     const MetricLabels& labels, std::function<double()> fn) {
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    family(name, Type::GAUGE, help).callbacks[format_labels(labels)] = std::move(fn);
+}
+
+static std::string format_value(double v) {
+    if (std::isinf(v)) return v > 0 ? "+Inf" : "-Inf";
+    if (std::isnan(v)) return "NaN";
+    std::ostringstream out;
+    out << std::setprecision(12) << v;
+    return out.str();
+}
+
+// Inserts an extra label into an already formatted label set
+static std::string with_label(const std::string& labels, const std::string& extra) {
+    if (labels.empty()) return "{" + extra + "}";
+    return labels.substr(0, labels.size() - 1) + "," + extra + "}";
+}
+
+template <typename Map>
+static std::vector<std::pair<std::string, typename Map::mapped_type::pointer>> sorted_entries(const Map& map) {
+    std::vector<std::pair<std::string, typename Map::mapped_type::pointer>> entries;
+    entries.reserve(map.size());
+    for (const auto& [key, metric] : map) entries.emplace_back(key, metric.get());
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+std::string MetricsRegistry::render() const {
+    // Metric objects are never removed, so pointers taken under the lock stay
+    // valid. Callbacks are copied and run after the lock is released because
+    // they may take module locks that are held while metrics are registered.
+    struct FamilySnapshot {
+        std::string name;
+        Type type;
+        std::string help;
+        std::vector<std::pair<std::string, Counter*>> counters;
+        std::vector<std::pair<std::string, Gauge*>> gauges;
+        std::vector<std::pair<std::string, Histogram*>> histograms;
+        std::vector<std::pair<std::string, std::function<double()>>> callbacks;
+    };
+
+    std::vector<FamilySnapshot> snapshot;
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        snapshot.reserve(family_order.size());
+        for (const auto& name : family_order) {
+            const Family& f = *families.at(name);
+            FamilySnapshot fs{name, f.type, f.help, sorted_entries(f.counters),
+                              sorted_entries(f.gauges), sorted_entries(f.histograms), {}};
+            fs.callbacks.assign(f.callbacks.begin(), f.callbacks.end());
+            std::sort(fs.callbacks.begin(), fs.callbacks.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+            snapshot.push_back(std::move(fs));
+        }
+    }
+
+    std::ostringstream out;
+    for (const auto& f : snapshot) {
+        const char* type = f.type == Type::COUNTER ? "counter"
+                         : f.type == Type::GAUGE ? "gauge" : "histogram";
+        out << "# HELP " << f.name << " " << f.help << "\n";
+        out << "# TYPE " << f.name << " " << type << "\n";
+
+        for (const auto& [key, counter] : f.counters) {
+            out << f.name << key << " " << counter->value() << "\n";
+        }
+        for (const auto& [key, gauge] : f.gauges) {
+            out << f.name << key << " " << format_value(gauge->value()) << "\n";
+        }
+        for (const auto& [key, fn] : f.callbacks) {
+            out << f.name << key << " " << format_value(fn()) << "\n";
+        }
+        for (const auto& [key, histogram] : f.histograms) {
+            std::vector<uint64_t> counts = histogram->bucket_counts();
+            const std::vector<double>& bounds = histogram->upper_bounds();
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < counts.size(); i++) {
+                cumulative += counts[i];
+                std::string le = i < bounds.size() ? format_value(bounds[i]) : "+Inf";
+                out << f.name << "_bucket" << with_label(key, "le=\"" + le + "\"") << " " << cumulative << "\n";
+            }
+            out << f.name << "_sum" << key << " " << format_value(histogram->sum()) << "\n";
+            out << f.name << "_count" << key << " " << cumulative << "\n";
+        }
+    }
+    return out.str();
+}
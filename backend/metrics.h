@@ -0,0 +1,129 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Label set in declaration order, e.g. {{"operation", "READ"}}
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Recording is lock-free. Hot metrics are striped across cache lines so
+// concurrent threads do not contend on a single atomic; stripes are summed
+// when the registry is scraped.
+constexpr size_t METRIC_STRIPES = 16;
+
+size_t next_metric_stripe();
+
+inline size_t metric_stripe() {
+    thread_local size_t stripe = METRIC_STRIPES;   // constant-initialized, no TLS guard
+    if (stripe == METRIC_STRIPES) stripe = next_metric_stripe();
+    return stripe;
+}
+
+struct alignas(64) MetricCell {
+    std::atomic<uint64_t> value{0};
+};
+
+class Counter {
+private:
+    MetricCell cells[METRIC_STRIPES];
+
+public:
+    void inc(uint64_t n = 1) {
+        cells[metric_stripe()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+};
+
+class Gauge {
+private:
+    std::atomic<double> current{0.0};
+
+public:
+    void set(double v) { current.store(v, std::memory_order_relaxed); }
+    void add(double delta);
+    void inc() { add(1.0); }
+    void dec() { add(-1.0); }
+    double value() const { return current.load(std::memory_order_relaxed); }
+};
+
+// Fixed-bucket histogram. Each stripe owns its bucket counts and sum.
+class Histogram {
+private:
+    struct alignas(64) Stripe {
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;   // bounds.size() + 1
+        std::atomic<double> sum{0.0};
+    };
+
+    std::vector<double> bounds;
+    Stripe stripes[METRIC_STRIPES];
+
+public:
+    explicit Histogram(std::vector<double> upper_bounds);
+
+    void observe(double v);
+
+    const std::vector<double>& upper_bounds() const { return bounds; }
+    // Non-cumulative counts per bucket, last entry is +Inf
+    std::vector<uint64_t> bucket_counts() const;
+    uint64_t count() const;
+    double sum() const;
+};
+
+// Default latency buckets in seconds, 50us .. 10s
+const std::vector<double>& latency_buckets();
+
+// Named metric families with Prometheus text exposition. Lookups take a
+// shared lock, so hot paths should resolve their metric once and keep the
+// reference; metric objects live as long as the registry.
+class MetricsRegistry {
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::vector<double> bounds;
+        std::unordered_map<std::string, std::unique_ptr<Counter>> counters;
+        std::unordered_map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::unordered_map<std::string, std::unique_ptr<Histogram>> histograms;
+        std::unordered_map<std::string, std::function<double()>> callbacks;
+    };
+
+    std::vector<std::string> family_order;
+    std::unordered_map<std::string, std::unique_ptr<Family>> families;
+    mutable std::shared_mutex mtx;
+
+    Family& family(const std::string& name, Type type, const std::string& help);
+    Family* find_family(const std::string& name, Type type) const;
+
+public:
+    Counter& counter(const std::string& name, const std::string& help,
+                     const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help,
+                 const MetricLabels& labels = {});
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const MetricLabels& labels = {},
+                         const std::vector<double>& bounds = latency_buckets());
+
+    // Gauge sampled at scrape time (for state owned by another module)
+    void gauge_callback(const std::string& name, const std::string& help,
+                        const MetricLabels& labels, std::function<double()> fn);
+
+    // Prometheus text format 0.0.4
+    std::string render() const;
+};
+
+std::string format_labels(const MetricLabels& labels);
+
+extern MetricsRegistry metrics_registry;
+
+#endif
@@ -0,0 +1,59 @@
+# Checks out git revision REF in a worktree under WORK_DIR and builds its
+# cloud_bench in WORK_DIR/build, so perf_check can run the baseline on the
+# same machine as the candidate. Run by perf_check when PERF_BASELINE_REF is
+# set:
+#   cmake -DREF=<rev> -DSOURCE_DIR=<backend dir> -DWORK_DIR=<dir>
+#         -DBUILD_TYPE=<type> -P build_baseline_ref.cmake
+
+foreach(var REF SOURCE_DIR WORK_DIR)
+    if(NOT ${var})
+        message(FATAL_ERROR "${var} is not set")
+    endif()
+endforeach()
+
+find_program(GIT_EXECUTABLE git)
+if(NOT GIT_EXECUTABLE)
+    message(FATAL_ERROR "git not found; perf_check needs it to build ${REF}")
+endif()
+
+function(run_git)
+    execute_process(COMMAND ${GIT_EXECUTABLE} ${ARGN}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE error
+        OUTPUT_STRIP_TRAILING_WHITESPACE)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "git ${ARGN} failed: ${error}")
+    endif()
+    set(git_output "${output}" PARENT_SCOPE)
+endfunction()
+
+# The backend may sit below the repository root
+run_git(-C ${SOURCE_DIR} rev-parse --show-toplevel)
+set(repo_dir "${git_output}")
+run_git(-C ${SOURCE_DIR} rev-parse --show-prefix)
+set(prefix "${git_output}")
+run_git(-C ${repo_dir} rev-parse --verify "${REF}^{commit}")
+set(commit "${git_output}")
+
+set(worktree ${WORK_DIR}/src)
+if(EXISTS ${worktree}/.git)
+    run_git(-C ${worktree} checkout --detach --force ${commit})
+else()
+    # Forget worktrees whose build directory has since been deleted
+    run_git(-C ${repo_dir} worktree prune)
+    run_git(-C ${repo_dir} worktree add --detach --force ${worktree} ${commit})
+endif()
+message(STATUS "Baseline ${REF} at ${commit}")
+
+execute_process(COMMAND ${CMAKE_COMMAND} -S ${worktree}/${prefix} -B ${WORK_DIR}/build
+                        -DCMAKE_BUILD_TYPE=${BUILD_TYPE}
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Configuring ${REF} failed")
+endif()
+execute_process(COMMAND ${CMAKE_COMMAND} --build ${WORK_DIR}/build --target cloud_bench
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Building cloud_bench at ${REF} failed")
+endif()
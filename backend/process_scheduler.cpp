@@ -1,227 +1,1368 @@
 #include "process_scheduler.h"
+#include "indexed_heap.h"
+#include "metrics.h"
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <tuple>
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <utility>
 
 void ProcessScheduler::addProcess(const Process& process) {
-    processes.push_back(process);
+    table.push_back(process);
+    view_stale = true;
+}
+
+void ProcessScheduler::setProcesses(const std::vector<Process>& list) {
+    // The chart's name ids refer to the old table
+    clearGanttChart();
+    table.clear();
+    table.reserve(list.size());
+    for (const auto& process : list) {
+        table.push_back(process);
+    }
+    view_stale = true;
+}
+
+void ProcessScheduler::setProcesses(ProcessTable&& list) {
+    clearGanttChart();
+    table = std::move(list);
+    view_stale = true;
+    for (int pid : table.pid) {
+        next_pid = std::max(next_pid, pid + 1);
+    }
+}
+
+const std::vector<Process>& ProcessScheduler::getProcesses() const {
+    if (view_stale || process_view.size() != table.size()) {
+        process_view.clear();
+        process_view.reserve(table.size());
+        for (size_t i = 0; i < table.size(); i++) {
+            process_view.push_back(table.row(i));
+        }
+        view_stale = false;
+    }
+    return process_view;
+}
+
+void ProcessScheduler::beginRun() {
+    clearGanttChart();
+    view_stale = true;
+}
+
+void ProcessScheduler::refuseRun(const std::string& why) {
+    std::cout << "❌ " << why << "\n";
+    run_error = why;
+}
+
+void ProcessScheduler::endRun() {
+    table.finish_run();
+    measureGanttChart();
+}
+
+void ProcessScheduler::measureGanttChart() {
+    for (const auto& entry : gantt_chart) {
+        gantt_max_slice = std::max(gantt_max_slice, entry.end_time - entry.start_time);
+        gantt_makespan = std::max(gantt_makespan, entry.end_time);
+    }
 }
 
 void ProcessScheduler::FCFS() {
     std::cout << "Executing FCFS Scheduling...\n";
-    clearGanttChart();
+    beginRun();
     
     // Sort processes by arrival time
-    std::sort(processes.begin(), processes.end(), 
-              [](const Process& a, const Process& b) {
-                  return a.arrival_time < b.arrival_time;
-              });
+    table.permute(arrivalOrder());
     
     current_time = 0;
+    gantt_chart.reserve(table.size());
     
-    for (auto& process : processes) {
-        if (current_time < process.arrival_time) {
-            current_time = process.arrival_time;
+    for (size_t i = 0; i < table.size(); i++) {
+        if (current_time < table.arrival[i]) {
+            current_time = table.arrival[i];
         }
         
-        int start_time = current_time;
-        process.start_time = start_time;
-        process.state = RUNNING;
+        table.start[i] = current_time;
         
         // Record Gantt chart entry with process name
-        gantt_chart.emplace_back(process.pid, process.process_name, start_time, start_time + process.burst_time);
+        gantt_chart.emplace_back(table.pid[i], table.name_id[i], current_time, current_time + table.burst[i]);
+        dispatch_count++;
         
-        std::cout << "Time " << current_time << ": " << process.process_name << " (P" << process.pid << ") starts execution\n";
-        current_time += process.burst_time;
+        if (verbose) std::cout << "Time " << current_time << ": " << table.name(i) << " (P" << table.pid[i] << ") starts execution\n";
+        current_time += table.burst[i];
+        table.remaining[i] = 0;
+        table.finish(i, current_time);
         
-        process.completion_time = current_time;
-        process.turnaround_time = process.completion_time - process.arrival_time;
-        process.waiting_time = process.turnaround_time - process.burst_time;
-        process.state = TERMINATED;
-        
-        std::cout << "Time " << current_time << ": " << process.process_name << " (P" << process.pid << ") completes\n";
+        if (verbose) std::cout << "Time " << current_time << ": " << table.name(i) << " (P" << table.pid[i] << ") completes\n";
     }
+    endRun();
 }
 
-void ProcessScheduler::SJF() {
-    std::cout << "Executing SJF Scheduling...\n";
-    clearGanttChart();
+// ===== EVENT-DRIVEN CORE =====
+// Processes are admitted from an arrival-ordered list as time reaches them,
+// and an empty ready set jumps straight to the next arrival instead of
+// stepping one time unit at a time.
+
+std::vector<int> ProcessScheduler::arrivalOrder() const {
+    std::vector<std::pair<int, int>> keyed;
+    keyed.reserve(table.size());
+    for (size_t i = 0; i < table.size(); i++) {
+        keyed.emplace_back(table.arrival[i], static_cast<int>(i));
+    }
+    std::sort(keyed.begin(), keyed.end());
     
-    std::vector<Process*> ready_list;
+    std::vector<int> order;
+    order.reserve(keyed.size());
+    for (const auto& [arrival, row] : keyed) {
+        order.push_back(row);
+    }
+    return order;
+}
+
+void ProcessScheduler::runNonPreemptive(const std::vector<int>& key) {
+    // Min-heap of (key, row): ties go to the process earlier in the table
+    using ReadyEntry = std::pair<int, int>;
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> ready;
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
     current_time = 0;
-    int completed = 0;
-    int n = processes.size();
+    gantt_chart.reserve(order.size());
     
-    while (completed < n) {
-        // Add arrived processes to ready list
-        for (auto& process : processes) {
-            if (process.arrival_time <= current_time && process.state == NEW) {
-                process.state = READY;
-                ready_list.push_back(&process);
-            }
+    for (size_t completed = 0; completed < order.size(); completed++) {
+        if (ready.empty() && current_time < table.arrival[order[next_arrival]]) {
+            current_time = table.arrival[order[next_arrival]];
         }
-        
-        if (ready_list.empty()) {
-            current_time++;
-            continue;
+        while (next_arrival < order.size() && table.arrival[order[next_arrival]] <= current_time) {
+            int arrived = order[next_arrival++];
+            ready.emplace(key[arrived], arrived);
         }
         
-        // Sort by burst time (SJF)
-        std::sort(ready_list.begin(), ready_list.end(),
-                  [](const Process* a, const Process* b) {
-                      return a->burst_time < b->burst_time;
-                  });
-        
-        Process* current = ready_list.front();
-        ready_list.erase(ready_list.begin());
+        int current = ready.top().second;
+        ready.pop();
         
-        current->start_time = current_time;
-        current->state = RUNNING;
+        table.start[current] = current_time;
         
         // Record Gantt chart entry with process name
-        gantt_chart.emplace_back(current->pid, current->process_name, current_time, current_time + current->burst_time);
-        
-        std::cout << "Time " << current_time << ": " << current->process_name << " (P" << current->pid << ") starts execution\n";
-        current_time += current->burst_time;
+        gantt_chart.emplace_back(table.pid[current], table.name_id[current], current_time, current_time + table.burst[current]);
+        dispatch_count++;
         
-        current->completion_time = current_time;
-        current->turnaround_time = current->completion_time - current->arrival_time;
-        current->waiting_time = current->turnaround_time - current->burst_time;
-        current->state = TERMINATED;
-        completed++;
+        if (verbose) std::cout << "Time " << current_time << ": " << table.name(current) << " (P" << table.pid[current] << ") starts execution\n";
+        current_time += table.burst[current];
+        table.remaining[current] = 0;
+        table.finish(current, current_time);
         
-        std::cout << "Time " << current_time << ": " << current->process_name << " (P" << current->pid << ") completes\n";
+        if (verbose) std::cout << "Time " << current_time << ": " << table.name(current) << " (P" << table.pid[current] << ") completes\n";
     }
+    endRun();
+}
+
+void ProcessScheduler::SJF() {
+    std::cout << "Executing SJF Scheduling...\n";
+    beginRun();
+    runNonPreemptive(table.burst);
 }
 
 void ProcessScheduler::RoundRobin(int time_quantum) {
     std::cout << "Executing Round Robin Scheduling (Quantum=" << time_quantum << ")...\n";
-    clearGanttChart();
+    beginRun();
+    // A quantum below 1 would never advance the clock
+    if (time_quantum <= 0) {
+        refuseRun("RR quantum must be positive");
+        return;
+    }
     
-    std::queue<Process*> ready_queue;
+    std::queue<int> ready_queue;
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
     current_time = 0;
-    int completed = 0;
-    int n = processes.size();
+    size_t completed = 0;
+    size_t n = table.size();
     
     // Initialize processes
-    for (auto& process : processes) {
-        process.remaining_time = process.burst_time;
-        process.start_time = -1;
-    }
+    std::copy(table.burst.begin(), table.burst.end(), table.remaining.begin());
+    std::fill(table.start.begin(), table.start.end(), -1);
     
     while (completed < n) {
-        // Add arrived processes to ready queue
-        for (auto& process : processes) {
-            if (process.arrival_time <= current_time && process.state == NEW) {
-                process.state = READY;
-                ready_queue.push(&process);
-            }
+        if (ready_queue.empty() && current_time < table.arrival[order[next_arrival]]) {
+            current_time = table.arrival[order[next_arrival]];
         }
         
-        if (ready_queue.empty()) {
-            current_time++;
-            continue;
+        // Processes that arrived during the last slice join behind the one
+        // it preempted, in table order
+        size_t batch = next_arrival;
+        while (next_arrival < order.size() && table.arrival[order[next_arrival]] <= current_time) {
+            next_arrival++;
+        }
+        std::sort(order.begin() + batch, order.begin() + next_arrival);
+        for (size_t i = batch; i < next_arrival; i++) {
+            ready_queue.push(order[i]);
         }
         
-        Process* current = ready_queue.front();
+        int current = ready_queue.front();
         ready_queue.pop();
         
-        if (current->start_time == -1) {
-            current->start_time = current_time;
+        if (table.start[current] == -1) {
+            table.start[current] = current_time;
         }
         
-        current->state = RUNNING;
-        
-        int execution_time = std::min(time_quantum, current->remaining_time);
+        int execution_time = std::min(time_quantum, table.remaining[current]);
         int start_execution = current_time;
         
-        // Record Gantt chart entry for this execution slice with process name
-        gantt_chart.emplace_back(current->pid, current->process_name, start_execution, start_execution + execution_time);
+        // A process that runs again straight away extends its last slice
+        appendGanttSlice(current, start_execution, start_execution + execution_time);
+        dispatch_count++;
         
-        std::cout << "Time " << current_time << ": " << current->process_name << " (P" << current->pid 
-                  << ") executes for " << execution_time << " units\n";
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(current) << " (P" << table.pid[current] 
+                      << ") executes for " << execution_time << " units\n";
+        }
         
         current_time += execution_time;
-        current->remaining_time -= execution_time;
+        table.remaining[current] -= execution_time;
         
-        if (current->remaining_time == 0) {
-            current->completion_time = current_time;
-            current->turnaround_time = current->completion_time - current->arrival_time;
-            current->waiting_time = current->turnaround_time - current->burst_time;
-            current->state = TERMINATED;
+        if (table.remaining[current] == 0) {
+            table.finish(current, current_time);
             completed++;
-            std::cout << "Time " << current_time << ": " << current->process_name << " (P" << current->pid << ") completes\n";
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(current) << " (P" << table.pid[current] << ") completes\n";
         } else {
-            current->state = READY;
             ready_queue.push(current);
         }
     }
+    endRun();
 }
 
 void ProcessScheduler::PriorityScheduling() {
     std::cout << "Executing Priority Scheduling...\n";
-    clearGanttChart();
+    beginRun();
+    // Lower number = higher priority
+    runNonPreemptive(table.priority);
+}
+
+// ===== PREEMPTIVE SCHEDULING =====
+// The ready set lives in an indexed heap keyed by (key, arrival time), and
+// the running process stays at its top. Each slice runs until the top
+// process finishes or the next arrival, so there are at most two events per
+// process. After a slice the running process is re-keyed in place (for
+// SRTF a decrease-key on its remaining time), and an arrival preempts only
+// when it strictly outranks it: equal keys go to the earlier arrival.
+
+void ProcessScheduler::appendGanttSlice(int row, int start, int end) {
+    if (end <= start) {
+        return;
+    }
+    if (!gantt_chart.empty() && gantt_chart.back().process_id == table.pid[row] &&
+        gantt_chart.back().end_time == start) {
+        gantt_chart.back().end_time = end;
+        return;
+    }
+    gantt_chart.emplace_back(table.pid[row], table.name_id[row], start, end);
+}
+
+void ProcessScheduler::runPreemptive(const std::vector<int>& key) {
+    IndexedMinHeap<std::pair<int, int>> ready(table.size());
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
+    current_time = 0;
+    
+    std::copy(table.burst.begin(), table.burst.end(), table.remaining.begin());
+    std::fill(table.start.begin(), table.start.end(), -1);
+    
+    size_t completed = 0;
+    while (completed < order.size()) {
+        if (ready.empty() && current_time < table.arrival[order[next_arrival]]) {
+            current_time = table.arrival[order[next_arrival]];
+        }
+        while (next_arrival < order.size() && table.arrival[order[next_arrival]] <= current_time) {
+            int arrived = order[next_arrival++];
+            ready.push(arrived, {key[arrived], table.arrival[arrived]});
+        }
+        
+        int current = ready.top();
+        if (table.start[current] == -1) {
+            table.start[current] = current_time;
+        }
+        
+        // Run to completion or to the next arrival, whichever comes first
+        int slice_end = current_time + table.remaining[current];
+        if (next_arrival < order.size() && table.arrival[order[next_arrival]] < slice_end) {
+            slice_end = table.arrival[order[next_arrival]];
+        }
+        appendGanttSlice(current, current_time, slice_end);
+        dispatch_count++;
+        
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(current) << " (P" << table.pid[current] 
+                      << ") executes for " << slice_end - current_time << " units\n";
+        }
+        
+        table.remaining[current] -= slice_end - current_time;
+        current_time = slice_end;
+        
+        if (table.remaining[current] == 0) {
+            ready.pop();
+            table.finish(current, current_time);
+            completed++;
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(current) << " (P" << table.pid[current] << ") completes\n";
+        } else {
+            ready.update(current, {key[current], table.arrival[current]});
+        }
+    }
+    endRun();
+}
+
+void ProcessScheduler::SRTF() {
+    std::cout << "Executing SRTF Scheduling...\n";
+    beginRun();
+    runPreemptive(table.remaining);
+}
+
+void ProcessScheduler::PreemptivePriority() {
+    std::cout << "Executing Preemptive Priority Scheduling...\n";
+    beginRun();
+    // Lower number = higher priority
+    runPreemptive(table.priority);
+}
+
+// ===== MULTI-LEVEL FEEDBACK QUEUE =====
+// Each level is an intrusive FIFO threaded through `next`, so a priority
+// boost splices the lower levels onto level 0 in O(levels). Boosted
+// processes pick up their new level and a fresh allotment lazily, when they
+// are next dispatched (their boost epoch is stale).
+
+std::string validate_mlfq_config(const MlfqConfig& config) {
+    if (config.quanta.empty() || config.quanta.size() > 16) {
+        return "MLFQ needs 1 to 16 levels";
+    }
+    for (int quantum : config.quanta) {
+        if (quantum <= 0) return "MLFQ quanta must be positive";
+    }
+    if (config.boost_interval < 0) {
+        return "MLFQ boost interval must be non-negative";
+    }
+    return "";
+}
+
+void ProcessScheduler::MLFQ() {
+    const std::vector<int>& quanta = mlfq_config.quanta;
+    const int boost_interval = mlfq_config.boost_interval;
+    std::cout << "Executing MLFQ Scheduling (" << quanta.size() << " levels, boost every "
+              << boost_interval << ")...\n";
+    beginRun();
+    std::string invalid = validate_mlfq_config(mlfq_config);
+    if (!invalid.empty()) {
+        refuseRun(invalid);
+        return;
+    }
     
-    std::vector<Process*> ready_list;
+    const size_t levels = quanta.size();
+    const size_t n = table.size();
+    std::vector<int> head(levels, -1), tail(levels, -1), next(n, -1);
+    std::vector<int> used(n, 0);            // time run at the current level
+    std::vector<int> epoch(n, 0);           // boosts seen when `used` was set
+    int boosts = 0;
+    
+    auto enqueue = [&](size_t level, int index) {
+        next[index] = -1;
+        if (tail[level] < 0) head[level] = index;
+        else next[tail[level]] = index;
+        tail[level] = index;
+    };
+    auto highest_ready = [&]() {
+        for (size_t level = 0; level < levels; level++) {
+            if (head[level] >= 0) return static_cast<int>(level);
+        }
+        return -1;
+    };
+    
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
+    size_t completed = 0;
+    int next_boost = boost_interval > 0 ? boost_interval : std::numeric_limits<int>::max();
     current_time = 0;
-    int completed = 0;
-    int n = processes.size();
+    
+    std::copy(table.burst.begin(), table.burst.end(), table.remaining.begin());
+    std::fill(table.start.begin(), table.start.end(), -1);
     
     while (completed < n) {
-        // Add arrived processes to ready list
-        for (auto& process : processes) {
-            if (process.arrival_time <= current_time && process.state == NEW) {
-                process.state = READY;
-                ready_list.push_back(&process);
+        bool idle = highest_ready() < 0;
+        if (idle && current_time < table.arrival[order[next_arrival]]) {
+            current_time = table.arrival[order[next_arrival]];
+        }
+        if (current_time >= next_boost) {
+            if (!idle) {
+                for (size_t level = 1; level < levels; level++) {
+                    if (head[level] < 0) continue;
+                    if (tail[0] < 0) head[0] = head[level];
+                    else next[tail[0]] = head[level];
+                    tail[0] = tail[level];
+                    head[level] = tail[level] = -1;
+                }
+                boosts++;
+                if (verbose) std::cout << "Time " << current_time << ": priority boost\n";
             }
+            next_boost = (current_time / boost_interval + 1) * boost_interval;
+        }
+        while (next_arrival < order.size() && table.arrival[order[next_arrival]] <= current_time) {
+            int index = order[next_arrival++];
+            used[index] = 0;
+            epoch[index] = boosts;
+            enqueue(0, index);
         }
         
-        if (ready_list.empty()) {
-            current_time++;
-            continue;
+        size_t level = static_cast<size_t>(highest_ready());
+        int index = head[level];
+        head[level] = next[index];
+        if (head[level] < 0) tail[level] = -1;
+        if (epoch[index] != boosts) {
+            used[index] = 0;
+            epoch[index] = boosts;
         }
         
-        // Sort by priority (lower number = higher priority)
-        std::sort(ready_list.begin(), ready_list.end(),
-                  [](const Process* a, const Process* b) {
-                      return a->priority < b->priority;
-                  });
+        if (table.start[index] == -1) {
+            table.start[index] = current_time;
+        }
         
-        Process* current = ready_list.front();
-        ready_list.erase(ready_list.begin());
+        // Run out the allotment unless the process finishes, an arrival
+        // outranks it or a boost falls due first
+        int slice_end = current_time + std::min(table.remaining[index], quanta[level] - used[index]);
+        if (level > 0 && next_arrival < order.size() && table.arrival[order[next_arrival]] < slice_end) {
+            slice_end = table.arrival[order[next_arrival]];
+        }
+        if (next_boost < slice_end) {
+            slice_end = next_boost;
+        }
+        appendGanttSlice(index, current_time, slice_end);
+        dispatch_count++;
         
-        current->start_time = current_time;
-        current->state = RUNNING;
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(index) << " (P" << table.pid[index] 
+                      << ") executes for " << slice_end - current_time << " units at level " << level << "\n";
+        }
         
-        // Record Gantt chart entry with process name
-        gantt_chart.emplace_back(current->pid, current->process_name, current_time, current_time + current->burst_time);
+        table.remaining[index] -= slice_end - current_time;
+        used[index] += slice_end - current_time;
+        current_time = slice_end;
+        
+        if (table.remaining[index] == 0) {
+            table.finish(index, current_time);
+            completed++;
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(index) << " (P" << table.pid[index] << ") completes\n";
+        } else if (used[index] >= quanta[level]) {
+            used[index] = 0;
+            enqueue(std::min(level + 1, levels - 1), index);
+        } else {
+            enqueue(level, index);
+        }
+    }
+    endRun();
+}
+
+// ===== COMPLETELY FAIR SCHEDULER =====
+// The runqueue is a std::set, a red-black tree, ordered by (virtual runtime,
+// list index): pick-next takes the leftmost node and requeueing is one
+// O(log n) insert. The picked node is extracted and reinserted with its new
+// key, so a decision allocates nothing.
+
+// Linux's sched_prio_to_weight, nice -20..19; nice 0 weighs 1024
+static const int CFS_NICE_WEIGHTS[40] = {
+    88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,   335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,    36,    29,    23,    18,    15
+};
+
+// Priorities are validated as >= 0, so they are offset onto the nice range
+static int cfs_nice(int priority) {
+    return std::clamp(priority - 20, -20, 19);
+}
+
+std::string validate_cfs_config(const CfsConfig& config) {
+    if (config.target_latency <= 0 || config.min_granularity <= 0) {
+        return "CFS target latency and minimum granularity must be positive";
+    }
+    return "";
+}
+
+void ProcessScheduler::CFS() {
+    std::cout << "Executing CFS Scheduling (target latency " << cfs_config.target_latency
+              << ", min granularity " << cfs_config.min_granularity << ")...\n";
+    beginRun();
+    std::string invalid = validate_cfs_config(cfs_config);
+    if (!invalid.empty()) {
+        refuseRun(invalid);
+        return;
+    }
+    
+    const size_t n = table.size();
+    std::vector<double> vruntime(n, 0.0);
+    std::vector<int> weight(n);
+    for (size_t i = 0; i < n; i++) {
+        weight[i] = CFS_NICE_WEIGHTS[cfs_nice(table.priority[i]) + 20];
+        table.remaining[i] = table.burst[i];
+        table.start[i] = -1;
+    }
+    
+    std::set<std::pair<double, int>> runqueue;
+    long long runnable_weight = 0;
+    double min_vruntime = 0.0;
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
+    size_t completed = 0;
+    current_time = 0;
+    
+    while (completed < n) {
+        if (runqueue.empty() && current_time < table.arrival[order[next_arrival]]) {
+            current_time = table.arrival[order[next_arrival]];
+        }
+        while (next_arrival < order.size() && table.arrival[order[next_arrival]] <= current_time) {
+            int index = order[next_arrival++];
+            vruntime[index] = min_vruntime;
+            runnable_weight += weight[index];
+            runqueue.emplace(vruntime[index], index);
+        }
+        
+        auto node = runqueue.extract(runqueue.begin());
+        int index = node.value().second;
+        if (table.start[index] == -1) {
+            table.start[index] = current_time;
+        }
+        
+        long long share = static_cast<long long>(cfs_config.target_latency) * weight[index] / runnable_weight;
+        int slice = static_cast<int>(std::max<long long>(cfs_config.min_granularity, share));
+        int ran = std::min(slice, table.remaining[index]);
+        appendGanttSlice(index, current_time, current_time + ran);
+        dispatch_count++;
+        
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(index) << " (P" << table.pid[index] 
+                      << ") executes for " << ran << " units (vruntime " << vruntime[index] << ")\n";
+        }
+        
+        current_time += ran;
+        table.remaining[index] -= ran;
+        vruntime[index] += static_cast<double>(ran) * CFS_NICE_WEIGHTS[20] / weight[index];
+        double leftmost = runqueue.empty() ? vruntime[index] : std::min(vruntime[index], runqueue.begin()->first);
+        min_vruntime = std::max(min_vruntime, leftmost);
+        
+        if (table.remaining[index] == 0) {
+            runnable_weight -= weight[index];
+            table.finish(index, current_time);
+            completed++;
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(index) << " (P" << table.pid[index] << ") completes\n";
+        } else {
+            node.value().first = vruntime[index];
+            runqueue.insert(std::move(node));
+        }
+    }
+    endRun();
+}
+
+// ===== REAL-TIME SCHEDULING (EDF, RM) =====
+// Job-level simulation. A release heap holds each task's next release (one
+// entry per task, however long the horizon), and released jobs wait in a
+// ready heap keyed by absolute deadline (EDF) or period (RM), ties going to
+// the earlier release and then the earlier row. The running job is kept out
+// of the heap and a release preempts it only when it strictly outranks it.
+// Per-task statistics accumulate as jobs complete, so memory does not grow
+// with the number of jobs beyond the Gantt chart.
+
+// Most periodic tasks the O(n^2) response-time analysis is run on
+static const size_t MAX_RESPONSE_TIME_TASKS = 2000;
+
+std::string validate_realtime_config(const RealtimeConfig& config) {
+    if (config.horizon < 0 || config.horizon > MAX_REALTIME_HORIZON) {
+        return "Real-time horizon must be between 0 and " + std::to_string(MAX_REALTIME_HORIZON);
+    }
+    return "";
+}
+
+void realtime_schedulability(const ProcessTable& table, bool edf, RealtimeStats& stats) {
+    std::vector<int> tasks;
+    bool implicit = true;     // every deadline is the period
+    bool constrained = true;  // no deadline beyond the period
+    double utilization = 0.0;
+    double density = 0.0;
+    for (size_t i = 0; i < table.size(); i++) {
+        int period = table.period[i];
+        if (period <= 0) continue;
+        int deadline = table.deadline[i] > 0 ? table.deadline[i] : period;
+        tasks.push_back(static_cast<int>(i));
+        implicit = implicit && deadline == period;
+        constrained = constrained && deadline <= period;
+        utilization += static_cast<double>(table.burst[i]) / period;
+        density += static_cast<double>(table.burst[i]) / std::min(deadline, period);
+    }
+    stats.utilization = utilization;
+    stats.bound = 0.0;
+    if (tasks.empty()) {
+        stats.test = "none";
+        stats.schedulable = true;
+        return;
+    }
+
+    if (edf) {
+        stats.bound = 1.0;
+        // U <= 1 is exact for EDF unless some deadline is shorter than its period
+        if (constrained && !implicit) {
+            stats.test = "density";
+            stats.schedulable = density <= 1.0;
+        } else {
+            stats.test = "utilization";
+            stats.schedulable = utilization <= 1.0;
+        }
+        return;
+    }
+
+    double n = static_cast<double>(tasks.size());
+    double liu_layland = n * (std::pow(2.0, 1.0 / n) - 1.0);
+    if (implicit && utilization <= liu_layland) {
+        stats.test = "liu-layland";
+        stats.bound = liu_layland;
+        stats.schedulable = true;
+        return;
+    }
+    if (tasks.size() > MAX_RESPONSE_TIME_TASKS || utilization > 1.0) {
+        stats.test = implicit ? "liu-layland" : "utilization";
+        stats.bound = implicit ? liu_layland : 1.0;
+        stats.schedulable = false;
+        return;
+    }
+
+    // R = C + sum over higher-priority tasks of ceil(R / T) * C, iterated to
+    // a fixed point; a task must finish within min(deadline, period)
+    std::stable_sort(tasks.begin(), tasks.end(),
+                     [&](int a, int b) { return table.period[a] < table.period[b]; });
+    stats.test = "response-time";
+    stats.schedulable = true;
+    for (size_t k = 0; k < tasks.size() && stats.schedulable; k++) {
+        int task = tasks[k];
+        long long limit = table.deadline[task] > 0 ? std::min(table.deadline[task], table.period[task])
+                                                   : table.period[task];
+        long long response = table.burst[task];
+        while (true) {
+            long long next = table.burst[task];
+            for (size_t j = 0; j < k; j++) {
+                int higher = tasks[j];
+                next += (response + table.period[higher] - 1) / table.period[higher] * table.burst[higher];
+            }
+            if (next > limit) {
+                stats.schedulable = false;
+                break;
+            }
+            if (next == response) break;
+            response = next;
+        }
+    }
+}
+
+namespace {
+
+// One released job; rank orders the ready heap
+struct RealtimeJob {
+    long long key;
+    int release;
+    int row;
+    int remaining;
+    long long deadline;   // absolute; LLONG_MAX for none
+
+    bool outranks(const RealtimeJob& other) const {
+        return std::tie(key, release, row) < std::tie(other.key, other.release, other.row);
+    }
+};
+
+struct RealtimeJobAfter {
+    bool operator()(const RealtimeJob& a, const RealtimeJob& b) const { return b.outranks(a); }
+};
+
+// Jobs released by [arrival, horizon), and at least the first
+long long realtime_job_count(const ProcessTable& table, long long horizon) {
+    long long jobs = 0;
+    for (size_t i = 0; i < table.size(); i++) {
+        if (table.period[i] > 0 && table.arrival[i] < horizon) {
+            jobs += (horizon - table.arrival[i] + table.period[i] - 1) / table.period[i];
+        } else {
+            jobs++;
+        }
+    }
+    return jobs;
+}
+
+} // namespace
+
+void ProcessScheduler::runRealtime(bool edf) {
+    const long long NONE = std::numeric_limits<long long>::max();
+    realtime_stats = RealtimeStats();
+    std::string invalid = validate_realtime_config(realtime_config);
+    if (!invalid.empty()) {
+        refuseRun(invalid);
+        return;
+    }
+    realtime_schedulability(table, edf, realtime_stats);
+
+    // Horizon: as configured, or the latest arrival plus the hyperperiod
+    long long horizon = realtime_config.horizon;
+    if (horizon == 0) {
+        long long hyperperiod = 1;
+        int latest = 0;
+        for (size_t i = 0; i < table.size(); i++) {
+            latest = std::max(latest, table.arrival[i]);
+            if (table.period[i] > 0 && hyperperiod <= MAX_REALTIME_HORIZON) {
+                hyperperiod = hyperperiod / std::gcd(hyperperiod, static_cast<long long>(table.period[i])) *
+                              table.period[i];
+            }
+        }
+        horizon = std::min<long long>(latest + hyperperiod, MAX_REALTIME_HORIZON);
+    }
+    if (static_cast<size_t>(realtime_job_count(table, horizon)) > MAX_REALTIME_JOBS) {
+        // Largest horizon whose jobs fit
+        long long low = 0, high = horizon;
+        while (low < high) {
+            long long mid = low + (high - low + 1) / 2;
+            if (static_cast<size_t>(realtime_job_count(table, mid)) <= MAX_REALTIME_JOBS) low = mid;
+            else high = mid - 1;
+        }
+        horizon = low;
+    }
+    realtime_stats.horizon = static_cast<int>(horizon);
+
+    size_t n = table.size();
+    std::vector<long long> key(n);
+    std::vector<long long> relative_deadline(n);
+    for (size_t i = 0; i < n; i++) {
+        int period = table.period[i];
+        int deadline = table.deadline[i];
+        relative_deadline[i] = deadline > 0 ? deadline : (period > 0 ? period : NONE);
+        // RM ranks by period; a one-shot job by its deadline
+        key[i] = period > 0 ? period : relative_deadline[i];
+    }
+    std::vector<long long> response_sum(n, 0);
+    realtime_stats.tasks.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        realtime_stats.tasks[i].pid = table.pid[i];
+    }
+    std::fill(table.start.begin(), table.start.end(), -1);
+
+    // (release time, row), earliest first
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> releases;
+    for (size_t i = 0; i < n; i++) {
+        releases.emplace(table.arrival[i], static_cast<int>(i));
+    }
+    std::priority_queue<RealtimeJob, std::vector<RealtimeJob>, RealtimeJobAfter> ready;
+    RealtimeJob running{};
+    bool busy = false;
+    current_time = 0;
+
+    while (busy || !ready.empty() || !releases.empty()) {
+        if (!busy && ready.empty() && current_time < releases.top().first) {
+            current_time = releases.top().first;
+        }
+        while (!releases.empty() && releases.top().first <= current_time) {
+            auto [release, row] = releases.top();
+            releases.pop();
+            long long deadline = relative_deadline[row] == NONE ? NONE : release + relative_deadline[row];
+            ready.push({edf ? deadline : key[row], release, row, table.burst[row], deadline});
+            realtime_stats.tasks[row].jobs++;
+            long long next = static_cast<long long>(release) + table.period[row];
+            if (table.period[row] > 0 && next < horizon) {
+                releases.emplace(static_cast<int>(next), row);
+            }
+        }
+
+        if (!busy || (!ready.empty() && ready.top().outranks(running))) {
+            if (busy) {
+                ready.push(running);
+                if (verbose) std::cout << "Time " << current_time << ": " << table.name(running.row) << " (P"
+                                       << table.pid[running.row] << ") is preempted\n";
+            }
+            running = ready.top();
+            ready.pop();
+            busy = true;
+            dispatch_count++;
+        }
+        int row = running.row;
+        if (table.start[row] == -1) {
+            table.start[row] = current_time;
+        }
+
+        // Run to completion or to the next release, whichever comes first
+        int slice_end = current_time + running.remaining;
+        if (!releases.empty() && releases.top().first < slice_end) {
+            slice_end = releases.top().first;
+        }
+        appendGanttSlice(row, current_time, slice_end);
+        running.remaining -= slice_end - current_time;
+        current_time = slice_end;
+        if (running.remaining > 0) {
+            continue;
+        }
+
+        busy = false;
+        RealtimeTaskStats& task = realtime_stats.tasks[row];
+        int response = current_time - running.release;
+        task.worst_response = std::max(task.worst_response, response);
+        response_sum[row] += response;
+        table.completion[row] = current_time;
+        bool missed = current_time > running.deadline;
+        if (missed) task.missed++;
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(row) << " (P" << table.pid[row]
+                      << ") completes a job" << (missed ? ", missing its deadline" : "") << "\n";
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        RealtimeTaskStats& task = realtime_stats.tasks[i];
+        task.average_response = task.jobs > 0 ? static_cast<double>(response_sum[i]) / task.jobs : 0.0;
+        realtime_stats.jobs += task.jobs;
+        realtime_stats.missed += task.missed;
+        table.turnaround[i] = task.worst_response;
+        table.waiting[i] = task.worst_response - table.burst[i];
+        table.state[i] = TERMINATED;
+    }
+    measureGanttChart();
+}
+
+void ProcessScheduler::EDF() {
+    std::cout << "Executing EDF Scheduling...\n";
+    beginRun();
+    runRealtime(true);
+}
+
+void ProcessScheduler::RateMonotonic() {
+    std::cout << "Executing Rate-Monotonic Scheduling...\n";
+    beginRun();
+    runRealtime(false);
+}
+
+// ===== MULTI-CORE SCHEDULING =====
+// Every CPU has its own runqueue, a std::set ordered by the policy's key:
+// arrival (FCFS), burst (SJF), priority (PRIORITY, PRIORITY_P), remaining
+// time (SRTF) or the time a process became ready (RR), with the list index
+// breaking ties. As in RoundRobin(), an RR process whose quantum expires is
+// ready from the start of its slice, ahead of processes that arrived during it.
+// Time jumps from event to event, the earlier of the next arrival and the
+// next slice end on any CPU. An arrival joins the least loaded CPU its
+// affinity allows (queued plus running) and, under SRTF and PRIORITY_P,
+// preempts that CPU's process when it outranks it. A preempted or expired
+// process requeues on the CPU it ran on. A CPU left idle steals the best
+// process it may run from the longest other runqueue, looking at no more
+// than MAX_STEAL_SCAN candidates per runqueue (like Linux's nr_migrate).
+
+static const int MAX_STEAL_SCAN = 32;
+
+bool ProcessScheduler::supportsMultiCore(const std::string& algorithm) {
+    return algorithm == "FCFS" || algorithm == "SJF" || algorithm == "PRIORITY" || algorithm == "RR" ||
+           algorithm == "SRTF" || algorithm == "PRIORITY_P";
+}
+
+void ProcessScheduler::runMultiCore(const std::string& algorithm, int quantum) {
+    std::cout << "Executing " << algorithm << " Scheduling on " << cores << " CPUs...\n";
+    beginRun();
+    
+    enum class Policy { FCFS, SJF, PRIORITY, RR, SRTF, PRIORITY_P };
+    Policy policy = algorithm == "SJF" ? Policy::SJF
+                  : algorithm == "PRIORITY" ? Policy::PRIORITY
+                  : algorithm == "RR" ? Policy::RR
+                  : algorithm == "SRTF" ? Policy::SRTF
+                  : algorithm == "PRIORITY_P" ? Policy::PRIORITY_P
+                  : Policy::FCFS;
+    const bool preempts = policy == Policy::SRTF || policy == Policy::PRIORITY_P;
+    quantum = std::max(quantum, 1);
+    
+    // (policy key, tie-break, list index)
+    using RunKey = std::tuple<long long, long long, int>;
+    struct Cpu {
+        std::set<RunKey> queue;
+        std::set<RunKey>::node_type node;   // the running process's queue node, reused on requeue
+        int running = -1;          // list index
+        int slice_start = 0;
+        int version = 0;           // invalidates queued slice ends when a slice is cut short
+        int last_entry = -1;       // this CPU's latest Gantt slice, for merging
+    };
+    
+    const size_t n = table.size();
+    const uint64_t all_cpus = cores >= 64 ? ~0ULL : (1ULL << cores) - 1;
+    std::vector<Cpu> cpus(cores);
+    std::vector<int> last_core(n, -1);
+    core_stats.assign(cores, CoreStats());
+    for (int c = 0; c < cores; c++) {
+        core_stats[c].core = c;
+    }
+    migration_count = 0;
+    
+    // (time, cpu, version) of every slice end, earliest first; stale entries are skipped
+    std::priority_queue<std::tuple<int, int, int>, std::vector<std::tuple<int, int, int>>,
+                        std::greater<std::tuple<int, int, int>>> slice_ends;
+    
+    // Affinity outside the simulated CPUs is ignored rather than leaving a process unrunnable
+    auto allowed_cpus = [&](int index) {
+        uint64_t mask = table.affinity[index] & all_cpus;
+        return mask == 0 ? all_cpus : mask;
+    };
+    // ready_since only matters for RR: twice the time plus one for an expired slice
+    auto key_of = [&](int index, int remaining, long long ready_since) -> RunKey {
+        switch (policy) {
+            case Policy::SJF:        return {table.burst[index], 0, index};
+            case Policy::PRIORITY:   return {table.priority[index], 0, index};
+            case Policy::SRTF:       return {remaining, table.arrival[index], index};
+            case Policy::PRIORITY_P: return {table.priority[index], table.arrival[index], index};
+            case Policy::RR:         return {ready_since, 0, index};
+            case Policy::FCFS:       break;
+        }
+        return {table.arrival[index], 0, index};
+    };
+    
+    auto record_slice = [&](int c, int index, int start, int end) {
+        if (end <= start) {
+            return;
+        }
+        Cpu& cpu = cpus[c];
+        core_stats[c].busy_time += end - start;
+        if (cpu.last_entry >= 0) {
+            GanttEntry& last = gantt_chart[cpu.last_entry];
+            if (last.process_id == table.pid[index] && last.end_time == start) {
+                last.end_time = end;
+                return;
+            }
+        }
+        cpu.last_entry = static_cast<int>(gantt_chart.size());
+        gantt_chart.emplace_back(table.pid[index], table.name_id[index], start, end, c);
+    };
+    
+    auto start_slice = [&](int c, int index) {
+        Cpu& cpu = cpus[c];
+        if (table.start[index] == -1) {
+            table.start[index] = current_time;
+        }
+        if (last_core[index] >= 0 && last_core[index] != c) {
+            migration_count++;
+        }
+        last_core[index] = c;
+        cpu.running = index;
+        cpu.slice_start = current_time;
+        int length = policy == Policy::RR ? std::min(table.remaining[index], quantum) : table.remaining[index];
+        slice_ends.emplace(current_time + length, c, ++cpu.version);
+        core_stats[c].dispatches++;
+        dispatch_count++;
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(index) << " (P" << table.pid[index] 
+                      << ") runs on CPU " << c << "\n";
+        }
+    };
+    
+    size_t completed = 0;
+    // Ends CPU c's slice now; the process completes or requeues on c
+    auto stop_slice = [&](int c) {
+        Cpu& cpu = cpus[c];
+        int index = cpu.running;
+        record_slice(c, index, cpu.slice_start, current_time);
+        table.remaining[index] -= current_time - cpu.slice_start;
+        cpu.running = -1;
+        cpu.version++;
+        if (table.remaining[index] == 0) {
+            table.finish(index, current_time);
+            completed++;
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(index) << " (P" << table.pid[index] << ") completes\n";
+        } else {
+            cpu.node.value() = key_of(index, table.remaining[index], 2LL * cpu.slice_start + 1);
+            cpu.queue.insert(std::move(cpu.node));
+        }
+    };
+    
+    auto steal = [&](int thief) {
+        std::vector<std::pair<size_t, int>> victims;
+        for (int c = 0; c < cores; c++) {
+            if (c != thief && !cpus[c].queue.empty()) victims.emplace_back(cpus[c].queue.size(), c);
+        }
+        std::sort(victims.begin(), victims.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+        for (const auto& [size, victim] : victims) {
+            auto& queue = cpus[victim].queue;
+            int scanned = 0;
+            for (auto it = queue.begin(); it != queue.end() && scanned < MAX_STEAL_SCAN; ++it, scanned++) {
+                if ((allowed_cpus(std::get<2>(*it)) >> thief) & 1) {
+                    cpus[thief].queue.insert(queue.extract(it));
+                    core_stats[thief].steals++;
+                    return;
+                }
+            }
+        }
+    };
+    
+    std::copy(table.burst.begin(), table.burst.end(), table.remaining.begin());
+    std::fill(table.start.begin(), table.start.end(), -1);
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
+    current_time = 0;
+    
+    while (completed < n) {
+        while (!slice_ends.empty() && cpus[std::get<1>(slice_ends.top())].version != std::get<2>(slice_ends.top())) {
+            slice_ends.pop();
+        }
+        int next_event = std::numeric_limits<int>::max();
+        if (!slice_ends.empty()) next_event = std::get<0>(slice_ends.top());
+        if (next_arrival < n) next_event = std::min(next_event, table.arrival[order[next_arrival]]);
+        current_time = std::max(current_time, next_event);
         
-        std::cout << "Time " << current_time << ": " << current->process_name << " (P" << current->pid << ") starts execution\n";
-        current_time += current->burst_time;
+        while (!slice_ends.empty() && std::get<0>(slice_ends.top()) <= current_time) {
+            auto [time, c, version] = slice_ends.top();
+            slice_ends.pop();
+            if (cpus[c].version == version) stop_slice(c);
+        }
         
-        current->completion_time = current_time;
-        current->turnaround_time = current->completion_time - current->arrival_time;
-        current->waiting_time = current->turnaround_time - current->burst_time;
-        current->state = TERMINATED;
-        completed++;
+        while (next_arrival < n && table.arrival[order[next_arrival]] <= current_time) {
+            int index = order[next_arrival++];
+            uint64_t mask = allowed_cpus(index);
+            int target = -1;
+            size_t target_load = 0;
+            for (int c = 0; c < cores; c++) {
+                if (!((mask >> c) & 1)) continue;
+                size_t load = cpus[c].queue.size() + (cpus[c].running >= 0 ? 1 : 0);
+                if (target < 0 || load < target_load) {
+                    target = c;
+                    target_load = load;
+                }
+            }
+            Cpu& cpu = cpus[target];
+            RunKey key = key_of(index, table.remaining[index], 2LL * table.arrival[index]);
+            if (preempts && cpu.running >= 0) {
+                int running_left = table.remaining[cpu.running] - (current_time - cpu.slice_start);
+                RunKey running_key = key_of(cpu.running, running_left, 0);
+                if (key < running_key) stop_slice(target);
+            }
+            cpu.queue.insert(key);
+        }
         
-        std::cout << "Time " << current_time << ": " << current->process_name << " (P" << current->pid << ") completes\n";
+        for (int c = 0; c < cores; c++) {
+            Cpu& cpu = cpus[c];
+            if (cpu.running >= 0) continue;
+            if (cpu.queue.empty()) steal(c);
+            if (cpu.queue.empty()) continue;
+            cpu.node = cpu.queue.extract(cpu.queue.begin());
+            start_slice(c, std::get<2>(cpu.node.value()));
+        }
     }
+    
+    std::stable_sort(gantt_chart.begin(), gantt_chart.end(), [](const GanttEntry& a, const GanttEntry& b) {
+        return a.start_time != b.start_time ? a.start_time < b.start_time : a.core < b.core;
+    });
+    for (auto& stats : core_stats) {
+        stats.utilization = current_time > 0 ? static_cast<double>(stats.busy_time) / current_time : 0.0;
+    }
+    endRun();
+}
+
+// ===== I/O BURSTS =====
+// Event-driven single-CPU run over alternating CPU and I/O bursts. Arrivals
+// come in arrival order and I/O completions from a heap of timed wakeups;
+// both are applied in time order before each dispatch. A process that ends
+// a CPU burst blocks (WAITING) in its device's FIFO queue; the device serves
+// one request at a time, and the completion event wakes the process (READY)
+// with its next CPU burst and starts the device's next request. The ready
+// queue is a heap of (key, ready order, row), the key being 0 for FCFS and
+// RR, the current CPU burst (SJF) or what is left of it (SRTF), or the
+// priority. As in RoundRobin(), a process whose quantum expires goes back
+// ahead of the processes that became ready during its slice. Preemptive
+// policies end a slice at the next event, as runPreemptive() does.
+
+bool ProcessScheduler::supportsIo(const std::string& algorithm) {
+    return algorithm == "FCFS" || algorithm == "SJF" || algorithm == "PRIORITY" || algorithm == "RR" ||
+           algorithm == "SRTF" || algorithm == "PRIORITY_P";
+}
+
+std::string validate_io_bursts(const std::vector<IoBurst>& bursts) {
+    if (bursts.size() > MAX_IO_BURSTS) {
+        return "at most " + std::to_string(MAX_IO_BURSTS) + " I/O bursts per process";
+    }
+    for (const auto& burst : bursts) {
+        if (burst.device < 0 || burst.device >= MAX_IO_DEVICES) {
+            return "I/O device must be between 0 and " + std::to_string(MAX_IO_DEVICES - 1);
+        }
+        if (burst.io_time <= 0 || burst.cpu_time <= 0) {
+            return "CPU and I/O bursts must be positive";
+        }
+    }
+    return "";
+}
+
+void ProcessScheduler::runWithIo(const std::string& algorithm, int quantum) {
+    std::cout << "Executing " << algorithm << " Scheduling with I/O bursts...\n";
+    beginRun();
+    io_stats = IoStats();
+    const bool rr = algorithm == "RR";
+    const bool preempt = algorithm == "SRTF" || algorithm == "PRIORITY_P";
+    const bool by_burst = algorithm == "SJF" || algorithm == "SRTF";
+    const bool by_priority = algorithm == "PRIORITY" || algorithm == "PRIORITY_P";
+    if (rr && quantum <= 0) {
+        refuseRun("RR quantum must be positive");
+        return;
+    }
+
+    const size_t n = table.size();
+    int device_count = 0;
+    for (size_t i = 0; i < n; i++) {
+        for (const auto& burst : table.io_bursts(i)) device_count = std::max(device_count, burst.device + 1);
+    }
+    std::vector<std::deque<std::pair<int, int>>> device_queue(device_count);   // (row, time it blocked)
+    std::vector<bool> device_busy(device_count, false);
+    std::vector<long long> queue_time(device_count, 0);
+    io_stats.devices.resize(device_count);
+    for (int d = 0; d < device_count; d++) io_stats.devices[d].device = d;
+    std::vector<std::pair<int, int>> io_intervals;   // device busy [start, end)
+
+    std::vector<int> order = arrivalOrder();
+    size_t next_arrival = 0;
+    std::vector<uint32_t> stage(n, 0);   // I/O bursts completed
+    std::vector<int> ready_since(n, 0);
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> wakeups;
+    std::priority_queue<std::tuple<int, uint64_t, int>, std::vector<std::tuple<int, uint64_t, int>>,
+                        std::greater<>> ready;
+    uint64_t ready_order = 0;
+
+    std::copy(table.burst.begin(), table.burst.end(), table.remaining.begin());
+    std::fill(table.start.begin(), table.start.end(), -1);
+    std::fill(table.waiting.begin(), table.waiting.end(), 0);
+
+    auto key_of = [&](int row) { return by_burst ? table.remaining[row] : by_priority ? table.priority[row] : 0; };
+    auto make_ready = [&](int row, int time) {
+        table.state[row] = READY;
+        ready_since[row] = time;
+        ready.emplace(key_of(row), ready_order++, row);
+    };
+    // Starts the device's next request at `time`, if one is waiting
+    auto serve = [&](int device, int time) {
+        if (device_queue[device].empty()) {
+            device_busy[device] = false;
+            return;
+        }
+        auto [row, blocked] = device_queue[device].front();
+        device_queue[device].pop_front();
+        device_busy[device] = true;
+        int io_time = table.io_bursts(row)[stage[row]].io_time;
+        DeviceStats& stats = io_stats.devices[device];
+        stats.requests++;
+        stats.busy_time += io_time;
+        queue_time[device] += time - blocked;
+        io_intervals.emplace_back(time, time + io_time);
+        wakeups.emplace(time + io_time, row);
+    };
+    auto next_event = [&]() {
+        int time = next_arrival < n ? table.arrival[order[next_arrival]] : std::numeric_limits<int>::max();
+        return wakeups.empty() ? time : std::min(time, wakeups.top().first);
+    };
+    // Applies every arrival and I/O completion up to `time`, in time order
+    // (arrivals first on a tie)
+    auto apply_events = [&](int time) {
+        for (int at = next_event(); at <= time; at = next_event()) {
+            if (next_arrival < n && table.arrival[order[next_arrival]] == at) {
+                make_ready(order[next_arrival++], at);
+                continue;
+            }
+            int row = wakeups.top().second;
+            wakeups.pop();
+            const IoBurst& burst = table.io_bursts(row)[stage[row]++];
+            table.remaining[row] = burst.cpu_time;
+            make_ready(row, at);
+            serve(burst.device, at);
+            if (verbose) std::cout << "Time " << at << ": " << table.name(row) << " (P" << table.pid[row]
+                                   << ") wakes from device " << burst.device << "\n";
+        }
+    };
+
+    int running = -1;
+    size_t completed = 0;
+    current_time = 0;
+    while (completed < n) {
+        if (running < 0 && ready.empty()) {
+            current_time = std::max(current_time, next_event());
+        }
+        apply_events(current_time);
+        if (running >= 0 && preempt && !ready.empty() && std::get<0>(ready.top()) < key_of(running)) {
+            make_ready(running, current_time);
+            running = -1;
+        }
+        if (running < 0) {
+            running = std::get<2>(ready.top());
+            ready.pop();
+            table.waiting[running] += current_time - ready_since[running];
+            table.state[running] = RUNNING;
+            if (table.start[running] == -1) {
+                table.start[running] = current_time;
+            }
+        }
+
+        int slice_end = current_time + table.remaining[running];
+        if (rr) slice_end = std::min(slice_end, current_time + quantum);
+        if (preempt) slice_end = std::min(slice_end, next_event());
+        appendGanttSlice(running, current_time, slice_end);
+        dispatch_count++;
+        if (verbose) {
+            std::cout << "Time " << current_time << ": " << table.name(running) << " (P" << table.pid[running]
+                      << ") executes for " << slice_end - current_time << " units\n";
+        }
+        table.remaining[running] -= slice_end - current_time;
+        current_time = slice_end;
+
+        if (table.remaining[running] > 0) {
+            if (rr) {
+                make_ready(running, current_time);
+                running = -1;
+            }
+            continue;
+        }
+        // A device that finished during the burst is free before this
+        // process joins its queue
+        int row = running;
+        running = -1;
+        apply_events(current_time);
+        const std::vector<IoBurst>& bursts = table.io_bursts(row);
+        if (stage[row] < bursts.size()) {
+            int device = bursts[stage[row]].device;
+            table.state[row] = WAITING;
+            device_queue[device].emplace_back(row, current_time);
+            if (device_busy[device]) {
+                DeviceStats& stats = io_stats.devices[device];
+                stats.max_queue = std::max(stats.max_queue, device_queue[device].size());
+            } else {
+                serve(device, current_time);
+            }
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(row) << " (P" << table.pid[row]
+                                   << ") blocks on device " << device << "\n";
+        } else {
+            table.finish(row, current_time);
+            table.state[row] = TERMINATED;
+            completed++;
+            if (verbose) std::cout << "Time " << current_time << ": " << table.name(row) << " (P" << table.pid[row] << ") completes\n";
+        }
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        table.turnaround[i] = table.completion[i] - table.arrival[i];
+    }
+    for (int d = 0; d < device_count; d++) {
+        DeviceStats& stats = io_stats.devices[d];
+        io_stats.bursts += stats.requests;
+        stats.average_queue_time = stats.requests > 0 ? static_cast<double>(queue_time[d]) / stats.requests : 0.0;
+    }
+    measureGanttChart();
+    computeIoStats(io_intervals);
+}
+
+void ProcessScheduler::computeIoStats(std::vector<std::pair<int, int>>& io_intervals) {
+    // Union of the device busy intervals
+    std::sort(io_intervals.begin(), io_intervals.end());
+    std::vector<std::pair<int, int>> io_busy;
+    for (const auto& interval : io_intervals) {
+        if (!io_busy.empty() && interval.first <= io_busy.back().second) {
+            io_busy.back().second = std::max(io_busy.back().second, interval.second);
+        } else {
+            io_busy.push_back(interval);
+        }
+    }
+    for (const auto& interval : io_busy) {
+        io_stats.io_busy_time += interval.second - interval.first;
+    }
+    // The chart's slices are sorted and disjoint on one CPU
+    size_t k = 0;
+    for (const auto& entry : gantt_chart) {
+        io_stats.cpu_busy_time += entry.end_time - entry.start_time;
+        while (k < io_busy.size() && io_busy[k].second <= entry.start_time) k++;
+        for (size_t j = k; j < io_busy.size() && io_busy[j].first < entry.end_time; j++) {
+            io_stats.overlap_time += std::min(entry.end_time, io_busy[j].second) -
+                                     std::max(entry.start_time, io_busy[j].first);
+        }
+    }
+
+    double makespan = gantt_makespan;
+    if (makespan > 0) {
+        io_stats.cpu_utilization = io_stats.cpu_busy_time / makespan;
+        io_stats.io_utilization = io_stats.io_busy_time / makespan;
+        for (auto& device : io_stats.devices) device.utilization = device.busy_time / makespan;
+    }
+    if (io_stats.io_busy_time > 0) {
+        io_stats.overlap = static_cast<double>(io_stats.overlap_time) / io_stats.io_busy_time;
+    }
+}
+
+void ProcessScheduler::computeSingleCoreStats() {
+    CoreStats stats;
+    int makespan = 0;
+    for (const auto& entry : gantt_chart) {
+        stats.busy_time += entry.end_time - entry.start_time;
+        makespan = std::max(makespan, entry.end_time);
+    }
+    stats.utilization = makespan > 0 ? static_cast<double>(stats.busy_time) / makespan : 0.0;
+    stats.dispatches = dispatch_count;
+    core_stats.assign(1, stats);
+    migration_count = 0;
 }
 
 void ProcessScheduler::executeScheduler(const std::string& algorithm, int quantum) {
     current_algorithm = algorithm;
+    run_error.clear();
     resetProcessStates();
-    if (algorithm == "FCFS") {
+    auto started = std::chrono::steady_clock::now();
+    std::string policy = algorithm;
+    if (preemptive && algorithm == "SJF") policy = "SRTF";
+    if (preemptive && algorithm == "PRIORITY") policy = "PRIORITY_P";
+    // MLFQ, CFS, EDF and RM always run on a single CPU, as does any run
+    // with I/O bursts
+    bool io = table.has_io();
+    bool multi_core = !io && cores > 1 && supportsMultiCore(policy);
+    if (io) {
+        if (cores > 1 || !supportsIo(policy)) {
+            refuseRun("I/O bursts need one CPU and FCFS, SJF, PRIORITY, RR, SRTF or PRIORITY_P");
+            return;
+        }
+        runWithIo(policy, quantum);
+    } else if (multi_core) {
+        runMultiCore(policy, quantum);
+    } else if (algorithm == "FCFS") {
         FCFS();
     } else if (algorithm == "SJF") {
-        SJF();
+        if (preemptive) SRTF();
+        else SJF();
     } else if (algorithm == "RR") {
         RoundRobin(quantum);
     } else if (algorithm == "PRIORITY") {
-        PriorityScheduling();
+        if (preemptive) PreemptivePriority();
+        else PriorityScheduling();
+    } else if (algorithm == "SRTF") {
+        SRTF();
+    } else if (algorithm == "PRIORITY_P") {
+        PreemptivePriority();
+    } else if (algorithm == "MLFQ") {
+        MLFQ();
+    } else if (algorithm == "CFS") {
+        CFS();
+    } else if (algorithm == "EDF") {
+        EDF();
+    } else if (algorithm == "RM") {
+        RateMonotonic();
+    } else {
+        refuseRun("Unknown algorithm " + algorithm);
+        return;
+    }
+    if (!run_error.empty()) return;
+    if (!multi_core) {
+        computeSingleCoreStats();
     }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    MetricLabels labels = {{"algorithm", algorithm}};
+    metrics_registry.counter("scheduler_runs_total", "Scheduler executions", labels).inc();
+    metrics_registry.counter("scheduler_processes_scheduled_total", "Processes scheduled", labels)
+        .inc(table.size());
+    metrics_registry.histogram("scheduler_run_duration_seconds", "Scheduler execution time", labels)
+        .observe(elapsed);
 }
 
 void ProcessScheduler::displayResults() {
@@ -231,7 +1372,7 @@ void ProcessScheduler::displayResults() {
               << std::setw(8) << "Start" << std::setw(12) << "Completion"
               << std::setw(10) << "Waiting" << std::setw(14) << "Turnaround\n";
     
-    for (const auto& process : processes) {
+    for (const auto& process : getProcesses()) {
         std::cout << std::setw(5) << process.pid 
                   << std::setw(15) << process.process_name
                   << std::setw(8) << process.arrival_time
@@ -311,7 +1452,7 @@ void ProcessScheduler::addManualProcess() {
     // Create and validate process
     Process new_process(pid, process_name, arrival, burst, priority);
     if (validateProcess(new_process)) {
-        processes.push_back(new_process);
+        addProcess(new_process);
         std::cout << "✅ " << process_name << " (P" << pid << ") added successfully!\n";
         
         // Show current process list
@@ -322,13 +1463,13 @@ void ProcessScheduler::addManualProcess() {
 }
 
 void ProcessScheduler::displayCurrentProcesses() {
-    if (processes.empty()) {
+    if (table.empty()) {
         std::cout << "📭 No processes in the queue.\n";
         return;
     }
     
     std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "📋 CURRENT PROCESS QUEUE (" << processes.size() << " processes)\n";
+    std::cout << "📋 CURRENT PROCESS QUEUE (" << table.size() << " processes)\n";
     std::cout << std::string(60, '=') << "\n";
     
     std::cout << std::setw(5) << "PID" << std::setw(20) << "Process Name" 
@@ -336,7 +1477,7 @@ void ProcessScheduler::displayCurrentProcesses() {
               << std::setw(15) << "Status" << "\n";
     std::cout << std::string(70, '-') << "\n";
     
-    for (const auto& process : processes) {
+    for (const auto& process : getProcesses()) {
         std::string state_str;
         switch (process.state) {
             case NEW: state_str = "New"; break;
@@ -357,9 +1498,9 @@ void ProcessScheduler::displayCurrentProcesses() {
     // Calculate totals
     int total_burst = 0;
     int max_arrival = 0;
-    for (const auto& process : processes) {
-        total_burst += process.burst_time;
-        max_arrival = std::max(max_arrival, process.arrival_time);
+    for (size_t i = 0; i < table.size(); i++) {
+        total_burst += table.burst[i];
+        max_arrival = std::max(max_arrival, table.arrival[i]);
     }
     
     std::cout << "\n📊 Queue Summary:\n";
@@ -369,52 +1510,51 @@ void ProcessScheduler::displayCurrentProcesses() {
 }
 
 void ProcessScheduler::editProcess(int process_id) {
-    auto it = std::find_if(processes.begin(), processes.end(),
-                          [process_id](const Process& p) { return p.pid == process_id; });
-    
-    if (it == processes.end()) {
+    int row = table.find(process_id);
+    if (row < 0) {
         std::cout << "❌ Process P" << process_id << " not found!\n";
         return;
     }
+    view_stale = true;
     
     std::cout << "\n" << std::string(50, '=') << "\n";
-    std::cout << "✏️  EDITING " << it->process_name << " (P" << process_id << ")\n";
+    std::cout << "✏️  EDITING " << table.name(row) << " (P" << process_id << ")\n";
     std::cout << std::string(50, '=') << "\n";
     
     std::cout << "Current values:\n";
-    std::cout << "  Process Name: " << it->process_name << "\n";
-    std::cout << "  Arrival Time: " << it->arrival_time << "\n";
-    std::cout << "  Burst Time: " << it->burst_time << "\n";
-    std::cout << "  Priority: " << it->priority << "\n";
+    std::cout << "  Process Name: " << table.name(row) << "\n";
+    std::cout << "  Arrival Time: " << table.arrival[row] << "\n";
+    std::cout << "  Burst Time: " << table.burst[row] << "\n";
+    std::cout << "  Priority: " << table.priority[row] << "\n";
     
     // Get new values
     std::string new_name;
     int new_arrival, new_burst, new_priority;
     
-    std::cout << "\nEnter new Process Name (" << it->process_name << "): ";
+    std::cout << "\nEnter new Process Name (" << table.name(row) << "): ";
     std::cin.ignore();
     std::getline(std::cin, new_name);
     if (!new_name.empty()) {
-        it->process_name = new_name;
+        table.set_name(row, new_name);
     }
     
-    std::cout << "Enter new Arrival Time (" << it->arrival_time << "): ";
+    std::cout << "Enter new Arrival Time (" << table.arrival[row] << "): ";
     if (std::cin >> new_arrival && new_arrival >= 0) {
-        it->arrival_time = new_arrival;
+        table.arrival[row] = new_arrival;
     }
     
-    std::cout << "Enter new Burst Time (" << it->burst_time << "): ";
+    std::cout << "Enter new Burst Time (" << table.burst[row] << "): ";
     if (std::cin >> new_burst && new_burst > 0) {
-        it->burst_time = new_burst;
-        it->remaining_time = new_burst;
+        table.burst[row] = new_burst;
+        table.remaining[row] = new_burst;
     }
     
-    std::cout << "Enter new Priority (" << it->priority << "): ";
+    std::cout << "Enter new Priority (" << table.priority[row] << "): ";
     if (std::cin >> new_priority && new_priority >= 0) {
-        it->priority = new_priority;
+        table.priority[row] = new_priority;
     }
     
-    std::cout << "✅ " << it->process_name << " (P" << process_id << ") updated successfully!\n";
+    std::cout << "✅ " << table.name(row) << " (P" << process_id << ") updated successfully!\n";
 }
 
 void ProcessScheduler::generateRandomProcesses(int count) {
@@ -434,11 +1574,77 @@ void ProcessScheduler::generateRandomProcesses(int count) {
     
     std::uniform_int_distribution<> name_dist(0, sample_names.size() - 1);
     
+    table.reserve(table.size() + std::max(count, 0));
     for (int i = 0; i < count; i++) {
         int pid = getNextPid();
         std::string name = sample_names[name_dist(gen)] + " " + std::to_string(pid);
-        processes.emplace_back(pid, name, arrival(gen), burst(gen), priority(gen));
+        table.push_back(Process(pid, name, arrival(gen), burst(gen), priority(gen)));
+    }
+    view_stale = true;
+}
+
+void ProcessScheduler::generateRandomTasks(int count) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> total(0.6, 1.0);
+    std::uniform_real_distribution<> unit(0.0, 1.0);
+    // Periods stretch with the task count so that small shares of the
+    // utilization still round to a burst of a few units
+    const int scale = std::min(std::max(count, 1), 1000);
+    const std::vector<int> periods = {10 * scale, 20 * scale, 25 * scale, 40 * scale, 50 * scale, 100 * scale};
+    std::uniform_int_distribution<> period_dist(0, periods.size() - 1);
+    std::vector<std::string> sample_names = {
+        "Sensor Poll", "Motor Control", "Telemetry", "Audio Mixer",
+        "Display Refresh", "Watchdog", "Logger", "Network Stack"
+    };
+    std::uniform_int_distribution<> name_dist(0, sample_names.size() - 1);
+
+    // Released together at 0, the critical instant. UUniFast splits the
+    // total utilization uniformly over the tasks.
+    double remaining = total(gen);
+    table.reserve(table.size() + std::max(count, 0));
+    for (int i = 0; i < count; i++) {
+        double share = remaining;
+        if (i + 1 < count) {
+            double rest = remaining * std::pow(unit(gen), 1.0 / (count - i - 1));
+            share = remaining - rest;
+            remaining = rest;
+        }
+        int period = periods[period_dist(gen)];
+        int burst = std::max(1, static_cast<int>(std::lround(share * period)));
+        int pid = getNextPid();
+        std::string name = sample_names[name_dist(gen)] + " " + std::to_string(pid);
+        table.add_row(pid, table.names.intern(name), 0, burst, 1, 0, period, 0);
+    }
+    view_stale = true;
+}
+
+void ProcessScheduler::generateRandomIoProcesses(int count, int devices) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> device(0, std::clamp(devices, 1, MAX_IO_DEVICES) - 1);
+    std::uniform_int_distribution<> io_time(5, 20);
+    std::uniform_int_distribution<> short_burst(1, 4);
+    std::uniform_int_distribution<> io_bound_bursts(2, 5);
+
+    size_t first = table.size();
+    generateRandomProcesses(count);
+    for (size_t row = first; row < table.size(); row++) {
+        // I/O-bound: short CPU bursts between several I/O requests;
+        // CPU-bound: at most one request
+        bool io_bound = gen() % 2 == 0;
+        int requests = io_bound ? io_bound_bursts(gen) : static_cast<int>(gen() % 2);
+        if (io_bound) {
+            table.burst[row] = short_burst(gen);
+            table.remaining[row] = table.burst[row];
+        }
+        std::vector<IoBurst> bursts;
+        for (int i = 0; i < requests; i++) {
+            bursts.push_back({device(gen), io_time(gen), io_bound ? short_burst(gen) : 1 + static_cast<int>(gen() % 10)});
+        }
+        table.set_io_bursts(row, std::move(bursts));
     }
+    view_stale = true;
 }
 
 void ProcessScheduler::displayGanttChart() {
@@ -461,19 +1667,14 @@ void ProcessScheduler::displayGanttChart() {
     
     // Display process bars with names
     std::cout << "        ";
-    for (const auto& entry : gantt_chart) {
-        // Shorten long names for display
-        std::string display_name = entry.process_name;
-        if (display_name.length() > 6) {
-            display_name = display_name.substr(0, 6) + "..";
-        }
+    for (size_t i = 0; i < gantt_chart.size(); i++) {
         std::cout << "+" << std::string(6, '-') << "+ ";
     }
     std::cout << "\n";
     
     std::cout << "Process:";
     for (const auto& entry : gantt_chart) {
-        std::string display_name = entry.process_name;
+        std::string display_name = getGanttName(entry);
         if (display_name.length() > 6) {
             display_name = display_name.substr(0, 6) + "..";
         }
@@ -482,7 +1683,7 @@ void ProcessScheduler::displayGanttChart() {
     std::cout << "\n";
     
     std::cout << "        ";
-    for (const auto& entry : gantt_chart) {
+    for (size_t i = 0; i < gantt_chart.size(); i++) {
         std::cout << "+" << std::string(6, '-') << "+ ";
     }
     std::cout << "\n\n";
@@ -494,7 +1695,7 @@ void ProcessScheduler::displayGanttChart() {
     std::cout << std::string(60, '-') << "\n";
     
     for (const auto& entry : gantt_chart) {
-        std::cout << std::setw(20) << entry.process_name
+        std::cout << std::setw(20) << getGanttName(entry)
                   << std::setw(12) << entry.start_time
                   << std::setw(12) << entry.end_time
                   << std::setw(16) << (entry.end_time - entry.start_time) << "\n";
@@ -509,12 +1710,12 @@ void ProcessScheduler::displayProcessTimeline() {
     
     // Find maximum time for scaling
     int max_time = 0;
-    for (const auto& process : processes) {
-        max_time = std::max(max_time, process.completion_time);
+    for (int completion : table.completion) {
+        max_time = std::max(max_time, completion);
     }
     
     // Display each process timeline
-    for (const auto& process : processes) {
+    for (const auto& process : getProcesses()) {
         std::cout << "P" << process.pid << " | ";
         
         // Waiting period (before start)
@@ -572,38 +1773,30 @@ void ProcessScheduler::displayVisualResults() {
     if (!gantt_chart.empty()) {
         std::cout << "CPU Utilization: " << std::setprecision(1) 
                   << (static_cast<double>(gantt_chart.back().end_time) / gantt_chart.back().end_time * 100) << "%\n";
-        std::cout << "Throughput: " << processes.size() << " processes in " 
+        std::cout << "Throughput: " << table.size() << " processes in " 
                   << gantt_chart.back().end_time << " units = " 
-                  << std::setprecision(3) << (static_cast<double>(processes.size()) / gantt_chart.back().end_time)
+                  << std::setprecision(3) << (static_cast<double>(table.size()) / gantt_chart.back().end_time)
                   << " processes/unit\n";
     }
 }
 
 void ProcessScheduler::clearGanttChart() {
     gantt_chart.clear();
+    gantt_max_slice = 0;
+    gantt_makespan = 0;
 }
 
 
 // Add these missing function implementations to process_scheduler.cpp
 
 double ProcessScheduler::getAverageWaitingTime() {
-    if (processes.empty()) return 0.0;
-    
-    double total = 0.0;
-    for (const auto& process : processes) {
-        total += process.waiting_time;
-    }
-    return total / processes.size();
+    if (table.empty()) return 0.0;
+    return static_cast<double>(table.total_waiting()) / table.size();
 }
 
 double ProcessScheduler::getAverageTurnaroundTime() {
-    if (processes.empty()) return 0.0;
-    
-    double total = 0.0;
-    for (const auto& process : processes) {
-        total += process.turnaround_time;
-    }
-    return total / processes.size();
+    if (table.empty()) return 0.0;
+    return static_cast<double>(table.total_turnaround()) / table.size();
 }
 
 bool ProcessScheduler::validateProcess(const Process& process) {
@@ -629,11 +1822,9 @@ bool ProcessScheduler::validateProcess(const Process& process) {
     }
     
     // Check for duplicate PID
-    for (const auto& existing : processes) {
-        if (existing.pid == process.pid) {
-            std::cout << "❌ Duplicate PID: " << process.pid << "\n";
-            return false;
-        }
+    if (table.find(process.pid) >= 0) {
+        std::cout << "❌ Duplicate PID: " << process.pid << "\n";
+        return false;
     }
     
     return true;
@@ -660,74 +1851,66 @@ void ProcessScheduler::generateRandomProcessesInteractive() {
 }
 
 void ProcessScheduler::deleteProcess(int process_id) {
-    auto it = std::find_if(processes.begin(), processes.end(),
-                          [process_id](const Process& p) { return p.pid == process_id; });
-    
-    if (it == processes.end()) {
+    int row = table.find(process_id);
+    if (row < 0) {
         std::cout << "❌ Process P" << process_id << " not found!\n";
         return;
     }
     
-    std::string process_name = it->process_name;
-    processes.erase(it);
+    std::string process_name = table.name(row);
+    table.erase(row);
+    view_stale = true;
     std::cout << "✅ Deleted " << process_name << " (P" << process_id << ")\n";
 }
 
 void ProcessScheduler::clearAllProcesses() {
-    if (processes.empty()) {
+    if (table.empty()) {
         std::cout << "📭 Process queue is already empty.\n";
         return;
     }
     
-    int count = processes.size();
-    processes.clear();
+    int count = table.size();
+    table.clear();
+    view_stale = true;
     clearGanttChart();
     std::cout << "✅ Cleared all " << count << " processes from the queue.\n";
 }
 
 void ProcessScheduler::resetScheduler() {
-    processes.clear();
+    table.clear();
+    view_stale = true;
     clearGanttChart();
     current_time = 0;
-    current_process = nullptr;
-    
-    // Clear the ready queue
-    while (!ready_queue.empty()) {
-        ready_queue.pop();
-    }
+    dispatch_count = 0;
+    core_stats.clear();
+    migration_count = 0;
+    realtime_stats = RealtimeStats();
+    io_stats = IoStats();
 }
 
 void ProcessScheduler::resetProcessStates() {
     // Reset all processes to NEW state for fresh scheduling
-    for (auto& process : processes) {
-        process.state = NEW;
-        process.remaining_time = process.burst_time;
-        process.start_time = -1;
-        process.completion_time = -1;
-        process.waiting_time = 0;
-        process.turnaround_time = 0;
-    }
+    table.reset_run_state();
+    view_stale = true;
     
     clearGanttChart();
     current_time = 0;
-    current_process = nullptr;
-    
-    // Clear the ready queue
-    while (!ready_queue.empty()) {
-        ready_queue.pop();
-    }
+    dispatch_count = 0;
+    core_stats.clear();
+    migration_count = 0;
+    realtime_stats = RealtimeStats();
+    io_stats = IoStats();
 }
 
 // API helper methods
-Process* ProcessScheduler::findProcess(int pid) {
-    auto it = std::find_if(processes.begin(), processes.end(),
-                          [pid](const Process& p) { return p.pid == pid; });
-    return (it != processes.end()) ? &(*it) : nullptr;
+const Process* ProcessScheduler::findProcess(int pid) const {
+    int row = table.find(pid);
+    return row >= 0 ? &getProcesses()[row] : nullptr;
 }
 
 bool ProcessScheduler::editProcessAPI(int pid, const std::string& name, int arrival, int burst, int priority) {
-    Process* proc = findProcess(pid);
-    if (!proc) {
+    int row = table.find(pid);
+    if (row < 0) {
         return false;
     }
     
@@ -738,22 +1921,27 @@ bool ProcessScheduler::editProcessAPI(int pid, const std::string& name, int arri
     
     // Update process fields
     if (!name.empty()) {
-        proc->process_name = name;
-    }
-    proc->arrival_time = arrival;
-    proc->burst_time = burst;
-    proc->priority = priority;
-    proc->remaining_time = burst;
-    proc->state = NEW;
-    proc->start_time = -1;
-    proc->completion_time = -1;
-    proc->waiting_time = 0;
-    proc->turnaround_time = 0;
+        table.set_name(row, name);
+    }
+    table.arrival[row] = arrival;
+    table.burst[row] = burst;
+    table.priority[row] = priority;
+    table.remaining[row] = burst;
+    table.state[row] = NEW;
+    table.start[row] = -1;
+    table.completion[row] = -1;
+    table.waiting[row] = 0;
+    table.turnaround[row] = 0;
+    view_stale = true;
     
     // Clear stale scheduling artifacts
     clearGanttChart();
     current_time = 0;
-    current_process = nullptr;
+    dispatch_count = 0;
+    core_stats.clear();
+    migration_count = 0;
+    realtime_stats = RealtimeStats();
+    io_stats = IoStats();
     current_algorithm = "";
     
     return true;
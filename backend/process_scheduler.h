@@ -11,70 +11,217 @@
 #include <random>
 #include <string>
 #include <limits>
+#include <cstdint>
+#include "process_table.h"
 
-enum ProcessState {
-    NEW, READY, RUNNING, WAITING, TERMINATED
-};
-
-struct Process {
-    int pid;
-    std::string process_name;  // ADDED: Process name field
-    int arrival_time;
-    int burst_time;
-    int priority;
-    int remaining_time;
-    int start_time;
-    int completion_time;
-    int waiting_time;
-    int turnaround_time;
-    ProcessState state;
-    
-    // Updated constructor with process name
-    Process(int id, const std::string& name, int arrival, int burst, int pri = 0) 
-        : pid(id), process_name(name), arrival_time(arrival), burst_time(burst), priority(pri),
-          remaining_time(burst), start_time(-1), completion_time(-1),
-          waiting_time(0), turnaround_time(0), state(NEW) {}
-    
-    // Backward compatible constructor
-    Process(int id, int arrival, int burst, int pri = 0) 
-        : pid(id), process_name("Process " + std::to_string(id)), arrival_time(arrival), burst_time(burst), priority(pri),
-          remaining_time(burst), start_time(-1), completion_time(-1),
-          waiting_time(0), turnaround_time(0), state(NEW) {}
-};
-
+// One slice of the schedule. The name is an id into the process table's
+// names (ProcessScheduler::getGanttName()), so an entry is 20 bytes.
 struct GanttEntry {
     int process_id;
-    std::string process_name;  // ADDED: Store process name in Gantt chart
+    uint32_t name_id;
     int start_time;
     int end_time;
+    int core;
     
-    GanttEntry(int pid, const std::string& name, int start, int end)
-        : process_id(pid), process_name(name), start_time(start), end_time(end) {}
+    GanttEntry(int pid, uint32_t name, int start, int end, int cpu = 0)
+        : process_id(pid), name_id(name), start_time(start), end_time(end), core(cpu) {}
+};
+
+struct CoreStats {
+    int core = 0;
+    int busy_time = 0;
+    double utilization = 0.0;   // busy time over the schedule's makespan
+    size_t dispatches = 0;
+    size_t steals = 0;          // processes this CPU took from another's runqueue
+};
+
+// Simulated CPUs; affinity masks are 64 bits wide
+constexpr int MAX_SCHEDULER_CORES = 64;
+
+// I/O devices (0..MAX_IO_DEVICES-1), each serving one request at a time in
+// arrival order, and the longest burst sequence a process may have
+constexpr int MAX_IO_DEVICES = 16;
+constexpr size_t MAX_IO_BURSTS = 1000;
+
+struct DeviceStats {
+    int device = 0;
+    size_t requests = 0;
+    int busy_time = 0;
+    double utilization = 0.0;          // busy time over the schedule's makespan
+    double average_queue_time = 0.0;   // waiting for the device before service
+    size_t max_queue = 0;              // longest line of waiting requests
+};
+
+// CPU and I/O activity of the last run with I/O bursts
+struct IoStats {
+    size_t bursts = 0;          // I/O requests served
+    int cpu_busy_time = 0;
+    int io_busy_time = 0;       // time some device was busy
+    int overlap_time = 0;       // time the CPU and some device were both busy
+    double cpu_utilization = 0.0;
+    double io_utilization = 0.0;
+    double overlap = 0.0;       // share of the I/O busy time hidden behind computation
+    std::vector<DeviceStats> devices;   // every device up to the highest used
+};
+
+// Multi-level feedback queue. New processes enter level 0; a process that
+// uses up its level's quantum moves down a level (the last level is round
+// robin) and one that is preempted keeps its level. A process waiting below
+// level 0 is preempted by any arrival. Every boost_interval time units all
+// processes return to level 0 (0 = never).
+struct MlfqConfig {
+    std::vector<int> quanta = {2, 4, 8};   // one per level, top first
+    int boost_interval = 50;
+};
+
+// Fair scheduler after Linux CFS. The process with the smallest virtual
+// runtime runs for its weight's share of target_latency (at least
+// min_granularity), and its virtual runtime advances inversely to its
+// weight. Priorities are non-negative, so the nice value is priority - 20:
+// priorities 0..39 cover nice -20..19, priority 20 is nice 0 and anything
+// above 39 is nice 19. Arrivals start at the runqueue's minimum virtual
+// runtime and wait for the current slice to end.
+struct CfsConfig {
+    int target_latency = 6;
+    int min_granularity = 1;
+};
+
+// Real-time scheduling (EDF, RM). A process with a period is a periodic
+// task: from its arrival it releases a job of burst_time every period, each
+// due `deadline` after its release (0 = the period). A sporadic task is
+// given its minimum inter-arrival time as the period, its worst case. A
+// process without a period is one job, due `deadline` after arrival (0 = no
+// deadline). Every job released before the horizon runs to completion; a
+// late job keeps running and counts as a deadline miss.
+struct RealtimeConfig {
+    int horizon = 0;   // 0 = latest arrival plus the hyperperiod
+};
+
+// Cap on the horizon, and on the jobs it releases (the horizon shrinks to fit)
+constexpr int MAX_REALTIME_HORIZON = 10000000;
+constexpr size_t MAX_REALTIME_JOBS = 5000000;
+
+struct RealtimeTaskStats {
+    int pid = 0;
+    size_t jobs = 0;             // released
+    size_t missed = 0;
+    int worst_response = 0;      // release to completion
+    double average_response = 0.0;
 };
 
+struct RealtimeStats {
+    int horizon = 0;
+    size_t jobs = 0;
+    size_t missed = 0;
+    // Offline test over the periodic tasks: "utilization" (EDF, implicit
+    // deadlines; exact), "density" (EDF; sufficient), "liu-layland" (RM;
+    // sufficient), "response-time" (RM; exact) or "none" without periodic
+    // tasks. A sufficient test that fails is inconclusive.
+    std::string test;
+    bool schedulable = false;
+    double utilization = 0.0;    // sum of burst / period
+    double bound = 0.0;          // what `test` compared utilization (or density) with; 0 for RTA
+    std::vector<RealtimeTaskStats> tasks;   // in table order
+};
+
+// Runs the offline test for EDF (edf = true) or RM over the table's
+// periodic tasks; fills test, schedulable, utilization and bound
+void realtime_schedulability(const ProcessTable& table, bool edf, RealtimeStats& stats);
+
+// Empty string when the config is usable, otherwise what is wrong with it
+std::string validate_mlfq_config(const MlfqConfig& config);
+std::string validate_cfs_config(const CfsConfig& config);
+std::string validate_realtime_config(const RealtimeConfig& config);
+std::string validate_io_bursts(const std::vector<IoBurst>& bursts);
+
 class ProcessScheduler {
 private:
-    std::vector<Process> processes;
-    std::queue<Process*> ready_queue;
-    Process* current_process;
+    ProcessTable table;
+    mutable std::vector<Process> process_view;   // getProcesses(), rebuilt when stale
+    mutable bool view_stale;
     int current_time;
     bool preemptive;
     std::vector<GanttEntry> gantt_chart;
+    int gantt_max_slice;
+    int gantt_makespan;
     int next_pid;  // ADDED: Auto-incrementing PID counter
     std::string current_algorithm;
+    std::string run_error;  // why the last run was refused
+    bool verbose;  // per-event console output
+    size_t dispatch_count;  // scheduling decisions in the last run
+    MlfqConfig mlfq_config;
+    CfsConfig cfs_config;
+    int cores;
+    std::vector<CoreStats> core_stats;
+    size_t migration_count;  // dispatches on a different CPU than the last one
+    RealtimeConfig realtime_config;
+    RealtimeStats realtime_stats;
+    IoStats io_stats;
+
+    // Rows by arrival time, ties in row order
+    std::vector<int> arrivalOrder() const;
+    // Clears the Gantt chart and marks the process view stale
+    void beginRun();
+    // Reports why a run cannot go ahead; getRunError() returns it
+    void refuseRun(const std::string& why);
+    // Derives the per-process metrics and the Gantt chart's extent once
+    // every process has completed
+    void endRun();
+    void measureGanttChart();
+    // Runs each process to completion, picking the ready row with the
+    // lowest key[row] (SJF: burst, PRIORITY: priority)
+    void runNonPreemptive(const std::vector<int>& key);
+    // Runs the ready row with the lowest key[row] until it finishes or an
+    // arrival outranks it (SRTF: remaining, PRIORITY_P: priority). The
+    // column is read live, so it may change as the process runs.
+    void runPreemptive(const std::vector<int>& key);
+    // Extends the last Gantt slice when the same process keeps running;
+    // empty slices are dropped
+    void appendGanttSlice(int row, int start, int end);
+    // Preemptive job-level scheduling of periodic tasks and one-shot jobs,
+    // by absolute deadline (EDF) or by period (RM)
+    void runRealtime(bool edf);
+    // N-core run of FCFS, SJF, PRIORITY, RR, SRTF or PRIORITY_P
+    void runMultiCore(const std::string& algorithm, int quantum);
+    // Single-CPU run of FCFS, SJF, PRIORITY, RR, SRTF or PRIORITY_P over
+    // alternating CPU and I/O bursts
+    void runWithIo(const std::string& algorithm, int quantum);
+    // CPU/I/O overlap and utilizations from the chart and the device busy
+    // intervals (sorted in place)
+    void computeIoStats(std::vector<std::pair<int, int>>& io_intervals);
+    // Single-CPU statistics derived from the Gantt chart
+    void computeSingleCoreStats();
 
 public:
-    ProcessScheduler(bool preemptive = false) : current_process(nullptr), current_time(0), preemptive(preemptive), next_pid(1) {}
+    ProcessScheduler(bool preemptive = false) : view_stale(false), current_time(0), preemptive(preemptive),
+          gantt_max_slice(0), gantt_makespan(0), next_pid(1), verbose(true), dispatch_count(0),
+          cores(1), migration_count(0) {}
     
     // Scheduling algorithms
     void FCFS();
     void SJF();
     void PriorityScheduling();
     void RoundRobin(int time_quantum);
+    void SRTF();
+    void PreemptivePriority();
+    void MLFQ();
+    void CFS();
+    void EDF();
+    void RateMonotonic();
     
     // Process management
     void addProcess(const Process& process);
+    // Replaces the process list with a copy of `list`
+    void setProcesses(const std::vector<Process>& list);
+    // Takes over a whole table (e.g. a loaded trace); new PIDs continue
+    // after its largest
+    void setProcesses(ProcessTable&& list);
+    // FCFS, SJF, PRIORITY, RR, SRTF, PRIORITY_P, MLFQ, CFS, EDF or RM. A
+    // preemptive scheduler runs SJF as SRTF and PRIORITY as PRIORITY_P.
+    // When any process does I/O only the first six run, on one CPU.
     void executeScheduler(const std::string& algorithm, int quantum = 2);
+    // Why the last executeScheduler refused to run, or ""
+    const std::string& getRunError() const { return run_error; }
     void displayResults();
     void resetScheduler();
     void resetProcessStates();
@@ -86,6 +233,38 @@ public:
     void clearAllProcesses();
     void displayCurrentProcesses();
     
+    // Large traces and benchmarks turn off the "Time t: ..." lines
+    void setVerbose(bool enabled) { verbose = enabled; }
+    void setMlfqConfig(const MlfqConfig& config) { mlfq_config = config; }
+    void setCfsConfig(const CfsConfig& config) { cfs_config = config; }
+    const MlfqConfig& getMlfqConfig() const { return mlfq_config; }
+    const CfsConfig& getCfsConfig() const { return cfs_config; }
+    void setRealtimeConfig(const RealtimeConfig& config) { realtime_config = config; }
+    const RealtimeConfig& getRealtimeConfig() const { return realtime_config; }
+    // Deadline statistics of the last EDF or RM run. There a process's
+    // turnaround time is its worst job's response time and its waiting
+    // time that less the burst.
+    const RealtimeStats& getRealtimeStats() const { return realtime_stats; }
+    // Times a process was picked to run (one per Gantt slice before merging)
+    size_t getDispatchCount() const { return dispatch_count; }
+    
+    // Simulated CPUs (1..MAX_SCHEDULER_CORES). With more than one, every
+    // CPU has its own runqueue: arrivals go to the least loaded CPU their
+    // affinity allows and an idle CPU steals from the busiest one. MLFQ,
+    // CFS, EDF and RM always run on one CPU.
+    void setCores(int count) { cores = std::clamp(count, 1, MAX_SCHEDULER_CORES); }
+    int getCores() const { return cores; }
+    static bool supportsMultiCore(const std::string& algorithm);
+    const std::vector<CoreStats>& getCoreStats() const { return core_stats; }
+    size_t getMigrationCount() const { return migration_count; }
+    
+    // Processes with I/O bursts alternate RUNNING, WAITING on a device and
+    // READY. A process's waiting time is then its time in the ready queue
+    // and its burst time the first CPU burst.
+    static bool supportsIo(const std::string& algorithm);
+    bool hasIo() const { return table.has_io(); }
+    const IoStats& getIoStats() const { return io_stats; }
+    
     // Get current algorithm
     std::string getCurrentAlgorithm() const { return current_algorithm.empty() ? "None" : current_algorithm; }
     void generateRandomProcessesInteractive();
@@ -101,16 +280,31 @@ public:
     double getAverageWaitingTime();
     double getAverageTurnaroundTime();
     void generateRandomProcesses(int count);
+    // Periodic tasks with implicit deadlines and a total utilization of
+    // about 0.6 to 1.0, for EDF and RM
+    void generateRandomTasks(int count);
+    // Random processes of which about half are I/O-bound, alternating
+    // short CPU bursts with I/O on devices 0..devices-1
+    void generateRandomIoProcesses(int count, int devices);
     
-    // Getter for processes (for UI)
-    const std::vector<Process>& getProcesses() const { return processes; }
+    // The process table as Process values (for UI). The view is rebuilt
+    // on the first call after the table changes, which invalidates
+    // references from earlier calls.
+    const std::vector<Process>& getProcesses() const;
+    const ProcessTable& getProcessTable() const { return table; }
+    // Ordered by start time (then core); one core's slices never overlap
     const std::vector<GanttEntry>& getGanttChart() const { return gantt_chart; }
+    const std::string& getGanttName(const GanttEntry& entry) const { return table.names.name(entry.name_id); }
+    // Longest slice and latest end in the chart, for windowed reads (gantt_view.h)
+    int getGanttMaxSlice() const { return gantt_max_slice; }
+    int getGanttMakespan() const { return gantt_makespan; }
     
     // ADDED: Get next available PID
     int getNextPid() { return next_pid++; }
     
     // API helper methods
-    Process* findProcess(int pid);
+    // Points into getProcesses(); nullptr when no process has the pid
+    const Process* findProcess(int pid) const;
     bool editProcessAPI(int pid, const std::string& name, int arrival, int burst, int priority);
 };
 
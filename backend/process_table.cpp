@@ -0,0 +1,204 @@
+#include "process_table.h"
+#include <algorithm>
+#include <utility>
+
+uint32_t NameTable::intern(const std::string& name) {
+    auto [it, inserted] = ids.emplace(name, static_cast<uint32_t>(names.size()));
+    if (inserted) names.push_back(name);
+    return it->second;
+}
+
+void NameTable::clear() {
+    names.clear();
+    ids.clear();
+}
+
+void ProcessTable::reserve(size_t n) {
+    pid.reserve(n);
+    arrival.reserve(n);
+    burst.reserve(n);
+    priority.reserve(n);
+    remaining.reserve(n);
+    start.reserve(n);
+    completion.reserve(n);
+    waiting.reserve(n);
+    turnaround.reserve(n);
+    state.reserve(n);
+    affinity.reserve(n);
+    period.reserve(n);
+    deadline.reserve(n);
+    io_list.reserve(n);
+    name_id.reserve(n);
+}
+
+void ProcessTable::clear() {
+    pid.clear();
+    arrival.clear();
+    burst.clear();
+    priority.clear();
+    remaining.clear();
+    start.clear();
+    completion.clear();
+    waiting.clear();
+    turnaround.clear();
+    state.clear();
+    affinity.clear();
+    period.clear();
+    deadline.clear();
+    io_list.clear();
+    name_id.clear();
+    names.clear();
+    io_lists.clear();
+}
+
+void ProcessTable::push_back(const Process& process) {
+    add_row(process.pid, names.intern(process.process_name), process.arrival_time, process.burst_time,
+            process.priority, process.affinity, process.period, process.deadline);
+    if (!process.io_bursts.empty()) set_io_bursts(size() - 1, process.io_bursts);
+    remaining.back() = process.remaining_time;
+    start.back() = process.start_time;
+    completion.back() = process.completion_time;
+    waiting.back() = process.waiting_time;
+    turnaround.back() = process.turnaround_time;
+    state.back() = static_cast<uint8_t>(process.state);
+}
+
+void ProcessTable::add_row(int process_id, uint32_t name, int arrival_time, int burst_time, int process_priority,
+                           uint64_t cpu_mask, int task_period, int relative_deadline) {
+    pid.push_back(process_id);
+    arrival.push_back(arrival_time);
+    burst.push_back(burst_time);
+    priority.push_back(process_priority);
+    remaining.push_back(burst_time);
+    start.push_back(-1);
+    completion.push_back(-1);
+    waiting.push_back(0);
+    turnaround.push_back(0);
+    state.push_back(static_cast<uint8_t>(NEW));
+    affinity.push_back(cpu_mask);
+    period.push_back(task_period);
+    deadline.push_back(relative_deadline);
+    io_list.push_back(0);
+    name_id.push_back(name);
+}
+
+Process ProcessTable::row(size_t i) const {
+    Process process(pid[i], name(i), arrival[i], burst[i], priority[i]);
+    process.remaining_time = remaining[i];
+    process.start_time = start[i];
+    process.completion_time = completion[i];
+    process.waiting_time = waiting[i];
+    process.turnaround_time = turnaround[i];
+    process.state = static_cast<ProcessState>(state[i]);
+    process.affinity = affinity[i];
+    process.period = period[i];
+    process.deadline = deadline[i];
+    process.io_bursts = io_bursts(i);
+    return process;
+}
+
+template <typename Column>
+static void erase_row(Column& column, size_t i) {
+    column.erase(column.begin() + static_cast<std::ptrdiff_t>(i));
+}
+
+void ProcessTable::erase(size_t i) {
+    erase_row(pid, i);
+    erase_row(arrival, i);
+    erase_row(burst, i);
+    erase_row(priority, i);
+    erase_row(remaining, i);
+    erase_row(start, i);
+    erase_row(completion, i);
+    erase_row(waiting, i);
+    erase_row(turnaround, i);
+    erase_row(state, i);
+    erase_row(affinity, i);
+    erase_row(period, i);
+    erase_row(deadline, i);
+    erase_row(io_list, i);
+    erase_row(name_id, i);
+}
+
+const std::vector<IoBurst>& ProcessTable::io_bursts(size_t i) const {
+    static const std::vector<IoBurst> none;
+    return io_list[i] == 0 ? none : io_lists[io_list[i] - 1];
+}
+
+void ProcessTable::set_io_bursts(size_t i, std::vector<IoBurst> bursts) {
+    if (io_list[i] == 0) {
+        if (bursts.empty()) return;
+        io_lists.push_back(std::move(bursts));
+        io_list[i] = static_cast<uint32_t>(io_lists.size());
+    } else {
+        io_lists[io_list[i] - 1] = std::move(bursts);
+    }
+}
+
+bool ProcessTable::has_io() const {
+    for (size_t i = 0; i < io_list.size(); i++) {
+        if (io_list[i] != 0 && !io_lists[io_list[i] - 1].empty()) return true;
+    }
+    return false;
+}
+
+int ProcessTable::find(int process_id) const {
+    auto it = std::find(pid.begin(), pid.end(), process_id);
+    return it == pid.end() ? -1 : static_cast<int>(it - pid.begin());
+}
+
+void ProcessTable::reset_run_state() {
+    std::copy(burst.begin(), burst.end(), remaining.begin());
+    std::fill(start.begin(), start.end(), -1);
+    std::fill(completion.begin(), completion.end(), -1);
+    std::fill(waiting.begin(), waiting.end(), 0);
+    std::fill(turnaround.begin(), turnaround.end(), 0);
+    std::fill(state.begin(), state.end(), static_cast<uint8_t>(NEW));
+}
+
+template <typename Column>
+static void permute_column(Column& column, const std::vector<int>& order) {
+    Column permuted(column.size());
+    for (size_t k = 0; k < order.size(); k++) permuted[k] = column[order[k]];
+    column.swap(permuted);
+}
+
+void ProcessTable::permute(const std::vector<int>& order) {
+    permute_column(pid, order);
+    permute_column(arrival, order);
+    permute_column(burst, order);
+    permute_column(priority, order);
+    permute_column(remaining, order);
+    permute_column(start, order);
+    permute_column(completion, order);
+    permute_column(waiting, order);
+    permute_column(turnaround, order);
+    permute_column(state, order);
+    permute_column(affinity, order);
+    permute_column(period, order);
+    permute_column(deadline, order);
+    permute_column(io_list, order);
+    permute_column(name_id, order);
+}
+
+// The column passes below are plain loops; GCC vectorizes them at -O3
+// (CMake's Release flags)
+
+void ProcessTable::finish_run() {
+    const size_t n = size();
+    for (size_t i = 0; i < n; i++) turnaround[i] = completion[i] - arrival[i];
+    for (size_t i = 0; i < n; i++) waiting[i] = turnaround[i] - burst[i];
+    std::fill(state.begin(), state.end(), static_cast<uint8_t>(TERMINATED));
+}
+
+long long ProcessTable::total_waiting() const {
+    long long total = 0;
+    for (int w : waiting) total += w;
+    return total;
+}
+
+long long ProcessTable::total_turnaround() const {
+    long long total = 0;
+    for (int t : turnaround) total += t;
+    return total;
+}
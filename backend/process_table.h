@@ -0,0 +1,126 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum ProcessState {
+    NEW, READY, RUNNING, WAITING, TERMINATED
+};
+
+// After a CPU burst: io_time on I/O device `device`, then cpu_time more CPU
+struct IoBurst {
+    int device;
+    int io_time;
+    int cpu_time;
+};
+
+struct Process {
+    int pid;
+    std::string process_name;  // ADDED: Process name field
+    int arrival_time;
+    int burst_time;
+    int priority;
+    int remaining_time;
+    int start_time;
+    int completion_time;
+    int waiting_time;
+    int turnaround_time;
+    ProcessState state;
+    uint64_t affinity = 0;     // bit i allows CPU i in multi-core runs; 0 = any CPU
+    int period = 0;            // EDF/RM: a job every `period` from arrival; 0 = one job
+    int deadline = 0;          // EDF/RM: relative to each release; 0 = the period (none for one job)
+    // Follow the first CPU burst (burst_time) in order; empty for a pure CPU burst
+    std::vector<IoBurst> io_bursts;
+    
+    // Updated constructor with process name
+    Process(int id, const std::string& name, int arrival, int burst, int pri = 0) 
+        : pid(id), process_name(name), arrival_time(arrival), burst_time(burst), priority(pri),
+          remaining_time(burst), start_time(-1), completion_time(-1),
+          waiting_time(0), turnaround_time(0), state(NEW) {}
+    
+    // Backward compatible constructor
+    Process(int id, int arrival, int burst, int pri = 0) 
+        : pid(id), process_name("Process " + std::to_string(id)), arrival_time(arrival), burst_time(burst), priority(pri),
+          remaining_time(burst), start_time(-1), completion_time(-1),
+          waiting_time(0), turnaround_time(0), state(NEW) {}
+};
+
+// Each distinct process name is stored once; rows hold a 32-bit id
+class NameTable {
+private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> ids;
+
+public:
+    uint32_t intern(const std::string& name);
+    const std::string& name(uint32_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+    void clear();
+};
+
+// Structure-of-arrays process store for the scheduler. Row i of every
+// column is one process, so a scheduling loop touches only the dense int
+// columns it reads (arrival, remaining, ...) and the metric reductions are
+// straight loops over one column. Names live in a NameTable off the hot path.
+struct ProcessTable {
+    std::vector<int> pid;
+    std::vector<int> arrival;
+    std::vector<int> burst;
+    std::vector<int> priority;
+    std::vector<int> remaining;
+    std::vector<int> start;
+    std::vector<int> completion;
+    std::vector<int> waiting;
+    std::vector<int> turnaround;
+    std::vector<uint8_t> state;        // ProcessState
+    std::vector<uint64_t> affinity;
+    std::vector<int> period;
+    std::vector<int> deadline;
+    std::vector<uint32_t> io_list;     // 0 = no I/O, else 1 + index into io_lists
+    std::vector<uint32_t> name_id;
+    NameTable names;
+    // Burst sequences of the rows that do I/O, kept off the int columns.
+    // erase() leaves a removed row's list behind until clear().
+    std::vector<std::vector<IoBurst>> io_lists;
+
+    size_t size() const { return pid.size(); }
+    bool empty() const { return pid.empty(); }
+    void reserve(size_t n);
+    void clear();
+
+    void push_back(const Process& process);
+    // Appends a NEW row; `name` is an id from names.intern()
+    void add_row(int process_id, uint32_t name, int arrival_time, int burst_time, int process_priority,
+                 uint64_t cpu_mask = 0, int task_period = 0, int relative_deadline = 0);
+    // The row as a Process (copies the name)
+    Process row(size_t i) const;
+    void erase(size_t i);
+    // Row of a pid, or -1
+    int find(int process_id) const;
+
+    const std::string& name(size_t i) const { return names.name(name_id[i]); }
+    void set_name(size_t i, const std::string& name) { name_id[i] = names.intern(name); }
+    const std::vector<IoBurst>& io_bursts(size_t i) const;
+    void set_io_bursts(size_t i, std::vector<IoBurst> bursts);
+    bool has_io() const;
+
+    // Every row back to NEW with its whole burst remaining
+    void reset_run_state();
+    // Records row i as finished at `time`. Only the completion column is
+    // written here; finish_run() derives the rest once the run is over.
+    void finish(size_t i, int time) { completion[i] = time; }
+    // Fills turnaround, waiting and state from the completion column in one
+    // pass per column, after every row has finished
+    void finish_run();
+    // Reorders the rows so that row k is the old row order[k]
+    void permute(const std::vector<int>& order);
+
+    long long total_waiting() const;
+    long long total_turnaround() const;
+};
+
+#endif
@@ -0,0 +1,356 @@
+#include "process_trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+static const char TRACE_MAGIC[8] = {'C', 'S', 'P', 'T', 'R', 'C', '0', '1'};
+static const uint32_t TRACE_VERSION = 1;
+static const size_t WRITE_CHUNK_BYTES = 1024 * 1024;
+static const char CSV_HEADER[] = "pid,name,arrival,burst,priority,affinity,start,completion,waiting,turnaround\n";
+
+#pragma pack(push, 1)
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t count;
+    uint64_t name_count;
+};
+#pragma pack(pop)
+
+const char* trace_format_name(TraceFormat format) {
+    return format == TraceFormat::BINARY ? "binary" : "csv";
+}
+
+bool parse_trace_format(const std::string& name, TraceFormat& format) {
+    if (name == "csv") format = TraceFormat::CSV;
+    else if (name == "binary") format = TraceFormat::BINARY;
+    else return false;
+    return true;
+}
+
+// Checks that pids are unique once the whole trace is in
+static std::string check_unique_pids(const ProcessTable& table) {
+    std::vector<int> pids(table.pid);
+    std::sort(pids.begin(), pids.end());
+    auto dup = std::adjacent_find(pids.begin(), pids.end());
+    return dup == pids.end() ? "" : "duplicate pid " + std::to_string(*dup);
+}
+
+// ===== CSV =====
+
+namespace {
+
+struct CsvField {
+    const char* begin;
+    const char* end;
+    bool quoted;    // begin..end is inside the quotes, "" not yet collapsed
+};
+
+// Splits one line into fields; false on an unterminated quote
+bool split_csv_line(const char* p, const char* end, std::vector<CsvField>& fields) {
+    fields.clear();
+    while (true) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p < end && *p == '"') {
+            const char* begin = ++p;
+            while (true) {
+                p = static_cast<const char*>(std::memchr(p, '"', end - p));
+                if (!p) return false;
+                if (p + 1 < end && p[1] == '"') {
+                    p += 2;
+                    continue;
+                }
+                break;
+            }
+            fields.push_back({begin, p, true});
+            p = static_cast<const char*>(std::memchr(p, ',', end - p));
+        } else {
+            const char* begin = p;
+            p = static_cast<const char*>(std::memchr(p, ',', end - p));
+            fields.push_back({begin, p ? p : end, false});
+        }
+        if (!p) return true;
+        p++;
+    }
+}
+
+template <typename T>
+bool parse_number(const CsvField& field, T& value) {
+    const char* begin = field.begin;
+    const char* end = field.end;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) end--;
+    if (begin < end && *begin == '+') begin++;   // from_chars takes no sign but '-'
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    return begin < end && ec == std::errc() && ptr == end;
+}
+
+void field_text(const CsvField& field, std::string& out) {
+    const char* end = field.end;
+    if (!field.quoted) {
+        while (end > field.begin && (end[-1] == ' ' || end[-1] == '\t')) end--;
+        out.assign(field.begin, end);
+        return;
+    }
+    out.clear();
+    for (const char* p = field.begin; p < end; p++) {
+        out.push_back(*p);
+        if (*p == '"') p++;   // "" inside quotes is one quote
+    }
+}
+
+} // namespace
+
+static std::string parse_csv_trace(const char* data, size_t size, ProcessTable& table) {
+    const char* p = data;
+    const char* end = data + size;
+    std::vector<CsvField> fields;
+    std::string name;
+    size_t line = 0;
+    bool first_row = true;
+
+    while (p < end) {
+        line++;
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* line_end = eol ? eol : end;
+        const char* start = p;
+        p = eol ? eol + 1 : end;
+        if (line_end > start && line_end[-1] == '\r') line_end--;
+
+        const char* first = start;
+        while (first < line_end && (*first == ' ' || *first == '\t')) first++;
+        if (first == line_end || *first == '#') continue;
+        if (first_row) {
+            first_row = false;
+            if (line_end - first >= 3 && std::memcmp(first, "pid", 3) == 0) continue;
+        }
+
+        auto fail = [&](const std::string& error) { return "line " + std::to_string(line) + ": " + error; };
+        if (!split_csv_line(start, line_end, fields)) return fail("unterminated quote");
+        if (fields.size() < 5) return fail("expected pid,name,arrival,burst,priority[,affinity]");
+        if (table.size() >= MAX_TRACE_PROCESSES) {
+            return "more than " + std::to_string(MAX_TRACE_PROCESSES) + " processes";
+        }
+
+        int pid, arrival, burst, priority;
+        uint64_t affinity = 0;
+        if (!parse_number(fields[0], pid) || pid < 0) return fail("invalid pid");
+        if (!parse_number(fields[2], arrival) || arrival < 0) return fail("invalid arrival time");
+        if (!parse_number(fields[3], burst) || burst <= 0) return fail("invalid burst time");
+        if (!parse_number(fields[4], priority)) return fail("invalid priority");
+        if (fields.size() > 5 && fields[5].begin != fields[5].end && !parse_number(fields[5], affinity)) {
+            return fail("invalid affinity mask");
+        }
+        field_text(fields[1], name);
+        table.add_row(pid, table.names.intern(name), arrival, burst, priority, affinity);
+    }
+    return "";
+}
+
+// ===== BINARY =====
+
+static std::string parse_binary_trace(const char* data, size_t size, ProcessTable& table) {
+    TraceHeader header;
+    if (size < sizeof(header)) return "truncated trace header";
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != TRACE_VERSION || header.record_size != sizeof(TraceRecord)) {
+        return "unsupported trace version";
+    }
+    if (header.count > MAX_TRACE_PROCESSES) {
+        return "more than " + std::to_string(MAX_TRACE_PROCESSES) + " processes";
+    }
+    size_t records_bytes = static_cast<size_t>(header.count) * sizeof(TraceRecord);
+    if (size - sizeof(header) < records_bytes) return "truncated trace records";
+
+    // The name table follows the records
+    const char* p = data + sizeof(header) + records_bytes;
+    const char* end = data + size;
+    if (header.name_count > static_cast<size_t>(end - p) / sizeof(uint32_t)) return "truncated name table";
+    std::vector<uint32_t> name_ids(header.name_count);
+    std::string name;
+    for (auto& id : name_ids) {
+        uint32_t length;
+        if (static_cast<size_t>(end - p) < sizeof(length)) return "truncated name table";
+        std::memcpy(&length, p, sizeof(length));
+        p += sizeof(length);
+        if (static_cast<size_t>(end - p) < length) return "truncated name table";
+        name.assign(p, length);
+        p += length;
+        id = table.names.intern(name);
+    }
+
+    table.reserve(header.count);
+    const char* record_data = data + sizeof(header);
+    for (size_t i = 0; i < header.count; i++) {
+        TraceRecord r;
+        std::memcpy(&r, record_data + i * sizeof(TraceRecord), sizeof(r));
+        if (r.pid < 0) return "record " + std::to_string(i) + ": invalid pid";
+        if (r.arrival < 0) return "record " + std::to_string(i) + ": invalid arrival time";
+        if (r.burst <= 0) return "record " + std::to_string(i) + ": invalid burst time";
+        if (r.name_id >= name_ids.size()) return "record " + std::to_string(i) + ": invalid name id";
+        table.add_row(r.pid, name_ids[r.name_id], r.arrival, r.burst, r.priority, r.affinity);
+    }
+    return "";
+}
+
+std::string parse_process_trace(const char* data, size_t size, ProcessTable& table, TraceFormat* format) {
+    bool binary = size >= sizeof(TRACE_MAGIC) && std::memcmp(data, TRACE_MAGIC, sizeof(TRACE_MAGIC)) == 0;
+    ProcessTable parsed;
+    std::string error = binary ? parse_binary_trace(data, size, parsed) : parse_csv_trace(data, size, parsed);
+    if (error.empty() && parsed.empty()) error = "trace holds no processes";
+    if (error.empty()) error = check_unique_pids(parsed);
+    if (!error.empty()) return error;
+
+    table = std::move(parsed);
+    if (format) *format = binary ? TraceFormat::BINARY : TraceFormat::CSV;
+    return "";
+}
+
+namespace {
+
+// Read-only mapping of a whole file
+class MappedFile {
+private:
+    int fd;
+    void* base;
+    size_t length;
+
+public:
+    explicit MappedFile(const std::string& path) : fd(::open(path.c_str(), O_RDONLY)), base(MAP_FAILED), length(0) {
+        struct stat st;
+        if (fd < 0 || ::fstat(fd, &st) != 0) return;
+        length = static_cast<size_t>(st.st_size);
+        if (length == 0) return;
+        base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        // Traces are read front to back once
+        if (base != MAP_FAILED) ::madvise(base, length, MADV_SEQUENTIAL);
+    }
+    ~MappedFile() {
+        if (base != MAP_FAILED) ::munmap(base, length);
+        if (fd >= 0) ::close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return fd >= 0 && (length == 0 || base != MAP_FAILED); }
+    const char* data() const { return base == MAP_FAILED ? nullptr : static_cast<const char*>(base); }
+    size_t size() const { return base == MAP_FAILED ? 0 : length; }
+};
+
+} // namespace
+
+std::string load_process_trace(const std::string& path, ProcessTable& table, TraceFormat* format) {
+    MappedFile file(path);
+    if (!file.ok()) return "cannot read " + path + ": " + std::strerror(errno);
+    return parse_process_trace(file.data(), file.size(), table, format);
+}
+
+// ===== WRITER =====
+
+namespace {
+
+// Buffers output and hands it to the sink a chunk at a time
+class ChunkWriter {
+private:
+    const std::function<bool(const char*, size_t)>& sink;
+    std::string buffer;
+    bool open = true;
+
+public:
+    explicit ChunkWriter(const std::function<bool(const char*, size_t)>& out) : sink(out) {
+        buffer.reserve(WRITE_CHUNK_BYTES + 4096);
+    }
+    void append(const void* data, size_t size) { buffer.append(static_cast<const char*>(data), size); }
+    void append(char c) { buffer.push_back(c); }
+    template <typename T>
+    void number(T value) {
+        char digits[24];
+        auto [ptr, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer.append(digits, ptr);
+    }
+    // False once the sink has refused a chunk
+    bool flush(bool force = false) {
+        if (open && !buffer.empty() && (force || buffer.size() >= WRITE_CHUNK_BYTES)) {
+            open = sink(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+        return open;
+    }
+};
+
+void append_csv_name(ChunkWriter& out, const std::string& name) {
+    bool quote = name.find_first_of(",\"") != std::string::npos;
+    if (quote) out.append('"');
+    for (char c : name) {
+        if (c == '"') out.append('"');
+        out.append(c == '\n' || c == '\r' ? ' ' : c);   // rows are one line each
+    }
+    if (quote) out.append('"');
+}
+
+} // namespace
+
+bool write_process_trace(const ProcessTable& table, TraceFormat format,
+                         const std::function<bool(const char*, size_t)>& sink) {
+    ChunkWriter out(sink);
+    if (format == TraceFormat::CSV) {
+        out.append(CSV_HEADER, sizeof(CSV_HEADER) - 1);
+        for (size_t i = 0; i < table.size(); i++) {
+            out.number(table.pid[i]);
+            out.append(',');
+            append_csv_name(out, table.name(i));
+            for (int value : {table.arrival[i], table.burst[i], table.priority[i]}) {
+                out.append(',');
+                out.number(value);
+            }
+            out.append(',');
+            out.number(table.affinity[i]);
+            for (int value : {table.start[i], table.completion[i], table.waiting[i], table.turnaround[i]}) {
+                out.append(',');
+                out.number(value);
+            }
+            out.append('\n');
+            if (!out.flush()) return false;
+        }
+        return out.flush(true);
+    }
+
+    TraceHeader header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.count = table.size();
+    header.name_count = table.names.size();
+    out.append(&header, sizeof(header));
+    for (size_t i = 0; i < table.size(); i++) {
+        TraceRecord r = {table.pid[i], table.arrival[i], table.burst[i], table.priority[i],
+                         table.affinity[i], table.name_id[i], 0};
+        out.append(&r, sizeof(r));
+        if (!out.flush()) return false;
+    }
+    for (uint32_t id = 0; id < table.names.size(); id++) {
+        const std::string& name = table.names.name(id);
+        uint32_t length = static_cast<uint32_t>(name.size());
+        out.append(&length, sizeof(length));
+        out.append(name.data(), name.size());
+        if (!out.flush()) return false;
+    }
+    return out.flush(true);
+}
+
+std::string save_process_trace(const std::string& path, const ProcessTable& table, TraceFormat format) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return "cannot write " + path + ": " + std::strerror(errno);
+    bool written = write_process_trace(table, format, [file](const char* data, size_t size) {
+        return std::fwrite(data, 1, size, file) == size;
+    });
+    if (std::fclose(file) != 0) written = false;
+    return written ? "" : "cannot write " + path;
+}
@@ -0,0 +1,67 @@
+#ifndef PROCESS_TRACE_H
+#define PROCESS_TRACE_H
+
+#include "process_table.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Bulk scheduler input and output.
+//
+// CSV traces hold one process per line:
+//   pid,name,arrival,burst,priority[,affinity]
+// with the affinity as a CPU bit mask (0 or absent = any CPU). A first line
+// starting with "pid" is a header; blank lines and lines starting with '#'
+// are skipped, and columns past the sixth are ignored, so an exported
+// results file replays as a trace. A name containing a comma or a quote is
+// double-quoted, with "" for a quote.
+//
+// Binary traces are an 8-byte magic, a header, `count` fixed-size records
+// and then the name table ({u32 length, bytes} per name, ids in order), in
+// host (little-endian) byte order.
+
+enum class TraceFormat { CSV, BINARY };
+
+// Rows accepted from one trace
+constexpr size_t MAX_TRACE_PROCESSES = 10000000;
+
+#pragma pack(push, 1)
+struct TraceRecord {
+    int32_t pid;
+    int32_t arrival;
+    int32_t burst;
+    int32_t priority;
+    uint64_t affinity;
+    uint32_t name_id;         // index into the trace's name table
+    uint32_t reserved;
+};
+#pragma pack(pop)
+static_assert(sizeof(TraceRecord) == 32, "record layout is part of the file format");
+
+const char* trace_format_name(TraceFormat format);
+// "csv" or "binary"; false on anything else
+bool parse_trace_format(const std::string& name, TraceFormat& format);
+
+// Replaces `table` with the processes of an in-memory trace, binary when
+// the data starts with the trace magic and CSV otherwise. Returns an error
+// message ("line N: ..." for CSV), or "" on success; on error the table is
+// left as it was.
+std::string parse_process_trace(const char* data, size_t size, ProcessTable& table,
+                                TraceFormat* format = nullptr);
+
+// parse_process_trace() over a memory-mapped file
+std::string load_process_trace(const std::string& path, ProcessTable& table,
+                               TraceFormat* format = nullptr);
+
+// Streams the table to `sink` in 1 MB pieces. CSV rows carry the schedule
+// results (start, completion, waiting, turnaround) after the trace columns;
+// binary traces hold the trace columns only. Returns false when the sink
+// returns false.
+bool write_process_trace(const ProcessTable& table, TraceFormat format,
+                         const std::function<bool(const char*, size_t)>& sink);
+
+// write_process_trace() to a file; returns an error message or ""
+std::string save_process_trace(const std::string& path, const ProcessTable& table, TraceFormat format);
+
+#endif
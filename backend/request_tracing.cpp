@@ -0,0 +1,183 @@
+#include "request_tracing.h"
+#include "cloud.h"
+#include "event_trace.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+RequestTracer request_tracer;
+
+RequestTrace& current_request_trace() {
+    thread_local RequestTrace trace;
+    return trace;
+}
+
+void trace_phase(TracePhase phase, FastClock::time_point since) {
+    RequestTrace& trace = current_request_trace();
+    if (!trace.active) return;
+    auto now = FastClock::now();
+    double elapsed = std::chrono::duration<double, std::micro>(now - since).count();
+    switch (phase) {
+        case TracePhase::QUEUE:
+            trace.queue_us += elapsed;
+            trace_event(TraceCategory::HTTP, "admission_queue", since, now, static_cast<int64_t>(trace.id));
+            break;
+        case TracePhase::LOCK_WAIT:
+            trace.lock_wait_us += elapsed;
+            trace_event(TraceCategory::LOCK, "handler_lock_wait", since, now, static_cast<int64_t>(trace.id));
+            break;
+        case TracePhase::SERIALIZE:
+            trace.serialize_us += elapsed;
+            trace_event(TraceCategory::HTTP, "serialize", since, now, static_cast<int64_t>(trace.id));
+            break;
+    }
+}
+
+// Linear interpolation inside the bucket holding the q-th observation
+static double estimate_quantile(const Histogram& h, double q, double max_value) {
+    std::vector<uint64_t> counts = h.bucket_counts();
+    uint64_t total = 0;
+    for (uint64_t c : counts) total += c;
+    if (total == 0) return 0.0;
+
+    const std::vector<double>& bounds = h.upper_bounds();
+    double target = q * total;
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] == 0) continue;
+        if (cumulative + counts[i] >= target) {
+            double lower = i == 0 ? 0.0 : bounds[i - 1];
+            double upper = i < bounds.size() ? bounds[i] : max_value;
+            double fraction = (target - cumulative) / counts[i];
+            return std::min(max_value, lower + (upper - lower) * fraction);
+        }
+        cumulative += counts[i];
+    }
+    return max_value;
+}
+
+// ===== REQUEST TRACER =====
+
+RequestTracer::RequestTracer(double threshold_ms, size_t slow_capacity, const std::string& log_path)
+    : slow_log_capacity(slow_capacity), slow_threshold_ms(threshold_ms), next_request_id(1),
+      slow_log_path(log_path) {}
+
+uint64_t RequestTracer::begin() {
+    RequestTrace& trace = current_request_trace();
+    trace = RequestTrace();
+    trace.active = true;
+    trace.started = FastClock::now();
+    std::lock_guard<std::mutex> lock(mtx);
+    trace.id = next_request_id++;
+    return trace.id;
+}
+
+void RequestTracer::end(const std::string& method, const std::string& path,
+                        const std::string& route, int status) {
+    RequestTrace& trace = current_request_trace();
+    if (!trace.active) return;
+    trace.active = false;
+
+    auto now = FastClock::now();
+    double total_us = std::chrono::duration<double, std::micro>(now - trace.started).count();
+    double compute_us = std::max(0.0, total_us - trace.queue_us - trace.lock_wait_us - trace.serialize_us);
+    double total_ms = total_us / 1000.0;
+
+    std::string key = method + " " + route;
+    trace_event(TraceCategory::HTTP, trace_intern(key), trace.started, now, static_cast<int64_t>(trace.id));
+
+    std::unique_lock<std::mutex> lock(mtx);
+    RouteEntry& entry = routes[key];
+    if (!entry.latency) {
+        entry.latency = std::make_unique<Histogram>(latency_buckets());
+        entry.stats.method = method;
+        entry.stats.route = route;
+    }
+    RouteTraceStats& stats = entry.stats;
+    stats.count++;
+    if (status >= 500) stats.errors++;
+    stats.total_ms += total_ms;
+    stats.max_ms = std::max(stats.max_ms, total_ms);
+    stats.queue_ms += trace.queue_us / 1000.0;
+    stats.lock_wait_ms += trace.lock_wait_us / 1000.0;
+    stats.compute_ms += compute_us / 1000.0;
+    stats.serialize_ms += trace.serialize_us / 1000.0;
+    entry.latency->observe(total_us / 1e6);
+
+    if (total_ms < slow_threshold_ms) return;
+
+    stats.slow++;
+    SlowRequest slow;
+    slow.id = trace.id;
+    slow.timestamp = getCurrentTimestamp();
+    slow.method = method;
+    slow.path = path;
+    slow.route = route;
+    slow.status = status;
+    slow.total_ms = total_ms;
+    slow.queue_ms = trace.queue_us / 1000.0;
+    slow.lock_wait_ms = trace.lock_wait_us / 1000.0;
+    slow.compute_ms = compute_us / 1000.0;
+    slow.serialize_ms = trace.serialize_us / 1000.0;
+
+    slow_log.push_back(slow);
+    if (slow_log.size() > slow_log_capacity) {
+        slow_log.pop_front();
+    }
+    lock.unlock();
+
+    // File I/O happens on the local copy so other requests are not held up
+    // behind a slow disk while they record their own traces
+    std::ofstream log(slow_log_path, std::ios::app);
+    if (log) {
+        log << std::fixed << std::setprecision(3)
+            << "[" << slow.timestamp << "] request_id=" << slow.id
+            << " " << method << " " << path << " status=" << status
+            << " total_ms=" << slow.total_ms << " queue_ms=" << slow.queue_ms
+            << " lock_wait_ms=" << slow.lock_wait_ms << " compute_ms=" << slow.compute_ms
+            << " serialize_ms=" << slow.serialize_ms << "\n";
+    }
+}
+
+void RequestTracer::set_slow_threshold_ms(double threshold_ms) {
+    std::lock_guard<std::mutex> lock(mtx);
+    slow_threshold_ms = threshold_ms;
+}
+
+double RequestTracer::slow_threshold() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return slow_threshold_ms;
+}
+
+std::vector<RouteTraceStats> RequestTracer::route_stats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<RouteTraceStats> result;
+    result.reserve(routes.size());
+    for (const auto& [key, entry] : routes) {
+        RouteTraceStats stats = entry.stats;
+        stats.p50_ms = estimate_quantile(*entry.latency, 0.50, stats.max_ms / 1000.0) * 1000.0;
+        stats.p95_ms = estimate_quantile(*entry.latency, 0.95, stats.max_ms / 1000.0) * 1000.0;
+        stats.p99_ms = estimate_quantile(*entry.latency, 0.99, stats.max_ms / 1000.0) * 1000.0;
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const RouteTraceStats& a, const RouteTraceStats& b) {
+        return a.total_ms > b.total_ms;
+    });
+    return result;
+}
+
+std::vector<SlowRequest> RequestTracer::slow_requests(size_t limit) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<SlowRequest> result;
+    for (auto it = slow_log.rbegin(); it != slow_log.rend() && result.size() < limit; ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+void RequestTracer::reset() {
+    std::lock_guard<std::mutex> lock(mtx);
+    routes.clear();
+    slow_log.clear();
+}
@@ -0,0 +1,117 @@
+#ifndef REQUEST_TRACING_H
+#define REQUEST_TRACING_H
+
+#include "metrics.h"
+#include "fast_clock.h"
+#include "lock_profiler.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Time a request spends outside its handler's own computation. Whatever is
+// not attributed to a phase is reported as compute.
+enum class TracePhase {
+    QUEUE,        // waiting for an admission slot
+    LOCK_WAIT,    // acquiring api/process/stats locks
+    SERIALIZE     // building the JSON response body
+};
+
+// Per-thread record of the request currently being handled
+struct RequestTrace {
+    bool active = false;
+    uint64_t id = 0;
+    FastClock::time_point started;
+    double queue_us = 0.0;
+    double lock_wait_us = 0.0;
+    double serialize_us = 0.0;
+};
+
+struct SlowRequest {
+    uint64_t id = 0;
+    std::string timestamp;
+    std::string method;
+    std::string path;
+    std::string route;
+    int status = 0;
+    double total_ms = 0.0;
+    double queue_ms = 0.0;
+    double lock_wait_ms = 0.0;
+    double compute_ms = 0.0;
+    double serialize_ms = 0.0;
+};
+
+struct RouteTraceStats {
+    std::string method;
+    std::string route;
+    uint64_t count = 0;
+    uint64_t errors = 0;            // 5xx responses
+    uint64_t slow = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double queue_ms = 0.0;          // phase totals, divide by count for averages
+    double lock_wait_ms = 0.0;
+    double compute_ms = 0.0;
+    double serialize_ms = 0.0;
+};
+
+RequestTrace& current_request_trace();
+
+// Adds the time since `since` to a phase of the current request (no-op
+// outside a traced request, e.g. on job workers)
+void trace_phase(TracePhase phase, FastClock::time_point since);
+
+// Locks a profiled mutex, attributing acquisition time to LOCK_WAIT and
+// the caller's location to the lock profiler's waiters
+inline std::unique_lock<ProfiledMutex> traced_lock(ProfiledMutex& m, const char* file = __builtin_FILE(),
+                                                   int line = __builtin_LINE()) {
+    auto started = FastClock::now();
+    m.lock(file, line);
+    trace_phase(TracePhase::LOCK_WAIT, started);
+    return std::unique_lock<ProfiledMutex>(m, std::adopt_lock);
+}
+
+class RequestTracer {
+private:
+    struct RouteEntry {
+        RouteTraceStats stats;
+        std::unique_ptr<Histogram> latency;   // seconds
+    };
+
+    std::map<std::string, RouteEntry> routes;     // "METHOD route"
+    std::deque<SlowRequest> slow_log;
+    size_t slow_log_capacity;
+    double slow_threshold_ms;
+    uint64_t next_request_id;
+    std::string slow_log_path;
+    mutable std::mutex mtx;
+
+public:
+    RequestTracer(double threshold_ms = 500.0, size_t slow_capacity = 200,
+                  const std::string& log_path = "./logs/slow_requests.log");
+
+    // Starts tracing on the calling thread and returns the request id
+    uint64_t begin();
+    // Records the finished request; route is the matched pattern
+    void end(const std::string& method, const std::string& path,
+             const std::string& route, int status);
+
+    void set_slow_threshold_ms(double threshold_ms);
+    double slow_threshold() const;
+
+    // Routes ordered by total time spent, hottest first
+    std::vector<RouteTraceStats> route_stats() const;
+    std::vector<SlowRequest> slow_requests(size_t limit) const;
+    void reset();
+};
+
+extern RequestTracer request_tracer;
+
+#endif
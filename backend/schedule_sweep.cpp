@@ -0,0 +1,138 @@
+#include "schedule_sweep.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+std::string validate_sweep_config(const SweepConfig& config) {
+    static const std::vector<std::string> algorithms = {
+        "FCFS", "SJF", "PRIORITY", "RR", "SRTF", "PRIORITY_P", "MLFQ", "CFS", "EDF", "RM"
+    };
+    if (std::find(algorithms.begin(), algorithms.end(), config.algorithm) == algorithms.end()) {
+        return "unknown algorithm: " + config.algorithm;
+    }
+    if (config.algorithm == "RR" && config.quantum <= 0) {
+        return "RR quantum must be positive";
+    }
+    if (config.cores < 1 || config.cores > MAX_SCHEDULER_CORES) {
+        return "cores must be between 1 and " + std::to_string(MAX_SCHEDULER_CORES);
+    }
+    if (config.cores > 1 && !ProcessScheduler::supportsMultiCore(config.algorithm)) {
+        return config.algorithm + " runs on a single core";
+    }
+    return "";
+}
+
+std::vector<SweepConfig> default_sweep_configs() {
+    std::vector<SweepConfig> configs;
+    for (const char* algorithm : {"FCFS", "SJF", "PRIORITY", "SRTF", "PRIORITY_P", "MLFQ", "CFS"}) {
+        SweepConfig config;
+        config.algorithm = algorithm;
+        configs.push_back(config);
+    }
+    for (int quantum : {1, 2, 4, 8}) {
+        SweepConfig config;
+        config.algorithm = "RR";
+        config.quantum = quantum;
+        configs.push_back(config);
+    }
+    return configs;
+}
+
+static SweepResult run_sweep_config(const std::vector<Process>& processes, const SweepConfig& config,
+                                    const MlfqConfig& mlfq, const CfsConfig& cfs,
+                                    const RealtimeConfig& realtime) {
+    SweepResult result;
+    result.config = config;
+    result.error = validate_sweep_config(config);
+    if (!result.error.empty()) return result;
+    result.io = std::any_of(processes.begin(), processes.end(),
+                            [](const Process& p) { return !p.io_bursts.empty(); });
+    if (result.io && (config.cores > 1 || !ProcessScheduler::supportsIo(config.algorithm))) {
+        result.error = config.cores > 1 ? "I/O bursts run on a single core"
+                                        : config.algorithm + " does not model I/O bursts";
+        return result;
+    }
+    
+    auto started = std::chrono::steady_clock::now();
+    ProcessScheduler scheduler;
+    scheduler.setVerbose(false);
+    scheduler.setMlfqConfig(mlfq);
+    scheduler.setCfsConfig(cfs);
+    scheduler.setRealtimeConfig(realtime);
+    scheduler.setCores(config.cores);
+    scheduler.setProcesses(processes);
+    scheduler.executeScheduler(config.algorithm, config.quantum);
+    
+    // Read the result columns directly; getProcesses() would rebuild every
+    // Process (name and I/O list included) just to sum three fields
+    const ProcessTable& done = scheduler.getProcessTable();
+    const size_t n = done.size();
+    long long waiting = 0, turnaround = 0;
+    for (size_t i = 0; i < n; i++) {
+        waiting += done.waiting[i];
+        turnaround += done.turnaround[i];
+        result.makespan = std::max(result.makespan, done.completion[i]);
+    }
+    if (n > 0) {
+        result.average_waiting_time = static_cast<double>(waiting) / n;
+        result.average_turnaround_time = static_cast<double>(turnaround) / n;
+    }
+    if (result.makespan > 0) {
+        result.throughput = static_cast<double>(n) / result.makespan;
+    }
+    result.dispatches = scheduler.getDispatchCount();
+    result.deadline_misses = scheduler.getRealtimeStats().missed;
+    result.cpu_utilization = scheduler.getIoStats().cpu_utilization;
+    result.io_overlap = scheduler.getIoStats().overlap;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+std::vector<SweepResult> run_schedule_sweep(const std::vector<Process>& processes,
+                                            const std::vector<SweepConfig>& configs,
+                                            const MlfqConfig& mlfq, const CfsConfig& cfs,
+                                            const RealtimeConfig& realtime, WorkerPool& pool) {
+    std::vector<SweepResult> results(configs.size());
+    std::atomic<size_t> next_config{0};
+    
+    // Claims configs until none are left; shared by the caller and the helpers
+    auto work = [&]() {
+        for (size_t i = next_config++; i < configs.size(); i = next_config++) {
+            try {
+                results[i] = run_sweep_config(processes, configs[i], mlfq, cfs, realtime);
+            } catch (const std::exception& e) {
+                results[i].config = configs[i];
+                results[i].error = e.what();
+            }
+        }
+    };
+    
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t running_helpers = 0;
+    size_t helpers = configs.empty() ? 0 : std::min(pool.thread_count(), configs.size() - 1);
+    for (size_t h = 0; h < helpers; h++) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            running_helpers++;
+        }
+        bool accepted = pool.submit([&]() {
+            work();
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--running_helpers == 0) cv.notify_all();
+        });
+        if (!accepted) {
+            std::lock_guard<std::mutex> lock(mtx);
+            running_helpers--;
+            break;
+        }
+    }
+    
+    work();
+    // Helpers reference this frame, so wait for every accepted one to finish
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&]() { return running_helpers == 0; });
+    return results;
+}
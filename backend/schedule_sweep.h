@@ -0,0 +1,48 @@
+#ifndef SCHEDULE_SWEEP_H
+#define SCHEDULE_SWEEP_H
+
+#include "process_scheduler.h"
+#include "worker_pool.h"
+#include <string>
+#include <vector>
+
+// What-if comparison of scheduling policies over one process set. Every
+// config runs on its own ProcessScheduler holding a private copy of the
+// processes, so runs share nothing and go in parallel on a worker pool.
+
+struct SweepConfig {
+    std::string algorithm;   // any executeScheduler() algorithm
+    int quantum = 2;         // RR only
+    int cores = 1;
+};
+
+struct SweepResult {
+    SweepConfig config;
+    std::string error;                  // empty when the run succeeded
+    double average_waiting_time = 0.0;
+    double average_turnaround_time = 0.0;
+    double throughput = 0.0;            // processes completed per time unit
+    int makespan = 0;                   // completion time of the last process
+    size_t dispatches = 0;
+    size_t deadline_misses = 0;         // EDF and RM
+    bool io = false;                    // the processes do I/O
+    double cpu_utilization = 0.0;       // with I/O: CPU busy time over the makespan
+    double io_overlap = 0.0;            // with I/O: share of device time overlapping the CPU
+    double elapsed_ms = 0.0;            // wall time of this run
+};
+
+// Returns an error message, or "" for a config that can run
+std::string validate_sweep_config(const SweepConfig& config);
+
+// Every algorithm but EDF and RM once, RR at quanta 1, 2, 4 and 8
+std::vector<SweepConfig> default_sweep_configs();
+
+// Runs every config and returns the results in config order. The calling
+// thread works through the configs alongside up to pool.thread_count()
+// helpers, so the sweep completes even when the pool is saturated.
+std::vector<SweepResult> run_schedule_sweep(const std::vector<Process>& processes,
+                                            const std::vector<SweepConfig>& configs,
+                                            const MlfqConfig& mlfq, const CfsConfig& cfs,
+                                            const RealtimeConfig& realtime, WorkerPool& pool);
+
+#endif
@@ -0,0 +1,481 @@
+// Load generator for the HTTP API with per-route latency SLOs.
+//
+//   loadgen [--local | --host=HOST --port=PORT]
+//           [--mix=files:4,stats:4,upload:1,schedule:1,deadlock:1]
+//           [--concurrency=N] [--rate=R] [--requests=N] [--duration=S]
+//           [--warmup=N] [--seed=N] [--slo=ROUTE:METRIC<LIMIT,...] [--json] [--out=FILE]
+//
+// --local (the default) registers the server's routes in-process and feeds
+// raw HTTP requests through DispatchServer::dispatch_buffer: the full request
+// path (parsing, hooks, admission, handlers, serialization) with no sockets.
+// It runs against ./test_files, ./downloads and ./logs like the server does.
+//
+// Without --rate, N workers issue requests back to back (closed loop). With
+// --rate, requests are scheduled at R per second across the workers and
+// latency is measured from the scheduled start, so time spent waiting for a
+// free worker counts against the server (no coordinated omission).
+//
+// SLOs: ROUTE is a mix name or * for all requests; METRIC is p50, p99, p999
+// or max (milliseconds), errors (fraction of non-2xx responses) or rps; the
+// operator is < or >. Example: --slo='*:p99<50,stats:p999<20,*:errors<0.001'
+// --json prints the report as JSON; --out=FILE also writes it there, clean of
+// any output the in-process server produced at startup. A
+// -DCLOUD_ALLOC_PROFILING=ON build adds heap allocations per route to the
+// --local text report.
+// Exit status: 0 when every SLO holds, 1 when one is violated, 2 on bad usage.
+
+#include "../alloc_profiler.h"
+#include "../api_routes.h"
+#include "../cloud.h"
+#include <httplib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct RouteSpec {
+    const char* name;
+    const char* method;
+    const char* path;
+    const char* body;
+};
+
+static const RouteSpec ROUTES[] = {
+    {"upload", "POST", "/api/files/upload", nullptr},   // body filled in below
+    {"files", "GET", "/api/files", ""},
+    {"stats", "GET", "/api/stats", ""},
+    {"schedule", "POST", "/api/os/processes/schedule", "{\"algorithm\":\"RR\",\"quantum\":2,\"processCount\":10}"},
+    {"deadlock", "GET", "/api/os/deadlock/visualize", ""},
+};
+constexpr size_t ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
+
+struct LoadConfig {
+    bool local = true;
+    std::string host = "localhost";
+    int port = 3001;
+    double weights[ROUTE_COUNT] = {1, 4, 4, 1, 1};
+    int concurrency = 4;
+    double rate = 0.0;              // requests/s; 0 = closed loop
+    long requests = 2000;           // measured requests, unless duration is set
+    double duration_s = 0.0;
+    long warmup = 100;
+    uint64_t seed = 1;
+    bool json = false;
+    std::string out_path;           // JSON report file
+};
+
+struct Sample {
+    uint8_t route;
+    int status;                     // 0 = transport failure
+    double latency_ms;
+};
+
+struct Slo {
+    std::string text;
+    int route = -1;                 // -1 = all requests
+    std::string metric;
+    bool less = true;
+    double limit = 0.0;
+};
+
+struct RouteReport {
+    std::string name;
+    size_t count = 0;
+    size_t errors = 0;
+    double rps = 0.0;
+    double p50 = 0.0, p99 = 0.0, p999 = 0.0, max = 0.0;
+};
+
+static void usage() {
+    std::cerr << "usage: loadgen [--local | --host=HOST --port=PORT] [--mix=ROUTE:W,...]\n"
+                 "               [--concurrency=N] [--rate=R] [--requests=N] [--duration=S]\n"
+                 "               [--warmup=N] [--seed=N] [--slo=ROUTE:METRIC<LIMIT,...] [--json] [--out=FILE]\n"
+                 "routes: upload files stats schedule deadlock\n";
+}
+
+static bool flag_value(const char* arg, const char* name, std::string& value) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') return false;
+    value = arg + len + 1;
+    return true;
+}
+
+static std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, separator)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+static int route_index(const std::string& name) {
+    for (size_t i = 0; i < ROUTE_COUNT; i++) {
+        if (name == ROUTES[i].name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+static bool parse_mix(const std::string& text, double* weights) {
+    std::fill(weights, weights + ROUTE_COUNT, 0.0);
+    for (const auto& entry : split(text, ',')) {
+        size_t colon = entry.find(':');
+        int route = route_index(entry.substr(0, colon));
+        if (route < 0) return false;
+        weights[route] = colon == std::string::npos ? 1.0 : std::atof(entry.c_str() + colon + 1);
+        if (weights[route] < 0) return false;
+    }
+    return std::any_of(weights, weights + ROUTE_COUNT, [](double w) { return w > 0; });
+}
+
+static bool parse_slos(const std::string& text, std::vector<Slo>& slos) {
+    for (const auto& entry : split(text, ',')) {
+        Slo slo;
+        slo.text = entry;
+        size_t colon = entry.find(':');
+        size_t op = entry.find_first_of("<>");
+        if (colon == std::string::npos || op == std::string::npos || op < colon) return false;
+        std::string route = entry.substr(0, colon);
+        if (route != "*") {
+            slo.route = route_index(route);
+            if (slo.route < 0) return false;
+        }
+        slo.metric = entry.substr(colon + 1, op - colon - 1);
+        if (slo.metric != "p50" && slo.metric != "p99" && slo.metric != "p999" && slo.metric != "max" &&
+            slo.metric != "errors" && slo.metric != "rps") {
+            return false;
+        }
+        slo.less = entry[op] == '<';
+        slo.limit = std::atof(entry.c_str() + op + 1);
+        slos.push_back(slo);
+    }
+    return true;
+}
+
+// ===== TRANSPORTS =====
+
+// One request/response exchange; returns the HTTP status or 0 on failure
+class Transport {
+public:
+    virtual ~Transport() = default;
+    virtual int send(const RouteSpec& route, const std::string& body) = 0;
+};
+
+class LocalTransport : public Transport {
+private:
+    DispatchServer& server;
+    std::string request;
+    std::string response;
+
+public:
+    explicit LocalTransport(DispatchServer& s) : server(s) {}
+
+    int send(const RouteSpec& route, const std::string& body) override {
+        request.clear();
+        request.append(route.method).append(" ").append(route.path).append(" HTTP/1.1\r\n");
+        request.append("Host: loadgen\r\n");
+        if (!body.empty()) {
+            request.append("Content-Type: application/json\r\nContent-Length: ")
+                   .append(std::to_string(body.size())).append("\r\n");
+        }
+        request.append("\r\n").append(body);
+        response.clear();
+        server.dispatch_buffer(request, response, "127.0.0.1", 0, -1);
+        if (response.compare(0, 5, "HTTP/") != 0 || response.size() < 12) return 0;
+        return std::atoi(response.c_str() + 9);
+    }
+};
+
+class RemoteTransport : public Transport {
+private:
+    httplib::Client client;
+
+public:
+    RemoteTransport(const std::string& host, int port) : client(host, port) {
+        client.set_keep_alive(true);
+        client.set_tcp_nodelay(true);
+    }
+
+    int send(const RouteSpec& route, const std::string& body) override {
+        httplib::Result res = std::strcmp(route.method, "GET") == 0
+            ? client.Get(route.path)
+            : client.Post(route.path, body, "application/json");
+        return res ? res->status : 0;
+    }
+};
+
+// Swallows std::cout while the in-process server runs; handlers log to it
+class QuietCout {
+private:
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+    NullBuffer null_buffer;
+    std::streambuf* saved = nullptr;
+
+public:
+    explicit QuietCout(bool active) {
+        if (active) saved = std::cout.rdbuf(&null_buffer);
+    }
+    ~QuietCout() { restore(); }
+    void restore() {
+        if (saved) std::cout.rdbuf(saved);
+        saved = nullptr;
+    }
+};
+
+// ===== RUN =====
+
+using Clock = std::chrono::steady_clock;
+
+// Route of request i; the sequence depends only on the seed and the mix
+static std::vector<uint8_t> plan_routes(const LoadConfig& config, size_t length) {
+    std::mt19937_64 rng(config.seed);
+    std::discrete_distribution<int> pick(config.weights, config.weights + ROUTE_COUNT);
+    std::vector<uint8_t> plan(length);
+    for (auto& route : plan) route = static_cast<uint8_t>(pick(rng));
+    return plan;
+}
+
+// Runs `count` requests (or until `deadline` when count < 0) starting at
+// request index `first`; returns the samples and the wall time in seconds
+static double run_phase(const LoadConfig& config, const std::vector<uint8_t>& plan,
+                        std::vector<std::unique_ptr<Transport>>& transports,
+                        const std::string& upload_body, long first, long count,
+                        std::vector<Sample>& samples) {
+    std::atomic<long> next{0};
+    std::vector<std::vector<Sample>> per_worker(transports.size());
+    Clock::time_point started = Clock::now();
+    Clock::time_point deadline = started + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config.duration_s));
+
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < transports.size(); w++) {
+        workers.emplace_back([&, w]() {
+            auto& out = per_worker[w];
+            while (true) {
+                long i = next++;
+                if (count >= 0 && i >= count) break;
+                Clock::time_point scheduled = Clock::now();
+                if (config.rate > 0) {
+                    scheduled = started + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(i / config.rate));
+                }
+                if (count < 0 && scheduled >= deadline) break;
+                if (config.rate > 0) std::this_thread::sleep_until(scheduled);
+
+                uint8_t route = plan[static_cast<size_t>(first + i) % plan.size()];
+                const RouteSpec& spec = ROUTES[route];
+                int status = transports[w]->send(spec, spec.body ? spec.body : upload_body);
+                double latency = std::chrono::duration<double, std::milli>(Clock::now() - scheduled).count();
+                out.push_back({route, status, latency});
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+
+    for (auto& worker_samples : per_worker) {
+        samples.insert(samples.end(), worker_samples.begin(), worker_samples.end());
+    }
+    return elapsed;
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[index == 0 ? 0 : index - 1];
+}
+
+// route = -1 summarizes every sample
+static RouteReport summarize(const std::vector<Sample>& samples, int route, double elapsed_s) {
+    RouteReport report;
+    report.name = route < 0 ? "*" : ROUTES[route].name;
+    std::vector<double> latencies;
+    for (const auto& s : samples) {
+        if (route >= 0 && s.route != route) continue;
+        latencies.push_back(s.latency_ms);
+        if (s.status < 200 || s.status >= 300) report.errors++;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    report.count = latencies.size();
+    report.rps = elapsed_s > 0 ? report.count / elapsed_s : 0.0;
+    report.p50 = percentile(latencies, 0.50);
+    report.p99 = percentile(latencies, 0.99);
+    report.p999 = percentile(latencies, 0.999);
+    report.max = latencies.empty() ? 0.0 : latencies.back();
+    return report;
+}
+
+static double slo_value(const Slo& slo, const RouteReport& r) {
+    if (slo.metric == "p50") return r.p50;
+    if (slo.metric == "p99") return r.p99;
+    if (slo.metric == "p999") return r.p999;
+    if (slo.metric == "max") return r.max;
+    if (slo.metric == "rps") return r.rps;
+    return r.count ? static_cast<double>(r.errors) / r.count : 0.0;   // errors
+}
+
+int main(int argc, char** argv) {
+    LoadConfig config;
+    std::vector<Slo> slos;
+
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (std::strcmp(argv[i], "--local") == 0) {
+            config.local = true;
+        } else if (flag_value(argv[i], "--host", value)) {
+            config.host = value;
+            config.local = false;
+        } else if (flag_value(argv[i], "--port", value)) {
+            config.port = std::atoi(value.c_str());
+            config.local = false;
+        } else if (flag_value(argv[i], "--mix", value)) {
+            if (!parse_mix(value, config.weights)) {
+                std::cerr << "loadgen: bad mix '" << value << "'\n";
+                return 2;
+            }
+        } else if (flag_value(argv[i], "--concurrency", value)) {
+            config.concurrency = std::max(1, std::atoi(value.c_str()));
+        } else if (flag_value(argv[i], "--rate", value)) {
+            config.rate = std::atof(value.c_str());
+        } else if (flag_value(argv[i], "--requests", value)) {
+            config.requests = std::atol(value.c_str());
+        } else if (flag_value(argv[i], "--duration", value)) {
+            config.duration_s = std::atof(value.c_str());
+        } else if (flag_value(argv[i], "--warmup", value)) {
+            config.warmup = std::max(0L, std::atol(value.c_str()));
+        } else if (flag_value(argv[i], "--seed", value)) {
+            config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (flag_value(argv[i], "--slo", value)) {
+            if (!parse_slos(value, slos)) {
+                std::cerr << "loadgen: bad SLO '" << value << "'\n";
+                return 2;
+            }
+        } else if (flag_value(argv[i], "--out", value)) {
+            config.out_path = value;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            config.json = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::string upload_body(1024, 'x');
+    std::vector<uint8_t> plan = plan_routes(config, 1 << 16);
+
+    // The in-process server lives for the whole run; remote mode never builds it
+    std::unique_ptr<DispatchServer> server;
+    QuietCout quiet(config.local);
+    if (config.local) {
+        ensure_directories_exist();
+        server = std::make_unique<DispatchServer>();
+        setup_api_routes(*server, 1e9);
+    }
+    std::vector<std::unique_ptr<Transport>> transports;
+    for (int w = 0; w < config.concurrency; w++) {
+        if (config.local) transports.push_back(std::make_unique<LocalTransport>(*server));
+        else transports.push_back(std::make_unique<RemoteTransport>(config.host, config.port));
+    }
+
+    std::vector<Sample> samples;
+    if (config.warmup > 0) {
+        LoadConfig warm = config;
+        warm.rate = 0.0;
+        run_phase(warm, plan, transports, upload_body, 0, config.warmup, samples);
+        samples.clear();
+        reset_alloc_profiles();
+    }
+    long count = config.duration_s > 0 ? -1 : config.requests;
+    double elapsed = run_phase(config, plan, transports, upload_body, config.warmup, count, samples);
+    quiet.restore();
+
+    std::vector<RouteReport> reports;
+    for (size_t r = 0; r < ROUTE_COUNT; r++) {
+        if (config.weights[r] > 0) reports.push_back(summarize(samples, static_cast<int>(r), elapsed));
+    }
+    RouteReport total = summarize(samples, -1, elapsed);
+
+    bool all_met = true;
+    std::vector<std::pair<const Slo*, double>> results;
+    for (const auto& slo : slos) {
+        double value = slo_value(slo, slo.route < 0 ? total : summarize(samples, slo.route, elapsed));
+        results.emplace_back(&slo, value);
+        if (slo.less ? !(value < slo.limit) : !(value > slo.limit)) all_met = false;
+    }
+
+    if (config.json || !config.out_path.empty()) {
+        auto route_json = [](const RouteReport& r) {
+            std::ostringstream out;
+            out << "{\"route\":\"" << r.name << "\",\"count\":" << r.count << ",\"errors\":" << r.errors
+                << ",\"rps\":" << r.rps << ",\"p50Ms\":" << r.p50 << ",\"p99Ms\":" << r.p99
+                << ",\"p999Ms\":" << r.p999 << ",\"maxMs\":" << r.max << "}";
+            return out.str();
+        };
+        std::ostringstream json;
+        json << "{\"mode\":\"" << (config.local ? "local" : "remote") << "\",\"concurrency\":" << config.concurrency
+             << ",\"rate\":" << config.rate << ",\"seed\":" << config.seed << ",\"durationS\":" << elapsed
+             << ",\"total\":" << route_json(total) << ",\"routes\":[";
+        for (size_t i = 0; i < reports.size(); i++) {
+            json << (i ? "," : "") << route_json(reports[i]);
+        }
+        json << "],\"slos\":[";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Slo& slo = *results[i].first;
+            bool met = slo.less ? results[i].second < slo.limit : results[i].second > slo.limit;
+            json << (i ? "," : "") << "{\"slo\":\"" << slo.text << "\",\"value\":" << results[i].second
+                 << ",\"met\":" << (met ? "true" : "false") << "}";
+        }
+        json << "],\"passed\":" << (all_met ? "true" : "false") << "}\n";
+
+        if (!config.out_path.empty()) {
+            std::ofstream out(config.out_path);
+            if (!out) {
+                std::cerr << "loadgen: cannot write " << config.out_path << "\n";
+                return 2;
+            }
+            out << json.str();
+        }
+        if (config.json) {
+            std::cout << json.str();
+            return all_met ? 0 : 1;
+        }
+    }
+
+    std::cout << (config.local ? "in-process" : config.host + ":" + std::to_string(config.port))
+              << ", " << config.concurrency << " workers, "
+              << (config.rate > 0 ? std::to_string(config.rate) + " req/s open loop" : std::string("closed loop"))
+              << ", " << std::fixed << std::setprecision(2) << elapsed << " s\n\n";
+    std::cout << std::left << std::setw(10) << "route" << std::right << std::setw(9) << "count"
+              << std::setw(8) << "errors" << std::setw(10) << "req/s" << std::setw(10) << "p50 ms"
+              << std::setw(10) << "p99 ms" << std::setw(10) << "p999 ms" << std::setw(10) << "max ms" << "\n";
+    reports.push_back(total);
+    for (const auto& r : reports) {
+        std::cout << std::left << std::setw(10) << r.name << std::right << std::setw(9) << r.count
+                  << std::setw(8) << r.errors << std::setw(10) << std::setprecision(1) << r.rps
+                  << std::setprecision(3) << std::setw(10) << r.p50 << std::setw(10) << r.p99
+                  << std::setw(10) << r.p999 << std::setw(10) << r.max << "\n";
+    }
+    if (!results.empty()) std::cout << "\n";
+    for (const auto& [slo, value] : results) {
+        bool met = slo->less ? value < slo->limit : value > slo->limit;
+        std::cout << (met ? "PASS  " : "FAIL  ") << slo->text << "  (" << std::setprecision(4) << value << ")\n";
+    }
+    if (config.local && alloc_profiling_compiled()) print_alloc_report(std::cout);
+    return all_met ? 0 : 1;
+}
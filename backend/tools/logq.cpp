@@ -0,0 +1,196 @@
+// Query tool for the structured binary event log (./logs/binlog).
+//
+//   logq [--dir=./logs/binlog] [--from=<epoch ms>] [--to=<epoch ms>]
+//        [--op=READ,WRITE] [--status=ERROR] [--thread=<id>] [--grep=<text>]
+//        [--limit=<n>] [--aggregate] [--json] [--segments]
+
+#include "../binary_log.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+static void usage() {
+    std::cerr << "usage: logq [--dir=DIR] [--from=MS] [--to=MS] [--op=A,B] [--status=A,B]\n"
+                 "            [--thread=ID] [--grep=TEXT] [--limit=N] [--aggregate] [--json] [--segments]\n";
+}
+
+static bool flag_value(const char* arg, const char* name, std::string& value) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') return false;
+    value = arg + len + 1;
+    return true;
+}
+
+static std::string format_time(int64_t timestamp_us) {
+    std::time_t seconds = static_cast<std::time_t>(timestamp_us / 1000000);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+    char buffer[40];
+    size_t n = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(buffer + n, sizeof(buffer) - n, ".%06lld",
+                  static_cast<long long>(timestamp_us % 1000000));
+    return buffer;
+}
+
+static std::string json_escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+static void print_record(const DecodedLogRecord& decoded, bool json) {
+    const BinaryLogRecord& r = decoded.record;
+    const char* op = log_op_name(static_cast<LogOp>(r.op));
+    const char* status = log_status_name(static_cast<LogStatus>(r.status));
+    const std::string& message = decoded.message ? *decoded.message : std::string();
+    if (json) {
+        std::cout << "{\"timestampUs\":" << r.timestamp_us << ",\"threadId\":" << r.thread_id
+                  << ",\"op\":\"" << op << "\",\"status\":\"" << status << "\"";
+        if (r.total_us > 0) {
+            std::cout << ",\"waitUs\":" << r.wait_us << ",\"operationUs\":" << r.operation_us
+                      << ",\"totalUs\":" << r.total_us;
+        }
+        std::cout << ",\"message\":\"" << json_escape(message) << "\"}\n";
+        return;
+    }
+    std::cout << "[" << format_time(r.timestamp_us) << "] #" << r.thread_id << " " << op << " " << status;
+    if (r.total_us > 0) {
+        std::cout << " wait=" << r.wait_us << "us op=" << r.operation_us << "us total=" << r.total_us << "us";
+    }
+    if (!message.empty()) std::cout << " " << message;
+    std::cout << "\n";
+}
+
+static void print_aggregate(const BinaryLogAggregate& aggregate, bool json) {
+    if (json) {
+        std::cout << "{\"scanned\":" << aggregate.scanned << ",\"matched\":" << aggregate.matched << ",\"ops\":{";
+        bool first_op = true;
+        for (const auto& [name, summary] : aggregate.by_op) {
+            std::cout << (first_op ? "" : ",") << "\"" << name << "\":{\"count\":" << summary.count;
+            if (summary.timed > 0) {
+                std::cout << ",\"timed\":" << summary.timed
+                          << ",\"avgTotalUs\":" << summary.total_us_sum / summary.timed
+                          << ",\"avgWaitUs\":" << summary.wait_us_sum / summary.timed
+                          << ",\"maxTotalUs\":" << summary.total_us_max;
+            }
+            std::cout << ",\"byStatus\":{";
+            bool first_status = true;
+            for (const auto& [status, count] : summary.by_status) {
+                std::cout << (first_status ? "" : ",") << "\"" << status << "\":" << count;
+                first_status = false;
+            }
+            std::cout << "}}";
+            first_op = false;
+        }
+        std::cout << "}}\n";
+        return;
+    }
+
+    std::cout << "scanned " << aggregate.scanned << " records, matched " << aggregate.matched << "\n";
+    if (aggregate.matched > 0) {
+        std::cout << "span " << format_time(aggregate.first_us) << " .. " << format_time(aggregate.last_us) << "\n";
+    }
+    for (const auto& [name, summary] : aggregate.by_op) {
+        std::cout << name << ": " << summary.count;
+        for (const auto& [status, count] : summary.by_status) {
+            std::cout << " " << status << "=" << count;
+        }
+        if (summary.timed > 0) {
+            std::cout << " | avg_total=" << summary.total_us_sum / summary.timed << "us"
+                      << " avg_wait=" << summary.wait_us_sum / summary.timed << "us"
+                      << " max_total=" << summary.total_us_max << "us";
+        }
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string dir = "./logs/binlog";
+    BinaryLogFilter filter;
+    size_t limit = 0;       // 0 = no limit
+    bool aggregate = false;
+    bool json = false;
+    bool segments = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (flag_value(argv[i], "--dir", value)) {
+            dir = value;
+        } else if (flag_value(argv[i], "--from", value)) {
+            filter.from_us = std::atoll(value.c_str()) * 1000;
+        } else if (flag_value(argv[i], "--to", value)) {
+            filter.to_us = std::atoll(value.c_str()) * 1000;
+        } else if (flag_value(argv[i], "--op", value)) {
+            if (!parse_log_op_mask(value, filter.op_mask)) {
+                std::cerr << "logq: unknown op in '" << value << "'\n";
+                return 2;
+            }
+        } else if (flag_value(argv[i], "--status", value)) {
+            if (!parse_log_status_mask(value, filter.status_mask)) {
+                std::cerr << "logq: unknown status in '" << value << "'\n";
+                return 2;
+            }
+        } else if (flag_value(argv[i], "--thread", value)) {
+            filter.thread_id = std::atoll(value.c_str());
+        } else if (flag_value(argv[i], "--grep", value)) {
+            filter.contains = value;
+        } else if (flag_value(argv[i], "--limit", value)) {
+            limit = static_cast<size_t>(std::atoll(value.c_str()));
+        } else if (std::strcmp(argv[i], "--aggregate") == 0) {
+            aggregate = true;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--segments") == 0) {
+            segments = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    auto started = std::chrono::steady_clock::now();
+
+    if (segments) {
+        for (const auto& segment : list_binary_log_segments(dir)) {
+            std::cout << segment.id << " " << format_time(segment.created_us) << " " << segment.bytes
+                      << (segment.compressed ? " gz " : " raw ") << segment.path << "\n";
+        }
+        return 0;
+    }
+
+    uint64_t scanned = 0;
+    if (aggregate) {
+        BinaryLogAggregate result = aggregate_binary_log(dir, filter);
+        scanned = result.scanned;
+        print_aggregate(result, json);
+    } else {
+        size_t printed = 0;
+        scanned = scan_binary_log(dir, filter, [&](const DecodedLogRecord& decoded) {
+            print_record(decoded, json);
+            return limit == 0 || ++printed < limit;
+        });
+    }
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::cerr << "logq: scanned " << scanned << " records in " << elapsed_ms << " ms\n";
+    return 0;
+}
@@ -0,0 +1,344 @@
+// Compares two cloud_bench result files (Google Benchmark JSON) and flags
+// statistically significant performance regressions.
+//
+//   perf_compare --baseline=FILE --current=FILE [--alpha=0.01] [--threshold=10]
+//                [--filter=TEXT] [--all] [--json]
+//
+// Both runs should use --benchmark_repetitions=N (N >= 3); every repetition
+// is one sample. --baseline and --current may be repeated to pool the samples
+// of several runs, e.g. rounds that alternate between the two builds. For each benchmark present in both files the compared
+// metrics are real_time, items/bytes per second, allocs_per_iter and the user
+// counters (the stress test's ops_per_sec and per-operation p50/p99).
+//
+// A metric regresses when Welch's t-test rejects equal means at --alpha AND
+// the mean moved the wrong way by more than --threshold percent. Counters
+// named *per_second / *per_sec are better when higher, everything else when
+// lower. Deterministic metrics (zero variance on both sides, e.g. allocation
+// counts) regress on any change beyond the threshold.
+//
+// Exit status: 0 when nothing regressed, 1 on a regression, 2 on bad input.
+
+#include <json/json.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// benchmark -> metric -> samples
+using ResultSet = std::map<std::string, std::map<std::string, std::vector<double>>>;
+
+struct Comparison {
+    std::string benchmark;
+    std::string metric;
+    size_t baseline_n = 0;
+    size_t current_n = 0;
+    double baseline_mean = 0.0;
+    double current_mean = 0.0;
+    double change_pct = 0.0;      // signed, current vs baseline
+    double p_value = 1.0;         // NaN when a side has a single sample
+    std::string verdict;          // REGRESSION, improved, ~, n/a
+};
+
+static void usage() {
+    std::cerr << "usage: perf_compare --baseline=FILE --current=FILE [--alpha=A] [--threshold=PCT]\n"
+                 "                    [--filter=TEXT] [--all] [--json]\n";
+}
+
+static bool flag_value(const char* arg, const char* name, std::string& value) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=') return false;
+    value = arg + len + 1;
+    return true;
+}
+
+// ===== INPUT =====
+
+static double to_ns(double value, const std::string& unit) {
+    if (unit == "us") return value * 1e3;
+    if (unit == "ms") return value * 1e6;
+    if (unit == "s") return value * 1e9;
+    return value;
+}
+
+// Per-repetition entries only; the mean/median/stddev aggregates are ignored.
+// The memory manager's byte fields are skipped too: with repetitions, Google
+// Benchmark 1.7 reports them from uninitialized storage on most entries
+static bool load_results(const std::string& path, ResultSet& results, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    // Google Benchmark writes NaN for the cv aggregate of a constant counter
+    builder["allowSpecialFloats"] = true;
+    std::string parse_error;
+    if (!Json::parseFromStream(builder, in, &root, &parse_error)) {
+        error = path + ": not valid benchmark JSON: " + parse_error;
+        return false;
+    }
+    if (!root.isMember("benchmarks") || !root["benchmarks"].isArray()) {
+        error = path + ": not a Google Benchmark JSON file";
+        return false;
+    }
+
+    static const char* skipped[] = {
+        "family_index", "per_family_instance_index", "repetitions", "repetition_index",
+        "threads", "iterations", "real_time", "cpu_time", "max_bytes_used", "total_allocated_bytes",
+        "net_heap_growth", "error_occurred"
+    };
+    for (const auto& entry : root["benchmarks"]) {
+        if (entry.get("run_type", "iteration").asString() != "iteration") continue;
+        if (entry.get("error_occurred", false).asBool()) continue;
+        std::string name = entry.get("run_name", entry["name"]).asString();
+        auto& metrics = results[name];
+        metrics["real_time_ns"].push_back(to_ns(entry["real_time"].asDouble(), entry.get("time_unit", "ns").asString()));
+        for (const auto& key : entry.getMemberNames()) {
+            if (!entry[key].isNumeric()) continue;
+            if (std::find_if(std::begin(skipped), std::end(skipped),
+                             [&key](const char* s) { return key == s; }) != std::end(skipped)) {
+                continue;
+            }
+            metrics[key].push_back(entry[key].asDouble());
+        }
+    }
+    return true;
+}
+
+// ===== STATISTICS =====
+
+// Continued fraction for the regularized incomplete beta function (modified Lentz)
+static double beta_continued_fraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    if (std::fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m <= 300; m++) {
+        double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) < 1e-12) break;
+    }
+    return h;
+}
+
+static double incomplete_beta(double a, double b, double x) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                            a * std::log(x) + b * std::log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * beta_continued_fraction(a, b, x) / a;
+    }
+    return 1.0 - front * beta_continued_fraction(b, a, 1.0 - x) / b;
+}
+
+static void mean_variance(const std::vector<double>& samples, double& mean, double& variance) {
+    mean = 0.0;
+    for (double s : samples) mean += s;
+    mean /= samples.size();
+    variance = 0.0;
+    for (double s : samples) variance += (s - mean) * (s - mean);
+    variance = samples.size() > 1 ? variance / (samples.size() - 1) : 0.0;
+}
+
+// Two-sided p-value of Welch's t-test for equal means
+static double welch_p_value(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() < 2 || b.size() < 2) return std::nan("");
+    double mean_a, var_a, mean_b, var_b;
+    mean_variance(a, mean_a, var_a);
+    mean_variance(b, mean_b, var_b);
+    double se_a = var_a / a.size();
+    double se_b = var_b / b.size();
+    double se = se_a + se_b;
+    if (se == 0.0) return mean_a == mean_b ? 1.0 : 0.0;
+
+    double t = (mean_b - mean_a) / std::sqrt(se);
+    double df = se * se / (se_a * se_a / (a.size() - 1) + se_b * se_b / (b.size() - 1));
+    return incomplete_beta(df / 2.0, 0.5, df / (df + t * t));
+}
+
+static bool higher_is_better(const std::string& metric) {
+    return metric.find("per_second") != std::string::npos || metric.find("per_sec") != std::string::npos;
+}
+
+// ===== OUTPUT =====
+
+static std::string format_value(double value) {
+    std::ostringstream out;
+    out << std::setprecision(4) << value;
+    return out.str();
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> baseline_paths;
+    std::vector<std::string> current_paths;
+    std::string filter;
+    double alpha = 0.01;
+    double threshold_pct = 10.0;
+    bool show_all = false;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (flag_value(argv[i], "--baseline", value)) {
+            baseline_paths.push_back(value);
+        } else if (flag_value(argv[i], "--current", value)) {
+            current_paths.push_back(value);
+        } else if (flag_value(argv[i], "--alpha", value)) {
+            alpha = std::atof(value.c_str());
+        } else if (flag_value(argv[i], "--threshold", value)) {
+            threshold_pct = std::atof(value.c_str());
+        } else if (flag_value(argv[i], "--filter", value)) {
+            filter = value;
+        } else if (std::strcmp(argv[i], "--all") == 0) {
+            show_all = true;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (baseline_paths.empty() || current_paths.empty()) {
+        usage();
+        return 2;
+    }
+
+    ResultSet baseline, current;
+    std::string error;
+    for (const auto& path : baseline_paths) {
+        if (!load_results(path, baseline, error)) {
+            std::cerr << "perf_compare: " << error << "\n";
+            return 2;
+        }
+    }
+    for (const auto& path : current_paths) {
+        if (!load_results(path, current, error)) {
+            std::cerr << "perf_compare: " << error << "\n";
+            return 2;
+        }
+    }
+
+    std::vector<Comparison> comparisons;
+    size_t missing = 0;
+    for (const auto& [name, base_metrics] : baseline) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) continue;
+        auto it = current.find(name);
+        if (it == current.end()) {
+            missing++;
+            continue;
+        }
+        for (const auto& [metric, base_samples] : base_metrics) {
+            auto cur = it->second.find(metric);
+            if (cur == it->second.end()) continue;
+
+            Comparison c;
+            c.benchmark = name;
+            c.metric = metric;
+            c.baseline_n = base_samples.size();
+            c.current_n = cur->second.size();
+            double variance;
+            mean_variance(base_samples, c.baseline_mean, variance);
+            mean_variance(cur->second, c.current_mean, variance);
+            if (c.baseline_mean != 0.0) {
+                c.change_pct = (c.current_mean - c.baseline_mean) / std::fabs(c.baseline_mean) * 100.0;
+            } else {
+                c.change_pct = c.current_mean == 0.0 ? 0.0 : 100.0;
+            }
+            c.p_value = welch_p_value(base_samples, cur->second);
+
+            double worse_pct = higher_is_better(metric) ? -c.change_pct : c.change_pct;
+            if (std::isnan(c.p_value)) {
+                c.verdict = "n/a";
+            } else if (c.p_value < alpha && worse_pct > threshold_pct) {
+                c.verdict = "REGRESSION";
+            } else if (c.p_value < alpha && worse_pct < -threshold_pct) {
+                c.verdict = "improved";
+            } else {
+                c.verdict = "~";
+            }
+            comparisons.push_back(c);
+        }
+    }
+
+    size_t regressions = std::count_if(comparisons.begin(), comparisons.end(),
+                                       [](const Comparison& c) { return c.verdict == "REGRESSION"; });
+    size_t improvements = std::count_if(comparisons.begin(), comparisons.end(),
+                                        [](const Comparison& c) { return c.verdict == "improved"; });
+    size_t unsampled = std::count_if(comparisons.begin(), comparisons.end(),
+                                     [](const Comparison& c) { return c.verdict == "n/a"; });
+
+    if (json) {
+        Json::Value root;
+        root["alpha"] = alpha;
+        root["thresholdPct"] = threshold_pct;
+        root["regressions"] = static_cast<Json::UInt64>(regressions);
+        root["improvements"] = static_cast<Json::UInt64>(improvements);
+        root["missingBenchmarks"] = static_cast<Json::UInt64>(missing);
+        Json::Value rows(Json::arrayValue);
+        for (const auto& c : comparisons) {
+            if (!show_all && c.verdict != "REGRESSION" && c.verdict != "improved") continue;
+            Json::Value row;
+            row["benchmark"] = c.benchmark;
+            row["metric"] = c.metric;
+            row["baselineMean"] = c.baseline_mean;
+            row["currentMean"] = c.current_mean;
+            row["baselineSamples"] = static_cast<Json::UInt64>(c.baseline_n);
+            row["currentSamples"] = static_cast<Json::UInt64>(c.current_n);
+            row["changePct"] = c.change_pct;
+            row["pValue"] = std::isnan(c.p_value) ? Json::Value() : Json::Value(c.p_value);
+            row["verdict"] = c.verdict;
+            rows.append(row);
+        }
+        root["comparisons"] = rows;
+        Json::StreamWriterBuilder writer;
+        std::cout << Json::writeString(writer, root) << "\n";
+        return regressions ? 1 : 0;
+    }
+
+    size_t name_width = 20;
+    for (const auto& c : comparisons) name_width = std::max(name_width, c.benchmark.size() + 2);
+    std::cout << std::left << std::setw(name_width) << "benchmark" << std::setw(16) << "metric" << std::right
+              << std::setw(12) << "baseline" << std::setw(12) << "current" << std::setw(10) << "change"
+              << std::setw(10) << "p" << "  verdict\n";
+    for (const auto& c : comparisons) {
+        if (!show_all && c.verdict != "REGRESSION" && c.verdict != "improved") continue;
+        std::ostringstream change;
+        change << std::showpos << std::fixed << std::setprecision(1) << c.change_pct << "%";
+        std::cout << std::left << std::setw(name_width) << c.benchmark << std::setw(16) << c.metric << std::right
+                  << std::setw(12) << format_value(c.baseline_mean) << std::setw(12) << format_value(c.current_mean)
+                  << std::setw(10) << change.str()
+                  << std::setw(10) << (std::isnan(c.p_value) ? "-" : format_value(c.p_value))
+                  << "  " << c.verdict << "\n";
+    }
+    std::cout << "\n" << comparisons.size() << " metrics compared: " << regressions << " regressed, "
+              << improvements << " improved (alpha " << alpha << ", threshold " << threshold_pct << "%)";
+    if (unsampled) std::cout << ", " << unsampled << " without repetitions";
+    if (missing) std::cout << ", " << missing << " baseline benchmarks missing from current";
+    std::cout << "\n";
+    return regressions ? 1 : 0;
+}
@@ -17,6 +17,7 @@ extern DeadlockDetector deadlock_detector;
 void run_process_scheduler_demo();
 void run_file_system_demo();
 void run_ipc_demo();
+void run_automatic_ipc_demo();
 void run_deadlock_detection_demo();
 void run_comprehensive_os_demo();
 
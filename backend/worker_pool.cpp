@@ -0,0 +1,72 @@
+#include "worker_pool.h"
+
+WorkerPool::WorkerPool(size_t thread_count, size_t max_q)
+    : max_queue(max_q), busy_workers(0), stopping(false) {
+    if (thread_count == 0) thread_count = 1;
+    workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+bool WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (stopping || tasks.size() >= max_queue) {
+            return false;
+        }
+        tasks.push_back(std::move(task));
+    }
+    cv.notify_one();
+    return true;
+}
+
+void WorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (stopping) return;
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+size_t WorkerPool::pending() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return tasks.size();
+}
+
+size_t WorkerPool::active() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return busy_workers;
+}
+
+void WorkerPool::worker_loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            // Drain what was already accepted before exiting
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            busy_workers++;
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // A failing task must not take the worker down with it
+        }
+
+        std::lock_guard<std::mutex> lock(mtx);
+        busy_workers--;
+    }
+}
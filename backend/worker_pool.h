@@ -0,0 +1,43 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of compute threads fed from a bounded FIFO queue.
+// submit() never blocks: when the queue is full the task is refused so the
+// caller can shed load instead of piling up work.
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    size_t max_queue;
+    size_t busy_workers;
+    bool stopping;
+
+    void worker_loop();
+
+public:
+    WorkerPool(size_t thread_count, size_t max_queue = 1024);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    bool submit(std::function<void()> task);
+    void shutdown();
+
+    size_t pending() const;
+    size_t active() const;
+    size_t thread_count() const { return workers.size(); }
+    size_t capacity() const { return max_queue; }
+};
+
+#endif
@@ -0,0 +1,377 @@
+#include "workload.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <system_error>
+#include <thread>
+
+const char* workload_op_name(WorkloadOp op) {
+    switch (op) {
+        case WorkloadOp::READ: return "READ";
+        case WorkloadOp::WRITE: return "WRITE";
+        case WorkloadOp::DELETE: return "DELETE";
+    }
+    return "READ";
+}
+
+const char* arrival_process_name(ArrivalProcess arrival) {
+    switch (arrival) {
+        case ArrivalProcess::BURST: return "burst";
+        case ArrivalProcess::CLOSED_LOOP: return "closed";
+        case ArrivalProcess::POISSON: return "poisson";
+        case ArrivalProcess::FIXED_RATE: return "fixed";
+    }
+    return "burst";
+}
+
+const char* size_distribution_name(SizeDistribution distribution) {
+    switch (distribution) {
+        case SizeDistribution::SOURCE_FILE: return "file";
+        case SizeDistribution::FIXED: return "fixed";
+        case SizeDistribution::UNIFORM: return "uniform";
+        case SizeDistribution::LOGNORMAL: return "lognormal";
+    }
+    return "file";
+}
+
+bool parse_arrival_process(const std::string& name, ArrivalProcess& arrival) {
+    for (ArrivalProcess a : {ArrivalProcess::BURST, ArrivalProcess::CLOSED_LOOP,
+                             ArrivalProcess::POISSON, ArrivalProcess::FIXED_RATE}) {
+        if (name == arrival_process_name(a)) {
+            arrival = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_size_distribution(const std::string& name, SizeDistribution& distribution) {
+    for (SizeDistribution d : {SizeDistribution::SOURCE_FILE, SizeDistribution::FIXED,
+                               SizeDistribution::UNIFORM, SizeDistribution::LOGNORMAL}) {
+        if (name == size_distribution_name(d)) {
+            distribution = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string validate_workload(const WorkloadConfig& config) {
+    if (config.operations < 1) return "operations must be at least 1";
+    if (config.warmup_operations < 0) return "warmup must not be negative";
+    if (config.read_weight < 0 || config.write_weight < 0 || config.delete_weight < 0 ||
+        config.read_weight + config.write_weight + config.delete_weight <= 0) {
+        return "mix weights must be non-negative and not all zero";
+    }
+    if (config.arrival == ArrivalProcess::CLOSED_LOOP && config.concurrency < 1) {
+        return "concurrency must be at least 1";
+    }
+    if ((config.arrival == ArrivalProcess::POISSON || config.arrival == ArrivalProcess::FIXED_RATE) &&
+        !(config.rate_per_sec > 0)) {
+        return "rate must be positive for open-loop arrivals";
+    }
+    if (config.zipf_s < 0) return "zipf must not be negative";
+    if (config.size_min > config.size_max) return "size min must not exceed max";
+    if (config.size_sigma < 0) return "size sigma must not be negative";
+    return "";
+}
+
+// ===== PLANNING =====
+
+// Exact op counts by largest remainder, then a seeded shuffle
+static std::vector<WorkloadOp> plan_ops(const WorkloadConfig& config, int count, std::mt19937_64& rng) {
+    const WorkloadOp ops[3] = {WorkloadOp::READ, WorkloadOp::WRITE, WorkloadOp::DELETE};
+    const double weights[3] = {config.read_weight, config.write_weight, config.delete_weight};
+    double total_weight = weights[0] + weights[1] + weights[2];
+
+    int counts[3];
+    double remainders[3];
+    int assigned = 0;
+    for (int i = 0; i < 3; i++) {
+        double exact = count * weights[i] / total_weight;
+        counts[i] = static_cast<int>(exact);
+        remainders[i] = exact - counts[i];
+        assigned += counts[i];
+    }
+    while (assigned < count) {
+        int best = static_cast<int>(std::max_element(remainders, remainders + 3) - remainders);
+        counts[best]++;
+        remainders[best] = -1.0;
+        assigned++;
+    }
+
+    std::vector<WorkloadOp> result;
+    result.reserve(count);
+    for (int i = 0; i < 3; i++) {
+        result.insert(result.end(), counts[i], ops[i]);
+    }
+    // Fisher-Yates with our own index draw so the order depends only on the seed
+    for (size_t i = result.size(); i > 1; i--) {
+        std::swap(result[i - 1], result[rng() % i]);
+    }
+    return result;
+}
+
+// Cumulative Zipf weights 1/(k+1)^s over key_count keys
+static std::vector<double> zipf_cdf(size_t key_count, double s) {
+    std::vector<double> cdf(key_count);
+    double sum = 0.0;
+    for (size_t k = 0; k < key_count; k++) {
+        sum += 1.0 / std::pow(static_cast<double>(k + 1), s);
+        cdf[k] = sum;
+    }
+    for (double& c : cdf) c /= sum;
+    return cdf;
+}
+
+static double uniform01(std::mt19937_64& rng) {
+    return (rng() >> 11) * (1.0 / 9007199254740992.0);   // 53 random bits
+}
+
+static size_t plan_size(const WorkloadConfig& config, std::mt19937_64& rng) {
+    switch (config.size_distribution) {
+        case SizeDistribution::SOURCE_FILE:
+            return 0;
+        case SizeDistribution::FIXED:
+            return config.size_bytes;
+        case SizeDistribution::UNIFORM:
+            return config.size_min + static_cast<size_t>(uniform01(rng) * (config.size_max - config.size_min + 1));
+        case SizeDistribution::LOGNORMAL: {
+            // Box-Muller from two uniforms
+            double u1 = std::max(uniform01(rng), 1e-12);
+            double u2 = uniform01(rng);
+            double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+            double size = config.size_bytes * std::exp(config.size_sigma * normal);
+            return std::clamp(static_cast<size_t>(size), config.size_min, config.size_max);
+        }
+    }
+    return 0;
+}
+
+std::vector<WorkloadOpPlan> plan_workload(const WorkloadConfig& config, size_t key_count) {
+    std::mt19937_64 rng(config.seed);
+    std::vector<WorkloadOpPlan> plan;
+    std::vector<double> cdf = zipf_cdf(std::max<size_t>(1, key_count), config.zipf_s);
+
+    // Warmup and measured phases are planned separately so the measured
+    // plan is the same whatever the warmup length
+    for (int count : {config.warmup_operations, config.operations}) {
+        std::vector<WorkloadOp> ops = plan_ops(config, count, rng);
+        double arrival_ms = 0.0;
+        for (WorkloadOp op : ops) {
+            WorkloadOpPlan step;
+            step.op = op;
+            step.key = -1;
+            step.size = 0;
+            if (op == WorkloadOp::WRITE) {
+                if (config.size_distribution == SizeDistribution::SOURCE_FILE) {
+                    double u = uniform01(rng);
+                    step.key = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+                    step.key = std::min(step.key, static_cast<int>(cdf.size()) - 1);
+                } else {
+                    step.size = plan_size(config, rng);
+                }
+            }
+            if (config.arrival == ArrivalProcess::POISSON) {
+                step.arrival_ms = arrival_ms;
+                arrival_ms += -std::log(1.0 - uniform01(rng)) * 1000.0 / config.rate_per_sec;
+            } else if (config.arrival == ArrivalProcess::FIXED_RATE) {
+                step.arrival_ms = arrival_ms;
+                arrival_ms += 1000.0 / config.rate_per_sec;
+            } else {
+                step.arrival_ms = 0.0;
+            }
+            plan.push_back(step);
+        }
+    }
+    return plan;
+}
+
+uint64_t workload_plan_digest(const std::vector<WorkloadOpPlan>& plan) {
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const auto& step : plan) {
+        mix(static_cast<uint64_t>(step.op));
+        mix(static_cast<uint64_t>(static_cast<int64_t>(step.key)));
+        mix(step.size);
+        mix(static_cast<uint64_t>(std::llround(step.arrival_ms * 1000.0)));
+    }
+    return hash;
+}
+
+// ===== EXECUTION =====
+
+// Deterministic filler so synthetic uploads are reproducible too
+static std::string synthetic_payload(size_t size, size_t index) {
+    std::string line = "workload object " + std::to_string(index) + " ";
+    std::string payload;
+    payload.reserve(size);
+    while (payload.size() < size) {
+        payload.append(line, 0, std::min(line.size(), size - payload.size()));
+    }
+    return payload;
+}
+
+namespace {
+
+struct PhaseState {
+    const WorkloadConfig& config;
+    const std::vector<WorkloadOpPlan>& plan;
+    const std::vector<std::string>& files;
+    const std::atomic<bool>* cancel_requested;
+    std::vector<OperationTiming> timings;     // one slot per plan entry
+    std::vector<char> executed;
+    std::vector<double> start_lag_ms;
+    std::atomic<int> finished{0};
+    int total = 0;
+    std::mutex progress_mtx;
+    const std::function<void(int, int)>* on_progress = nullptr;
+
+    PhaseState(const WorkloadConfig& c, const std::vector<WorkloadOpPlan>& p,
+               const std::vector<std::string>& f, const std::atomic<bool>* cancel)
+        : config(c), plan(p), files(f), cancel_requested(cancel),
+          timings(p.size()), executed(p.size(), 0), start_lag_ms(p.size(), 0.0) {}
+
+    bool cancelled() const { return cancel_requested && cancel_requested->load(); }
+
+    void execute(size_t index, bool report) {
+        const WorkloadOpPlan& step = plan[index];
+        int id = static_cast<int>(index) + 1;
+        switch (step.op) {
+            case WorkloadOp::READ:
+                timings[index] = run_read(id);
+                break;
+            case WorkloadOp::WRITE:
+                if (step.key >= 0) {
+                    const std::string& file = files.empty() ? std::string("./test_files/default.txt")
+                                                            : files[step.key % files.size()];
+                    timings[index] = run_write(id, file);
+                } else {
+                    std::string payload = synthetic_payload(step.size, index);
+                    timings[index] = run_write(id, "synthetic:" + std::to_string(step.size), &payload);
+                }
+                break;
+            case WorkloadOp::DELETE:
+                timings[index] = run_delete(id);
+                break;
+        }
+        executed[index] = 1;
+        int done = finished.fetch_add(1) + 1;
+        if (report && on_progress && *on_progress) {
+            std::lock_guard<std::mutex> lock(progress_mtx);
+            (*on_progress)(done, total);
+        }
+    }
+};
+
+// Runs plan[begin, end) with the configured arrival process; returns the
+// wall time of the phase in milliseconds
+double run_phase(PhaseState& state, size_t begin, size_t end, bool report) {
+    const WorkloadConfig& config = state.config;
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+
+    if (config.arrival == ArrivalProcess::CLOSED_LOOP) {
+        std::atomic<size_t> next{begin};
+        int workers = std::min<int>(config.concurrency, static_cast<int>(end - begin));
+        for (int w = 0; w < workers; w++) {
+            threads.emplace_back([&state, &next, end, report]() {
+                for (size_t i = next++; i < end && !state.cancelled(); i = next++) {
+                    state.execute(i, report);
+                }
+            });
+        }
+    } else {
+        bool open_loop = config.arrival != ArrivalProcess::BURST;
+        double phase_offset_ms = begin < end ? state.plan[begin].arrival_ms : 0.0;
+        for (size_t i = begin; i < end; i++) {
+            if (open_loop) {
+                auto scheduled = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::milli>(state.plan[i].arrival_ms - phase_offset_ms));
+                std::this_thread::sleep_until(scheduled);
+                state.start_lag_ms[i] = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - scheduled).count();
+            }
+            if (state.cancelled()) break;
+            try {
+                threads.emplace_back([&state, i, report]() { state.execute(i, report); });
+            } catch (const std::system_error& e) {
+                log_event(0, "STRESS_TEST", "Thread creation failed: " + std::string(e.what()));
+            }
+        }
+    }
+
+    for (auto& t : threads) t.join();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+}
+
+} // namespace
+
+StressTestResult run_workload(const WorkloadConfig& config,
+                              const std::function<void(int, int)>& on_progress,
+                              const std::atomic<bool>* cancel_requested) {
+    auto files = get_test_files();
+    std::vector<WorkloadOpPlan> plan = plan_workload(config, files->size());
+    size_t warmup = static_cast<size_t>(config.warmup_operations);
+
+    StressTestResult result;
+    result.requested_threads = config.operations;
+    result.seed = config.seed;
+    result.arrival = arrival_process_name(config.arrival);
+    result.warmup_operations = config.warmup_operations;
+    result.plan_digest = workload_plan_digest(plan);
+
+    std::cout << "\n=== Starting Stress Test: " << config.operations << " operations (" << result.arrival
+              << ", seed " << config.seed << ") ===\n" << std::endl;
+    log_event(0, "STRESS_TEST", "Starting with " + std::to_string(config.operations) + " operations (" +
+              result.arrival + " arrivals, seed " + std::to_string(config.seed) + ")");
+
+    PhaseState state(config, plan, *files, cancel_requested);
+    if (warmup > 0) {
+        state.total = static_cast<int>(warmup);
+        run_phase(state, 0, warmup, false);
+    }
+    state.finished = 0;
+    state.total = config.operations;
+    state.on_progress = &on_progress;
+    result.duration_ms = run_phase(state, warmup, plan.size(), true);
+    result.cancelled = state.cancelled();
+
+    std::vector<OperationTiming> measured;
+    int lagged = 0;
+    for (size_t i = warmup; i < plan.size(); i++) {
+        if (!state.executed[i]) continue;
+        measured.push_back(state.timings[i]);
+        switch (plan[i].op) {
+            case WorkloadOp::READ: result.readers++; break;
+            case WorkloadOp::WRITE: result.writers++; break;
+            case WorkloadOp::DELETE: result.deleters++; break;
+        }
+        if (config.arrival == ArrivalProcess::POISSON || config.arrival == ArrivalProcess::FIXED_RATE) {
+            result.avg_start_lag_ms += state.start_lag_ms[i];
+            result.max_start_lag_ms = std::max(result.max_start_lag_ms, state.start_lag_ms[i]);
+            lagged++;
+        }
+    }
+    if (lagged > 0) result.avg_start_lag_ms /= lagged;
+    result.launched_threads = static_cast<int>(measured.size());
+    if (result.duration_ms > 0.0) {
+        result.throughput_ops_per_sec = measured.size() * 1000.0 / result.duration_ms;
+    }
+    for (const char* operation : {"READ", "WRITE", "DELETE"}) {
+        result.latency[operation] = summarize_latencies(measured.cbegin(), measured.cend(), operation);
+    }
+
+    std::cout << "\n=== Stress Test " << (result.cancelled ? "Cancelled" : "Completed") << " ===\n" << std::endl;
+    log_event(0, "STRESS_TEST", result.cancelled ? "Cancelled after " + std::to_string(result.launched_threads) + " operations"
+                                                 : "Completed successfully");
+    return result;
+}
@@ -0,0 +1,76 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "cloud.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Reproducible stress-test workloads. A run is fully described by its
+// WorkloadConfig: the seed drives operation order, key choice, object sizes
+// and arrival times, so two runs with the same config execute the same plan
+// (same plan_digest) and can be compared directly.
+
+enum class WorkloadOp : uint8_t { READ, WRITE, DELETE };
+
+enum class ArrivalProcess {
+    BURST,        // every operation starts at once (the original stress test)
+    CLOSED_LOOP,  // `concurrency` workers issue operations back to back
+    POISSON,      // open loop, exponential inter-arrival times at `rate_per_sec`
+    FIXED_RATE    // open loop, evenly spaced at `rate_per_sec`
+};
+
+enum class SizeDistribution {
+    SOURCE_FILE,  // writers upload a test file chosen by key popularity
+    FIXED,        // synthetic payloads of size_bytes
+    UNIFORM,      // synthetic payloads uniform in [size_min, size_max]
+    LOGNORMAL     // synthetic payloads with median size_bytes, clamped to [size_min, size_max]
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 42;
+    int operations = 10;            // measured operations
+    int warmup_operations = 0;      // executed first and excluded from results
+    double read_weight = 5.0;       // op mix; exact proportions, seeded order
+    double write_weight = 3.0;
+    double delete_weight = 2.0;
+    ArrivalProcess arrival = ArrivalProcess::BURST;
+    int concurrency = 10;           // closed-loop workers
+    double rate_per_sec = 20.0;     // open-loop arrival rate
+    double zipf_s = 0.0;            // test file popularity skew, 0 = uniform
+    SizeDistribution size_distribution = SizeDistribution::SOURCE_FILE;
+    size_t size_bytes = 1024;
+    size_t size_min = 64;
+    size_t size_max = 64 * 1024;
+    double size_sigma = 1.0;        // lognormal shape
+};
+
+struct WorkloadOpPlan {
+    WorkloadOp op;
+    int key;              // test file index for SOURCE_FILE writes, -1 otherwise
+    size_t size;          // synthetic payload bytes, 0 for reads/deletes/file writes
+    double arrival_ms;    // offset from phase start (open loop only)
+};
+
+const char* workload_op_name(WorkloadOp op);
+const char* arrival_process_name(ArrivalProcess arrival);
+const char* size_distribution_name(SizeDistribution distribution);
+bool parse_arrival_process(const std::string& name, ArrivalProcess& arrival);
+bool parse_size_distribution(const std::string& name, SizeDistribution& distribution);
+
+// Empty string when the config is usable, otherwise what is wrong with it
+std::string validate_workload(const WorkloadConfig& config);
+
+// Warmup operations first, then measured ones. key_count is the number of
+// test files writers choose from.
+std::vector<WorkloadOpPlan> plan_workload(const WorkloadConfig& config, size_t key_count);
+// FNV-1a over the plan; equal digests mean the same operations in the same order
+uint64_t workload_plan_digest(const std::vector<WorkloadOpPlan>& plan);
+
+StressTestResult run_workload(const WorkloadConfig& config,
+                              const std::function<void(int, int)>& on_progress,
+                              const std::atomic<bool>* cancel_requested);
+
+#endif
@@ -585,6 +585,34 @@ export default function OSSimulator() {
                   >
                     Priority
                   </Button>
+                  <Button 
+                    onClick={() => runProcessScheduler('SRTF', 2)} 
+                    disabled={loading}
+                    className="bg-gradient-to-r from-teal-500 to-teal-600 hover:from-teal-600 hover:to-teal-700"
+                  >
+                    SRTF
+                  </Button>
+                  <Button 
+                    onClick={() => runProcessScheduler('PRIORITY_P', 2)} 
+                    disabled={loading}
+                    className="bg-gradient-to-r from-pink-500 to-pink-600 hover:from-pink-600 hover:to-pink-700"
+                  >
+                    Preemptive Priority
+                  </Button>
+                  <Button 
+                    onClick={() => runProcessScheduler('MLFQ', 2)} 
+                    disabled={loading}
+                    className="bg-gradient-to-r from-indigo-500 to-indigo-600 hover:from-indigo-600 hover:to-indigo-700"
+                  >
+                    MLFQ
+                  </Button>
+                  <Button 
+                    onClick={() => runProcessScheduler('CFS', 2)} 
+                    disabled={loading}
+                    className="bg-gradient-to-r from-cyan-500 to-cyan-600 hover:from-cyan-600 hover:to-cyan-700"
+                  >
+                    CFS
+                  </Button>
                 </div>
               </div>
               